@@ -537,6 +537,48 @@ int bt_audio_codec_cfg_get_frame_blocks_per_sdu(const struct bt_audio_codec_cfg
 int bt_audio_codec_cfg_set_frame_blocks_per_sdu(struct bt_audio_codec_cfg *codec_cfg,
 						uint8_t frame_blocks);
 
+/**
+ * @brief Codec configuration values decoded by bt_audio_codec_cfg_get_params()
+ *
+ * Each value is stored as it would have been returned by the corresponding getter, i.e. either
+ * the value itself or a negative error code.
+ */
+struct bt_audio_codec_cfg_params {
+	/** @ref bt_audio_codec_cfg_freq value, see bt_audio_codec_cfg_get_freq() */
+	int freq;
+	/** @ref bt_audio_codec_cfg_frame_dur value, see bt_audio_codec_cfg_get_frame_dur() */
+	int frame_dur;
+	/** Channel allocation, only valid if @p chan_allocation_err is 0 */
+	enum bt_audio_location chan_allocation;
+	/** Result of the channel allocation lookup, see bt_audio_codec_cfg_get_chan_allocation() */
+	int chan_allocation_err;
+	/** Octets per codec frame, see bt_audio_codec_cfg_get_octets_per_frame() */
+	int octets_per_frame;
+	/** Frame blocks per SDU, see bt_audio_codec_cfg_get_frame_blocks_per_sdu() */
+	int frame_blocks_per_sdu;
+};
+
+/**
+ * @brief Extract all common parameters from BT codec config
+ *
+ * Decodes the sampling frequency, frame duration, channel allocation, octets per frame and
+ * frame blocks per SDU in a single pass over the codec configuration data. This yields the same
+ * results as calling each of the individual getters, but without scanning the data once per
+ * value, and is the preferred way to read the configuration when setting up a stream.
+ *
+ * @param[in]  codec_cfg The codec configuration to extract data from.
+ * @param[out] params    The decoded values.
+ * @param[in]  fallback_to_default If true the default values for the channel allocation and
+ *             frame blocks per SDU are provided if the types are not found when
+ *             @p codec_cfg.id is @ref BT_HCI_CODING_FORMAT_LC3.
+ *
+ * @retval 0 The values have been stored in @p params
+ * @retval -EINVAL Arguments are invalid
+ */
+int bt_audio_codec_cfg_get_params(const struct bt_audio_codec_cfg *codec_cfg,
+				  struct bt_audio_codec_cfg_params *params,
+				  bool fallback_to_default);
+
 /**
  * @brief Lookup a specific codec configuration value
  *
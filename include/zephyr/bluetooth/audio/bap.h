@@ -2489,6 +2489,65 @@ typedef bool (*bt_bap_broadcast_source_foreach_stream_func_t)(struct bt_bap_stre
 int bt_bap_broadcast_source_foreach_stream(struct bt_bap_broadcast_source *source,
 					   bt_bap_broadcast_source_foreach_stream_func_t func,
 					   void *user_data);
+
+/**
+ * @brief Send data to all streams of a broadcast source without timestamp
+ *
+ * Send one SDU on each stream of the broadcast source, all with the same sequence number. The
+ * broadcast source is verified once for all the streams, and the SDUs are passed to the ISO
+ * channels back to back. This is equivalent to calling bt_bap_stream_send() for each stream, with
+ * less overhead per stream.
+ *
+ * The buffers are sent in the order of the streams of bt_bap_broadcast_source_foreach_stream().
+ * The ownership of a buffer is only transferred if it was sent successfully, so the buffers of
+ * the streams with a negative result in @p results are still owned by the caller.
+ *
+ * @note Support for sending must be supported, determined by @kconfig{CONFIG_BT_AUDIO_TX}.
+ *
+ * @param[in]  source   Pointer to the broadcast source.
+ * @param[in]  bufs     Buffers containing the data to be sent, one for each stream.
+ * @param[in]  count    Number of entries in @p bufs and @p results. This shall be the number of
+ *                      streams in @p source.
+ * @param[in]  seq_num  Packet Sequence number, shared by all the streams. This value shall be
+ *                      incremented for each call to this function and at least once per SDU
+ *                      interval.
+ * @param[out] results  Result for each stream: the number of bytes sent or a negative error code.
+ *
+ * @retval 0        The data was sent on all streams.
+ * @retval -EINVAL  @p source, @p bufs or @p results were NULL, or @p count is not the number of
+ *                  streams in @p source.
+ * @retval -EBADMSG The broadcast source is not started. Nothing was sent.
+ * @retval -EIO     Sending failed on one or more streams, see @p results.
+ */
+int bt_bap_broadcast_source_send(struct bt_bap_broadcast_source *source, struct net_buf *bufs[],
+				 size_t count, uint16_t seq_num, int results[]);
+
+/**
+ * @brief Send data to all streams of a broadcast source with timestamp
+ *
+ * Same as bt_bap_broadcast_source_send(), with the same timestamp for the SDUs of all the streams.
+ *
+ * @note Support for sending must be supported, determined by @kconfig{CONFIG_BT_AUDIO_TX}.
+ *
+ * @param[in]  source   Pointer to the broadcast source.
+ * @param[in]  bufs     Buffers containing the data to be sent, one for each stream.
+ * @param[in]  count    Number of entries in @p bufs and @p results. This shall be the number of
+ *                      streams in @p source.
+ * @param[in]  seq_num  Packet Sequence number, shared by all the streams. This value shall be
+ *                      incremented for each call to this function and at least once per SDU
+ *                      interval.
+ * @param[in]  ts       Timestamp of the SDUs in microseconds (us).
+ * @param[out] results  Result for each stream: the number of bytes sent or a negative error code.
+ *
+ * @retval 0        The data was sent on all streams.
+ * @retval -EINVAL  @p source, @p bufs or @p results were NULL, or @p count is not the number of
+ *                  streams in @p source.
+ * @retval -EBADMSG The broadcast source is not started. Nothing was sent.
+ * @retval -EIO     Sending failed on one or more streams, see @p results.
+ */
+int bt_bap_broadcast_source_send_ts(struct bt_bap_broadcast_source *source,
+				    struct net_buf *bufs[], size_t count, uint16_t seq_num,
+				    uint32_t ts, int results[]);
 /** @} */ /* End of bt_bap_broadcast_source */
 
 /**
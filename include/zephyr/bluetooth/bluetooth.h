@@ -36,6 +36,7 @@
 #include <zephyr/bluetooth/crypto.h>
 #include <zephyr/bluetooth/hci_types.h>
 #include <zephyr/bluetooth/classic/classic.h>
+#include <zephyr/bluetooth/uuid.h>
 #include <zephyr/net_buf.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/sys/util.h>
@@ -2473,6 +2474,14 @@ struct bt_le_scan_cb {
 	/** @brief The scanner has stopped scanning after scan timeout. */
 	void (*timeout)(void);
 
+#if defined(CONFIG_BT_SCAN_FILTER) || defined(__DOXYGEN__)
+	/**
+	 * @brief Only call @ref bt_le_scan_cb.recv for reports matching the
+	 *        host scan filters, see @ref bt_le_scan_filter_add.
+	 */
+	bool filtered;
+#endif /* CONFIG_BT_SCAN_FILTER */
+
 	sys_snode_t node;
 };
 
@@ -2642,6 +2651,106 @@ int bt_le_scan_cb_register(struct bt_le_scan_cb *cb);
  */
 void bt_le_scan_cb_unregister(struct bt_le_scan_cb *cb);
 
+/** Extended advertising report reassembly statistics. */
+struct bt_le_scan_reassembly_stats {
+	/** Number of fragmented advertising reports reassembled and reported. */
+	uint32_t completed;
+	/**
+	 * Number of fragmented advertising reports discarded after the
+	 * reassembly started, e.g. because the data did not fit in the
+	 * reassembly buffer, the controller truncated the data or the
+	 * reassembly was evicted by another advertiser.
+	 */
+	uint32_t discarded;
+};
+
+/**
+ * @brief Get the extended advertising report reassembly statistics.
+ *
+ * The statistics are cleared when Bluetooth is enabled.
+ *
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL @p stats is NULL.
+ * @retval -ENOTSUP @kconfig{CONFIG_BT_EXT_ADV} is not enabled.
+ */
+int bt_le_scan_reassembly_stats_get(struct bt_le_scan_reassembly_stats *stats);
+
+/** Host scan filter types. */
+enum bt_le_scan_filter_type {
+	/** Match the identity address of the advertiser. */
+	BT_LE_SCAN_FILTER_ADDR,
+	/** Match advertising data containing an AD structure of the given type. */
+	BT_LE_SCAN_FILTER_AD_TYPE,
+	/** Match a shortened or complete local name starting with the given prefix. */
+	BT_LE_SCAN_FILTER_NAME_PREFIX,
+	/** Match a service UUID in the incomplete or complete lists of service UUIDs. */
+	BT_LE_SCAN_FILTER_UUID,
+	/** Match manufacturer specific data with the given company identifier. */
+	BT_LE_SCAN_FILTER_MANUFACTURER_ID,
+};
+
+/** Host scan filter. */
+struct bt_le_scan_filter {
+	/** Filter type. */
+	enum bt_le_scan_filter_type type;
+	/** Value to match, selected by @ref bt_le_scan_filter.type. */
+	union {
+		/** Address for @ref BT_LE_SCAN_FILTER_ADDR. */
+		bt_addr_le_t addr;
+		/** AD type for @ref BT_LE_SCAN_FILTER_AD_TYPE. */
+		uint8_t ad_type;
+		/**
+		 * NULL terminated name prefix for @ref BT_LE_SCAN_FILTER_NAME_PREFIX.
+		 * Must point to memory that remains valid.
+		 */
+		const char *name_prefix;
+		/**
+		 * Service UUID for @ref BT_LE_SCAN_FILTER_UUID.
+		 * Must point to memory that remains valid.
+		 */
+		const struct bt_uuid *uuid;
+		/** Company identifier for @ref BT_LE_SCAN_FILTER_MANUFACTURER_ID. */
+		uint16_t company_id;
+	};
+};
+
+/**
+ * @brief Add a host scan filter.
+ *
+ * Once at least one filter has been added, advertising reports that do not
+ * match any of the filters are not passed to the scan callbacks registered
+ * with @ref bt_le_scan_cb_register that have @ref bt_le_scan_cb.filtered
+ * set. The filters are evaluated at most once per report, stopping at the
+ * first match. The callback given to @ref bt_le_scan_start, the other scan
+ * callbacks, connection establishment and periodic advertising
+ * synchronization still see every report.
+ *
+ * Filters can only be changed while the scanner has no user, i.e. while
+ * neither scanning, connecting nor synchronizing.
+ *
+ * Requires @kconfig{CONFIG_BT_SCAN_FILTER}.
+ *
+ * @param filter Filter to add. The filter is copied.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Invalid filter.
+ * @retval -ENOMEM No room for more filters, see @kconfig{CONFIG_BT_SCAN_FILTER_MAX}.
+ * @retval -EBUSY The scanner is in use.
+ */
+int bt_le_scan_filter_add(const struct bt_le_scan_filter *filter);
+
+/**
+ * @brief Remove all host scan filters.
+ *
+ * Requires @kconfig{CONFIG_BT_SCAN_FILTER}.
+ *
+ * @retval 0 Success.
+ * @retval -EBUSY The scanner is in use.
+ */
+int bt_le_scan_filter_clear(void);
+
 /**
  * @brief Add device (LE) to filter accept list.
  *
@@ -956,6 +956,49 @@ int bt_a2dp_stream_send(struct bt_a2dp_stream *stream, struct net_buf *buf, uint
  */
 struct net_buf *bt_a2dp_stream_create_pdu(struct net_buf_pool *pool, k_timeout_t timeout);
 
+#if defined(CONFIG_LIBSBC)
+struct sbc_encoder;
+
+/** @brief get the number of SBC frames that fit in one media packet
+ *
+ *  The number is limited by the stream L2CAP MTU and by the 4 bits
+ *  Number of Frames field of the SBC media payload header.
+ *
+ *  @param stream The stream object.
+ *  @param encoder The SBC encoder configured for the stream.
+ *
+ *  @return Number of frames or (negative) error code otherwise.
+ */
+int bt_a2dp_stream_sbc_frames_max(struct bt_a2dp_stream *stream, struct sbc_encoder *encoder);
+
+/** @brief encode PCM samples into a SBC media packet
+ *
+ *  Only A2DP source side can call this function.
+ *
+ *  The SBC frames are encoded directly into the tailroom of @p buf, which
+ *  shall be allocated with bt_a2dp_stream_create_pdu(). The SBC media
+ *  payload header is added on the first call and its Number of Frames field
+ *  is updated on each call, so several calls can fill the same packet.
+ *  Encoding stops when less than one frame of PCM samples is left, when the
+ *  packet holds @p frames_max frames, or when no more frame fits in the
+ *  packet, see bt_a2dp_stream_sbc_frames_max().
+ *
+ *  @param stream The stream object.
+ *  @param encoder The SBC encoder configured for the stream.
+ *  @param buf The media packet.
+ *  @param frames_max Maximum number of frames in the packet, up to 15, or 0
+ *                    for as many as fit.
+ *  @param pcm The PCM samples.
+ *  @param pcm_len Length of the PCM samples in bytes.
+ *
+ *  @return Number of PCM bytes encoded, zero if the packet is full, or
+ *          (negative) error code otherwise.
+ */
+int bt_a2dp_stream_sbc_encode(struct bt_a2dp_stream *stream, struct sbc_encoder *encoder,
+			      struct net_buf *buf, uint8_t frames_max, const void *pcm,
+			      size_t pcm_len);
+#endif /* CONFIG_LIBSBC */
+
 /** @brief send delay report
  *
  * Only A2DP sink side can call this function.
@@ -1206,6 +1206,43 @@ static inline int bt_obex_add_header_body_or_end_body(struct net_buf *buf, uint1
 	return err;
 }
 
+/** @brief Callback to produce a chunk of the object body.
+ *
+ *  Called by bt_obex_add_header_body_stream() to write the next chunk of the object body
+ *  directly into the buffer that is going to be sent.
+ *
+ *  @param data Where the chunk has to be written.
+ *  @param len Max length of the chunk.
+ *  @param last Set it to true if the chunk is the final chunk of the object body.
+ *  @param user_data User data passed to bt_obex_add_header_body_stream().
+ *
+ *  @return Length of the written chunk or negative value in case of error.
+ */
+typedef int (*bt_obex_body_cb_t)(uint8_t *data, uint16_t len, bool *last, void *user_data);
+
+/** @brief Add Header: a chunk (may be a final chunk) of the object body, produced in place.
+ *
+ *  Same as bt_obex_add_header_body_or_end_body(), except that the body is written by @p cb
+ *  directly into the tail room of the buffer instead of being copied from a body buffer of
+ *  the caller. The header end body is added if @p cb reports the final chunk. Or, the header
+ *  body will be added. Nothing is added if the buffer is full, or if @p cb produces an empty
+ *  chunk which is not the final one.
+ *
+ *  When Single Response Mode (SRM) is enabled, the buffers can be sent one after another
+ *  without waiting for the responses, so a large object is streamed with one call per packet.
+ *
+ *  @param buf Buffer needs to be sent.
+ *  @param mopl The MOPL of the OBEX connection
+ *  @param cb Callback producing the body.
+ *  @param user_data User data passed to @p cb.
+ *  @param added_len The added length of the body.
+ *  @param last Set to true if the final chunk has been added.
+ *
+ *  @return 0 in case of success or negative value in case of error.
+ */
+int bt_obex_add_header_body_stream(struct net_buf *buf, uint16_t mopl, bt_obex_body_cb_t cb,
+				   void *user_data, uint16_t *added_len, bool *last);
+
 /** @brief Add Header: identifies the OBEX application, used to tell if talking to a peer.
  *
  *  @param buf Buffer needs to be sent.
@@ -74,6 +74,12 @@ struct bt_rfcomm_dlc_ops {
 	void (*disconnected)(struct bt_rfcomm_dlc *dlc);
 
 	/** DLC recv callback
+	 *
+	 *  The buffer is the received frame, without copy. The application
+	 *  can keep it with net_buf_ref() instead of copying the data out,
+	 *  with @kconfig{CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS} the DLC gives one
+	 *  credit less to the peer for each such buffer until it is released,
+	 *  for up to @kconfig{CONFIG_BT_RFCOMM_DLC_RX_HOLD_MAX} buffers.
 	 *
 	 *  @param dlc The dlc receiving data.
 	 *  @param buf Buffer containing incoming data.
@@ -120,6 +126,11 @@ struct bt_rfcomm_dlc {
 	uint8_t                    dlci;
 	uint8_t                    state;
 	uint8_t                    rx_credit;
+
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+	/* RX buffers still referenced by the application */
+	struct net_buf            *rx_held[CONFIG_BT_RFCOMM_DLC_RX_HOLD_MAX];
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
 };
 
 struct bt_rfcomm_server {
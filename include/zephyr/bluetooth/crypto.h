@@ -89,6 +89,7 @@ int bt_encrypt_be(const uint8_t key[16], const uint8_t plaintext[16],
  *  @retval 0        Successfully decrypted the data.
  *  @retval -EINVAL  Invalid parameters.
  *  @retval -EBADMSG Authentication failed.
+ *  @retval -EIO     AES encryption failed.
  */
 int bt_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13], const uint8_t *enc_data,
 		   size_t len, const uint8_t *aad, size_t aad_len,
@@ -113,6 +114,7 @@ int bt_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13], const uint8_t *enc_
  *
  *  @retval 0        Successfully encrypted the data.
  *  @retval -EINVAL  Invalid parameters.
+ *  @retval -EIO     AES encryption failed.
  */
 int bt_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
 		   const uint8_t *plaintext, size_t len, const uint8_t *aad,
@@ -98,6 +98,43 @@ struct net_buf *bt_hci_cmd_alloc(k_timeout_t timeout);
   */
 int bt_hci_cmd_send(uint16_t opcode, struct net_buf *buf);
 
+/** @brief Callback for the completion of a HCI command.
+ *
+ *  @param opcode    Command OpCode.
+ *  @param status    HCI status of the Command Complete or Command Status
+ *                   event, or BT_HCI_ERR_UNSPECIFIED if the command could
+ *                   not be sent.
+ *  @param rsp       Buffer with the return parameters of the Command
+ *                   Complete event, or the Command Status event parameters.
+ *                   Only valid for the duration of the callback. NULL for
+ *                   BT_HCI_OP_HOST_NUM_COMPLETED_PACKETS, which has no
+ *                   response and whose callback is called once the command
+ *                   has been passed to the driver.
+ *  @param user_data User data passed to bt_hci_cmd_send_cb().
+ */
+typedef void (*bt_hci_cmd_cb_t)(uint16_t opcode, uint8_t status, struct net_buf *rsp,
+				void *user_data);
+
+/** Send a HCI command asynchronously with a completion callback.
+  *
+  * Like bt_hci_cmd_send(), but @p cb is called from the HCI RX context once
+  * the command completes. Commands sent with this function may be pipelined
+  * with each other, up to @kconfig{CONFIG_BT_HCI_CMD_PIPELINE_MAX} commands
+  * and the number of commands the Controller reports it can accept. Only
+  * use it for commands that do not depend on the outcome of the commands
+  * sent before them. Two commands with the same OpCode are never
+  * outstanding at the same time.
+  *
+  * @param opcode    Command OpCode.
+  * @param buf       Command buffer or NULL (if no parameters).
+  * @param cb        Callback to notify the completion, may be NULL.
+  * @param user_data User data passed to the callback.
+  *
+  * @return 0 on success or negative error value on failure.
+  */
+int bt_hci_cmd_send_cb(uint16_t opcode, struct net_buf *buf, bt_hci_cmd_cb_t cb,
+		       void *user_data);
+
 /** Send a HCI command synchronously.
   *
   * This function is used for sending a HCI command synchronously. It can
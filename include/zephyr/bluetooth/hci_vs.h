@@ -216,6 +216,24 @@ struct bt_hci_cp_vs_set_min_num_used_chans {
 	uint8_t  min_used_chans;
 } __packed;
 
+#define BT_HCI_OP_VS_READ_BIS_ANOMALY_COUNTERS BT_OP(BT_OGF_VS, 0x0013)
+
+struct bt_hci_cp_vs_read_bis_anomaly_counters {
+	uint16_t handle;
+} __packed;
+
+struct bt_hci_rp_vs_read_bis_anomaly_counters {
+	uint8_t  status;
+	uint16_t handle;
+	uint32_t rx_packets;
+	uint32_t rssi_outliers;
+	uint32_t timing_outliers;
+	uint32_t duplicate_mismatches;
+	uint32_t unexpected_packets;
+	uint32_t ctrl_unexpected_packets;
+	int8_t   rssi_avg;
+} __packed;
+
 /* Events */
 
 struct bt_hci_evt_vs {
@@ -163,6 +163,10 @@ struct bt_mesh_elem {
 	struct bt_mesh_elem_rt_ctx {
 		/** Unicast Address. Set at runtime during provisioning. */
 		uint16_t addr;
+#if defined(CONFIG_BT_MESH_ACCESS_SUB_FILTER)
+		/** Bitmap of hashed subscription addresses of the models. */
+		uint64_t sub_filter;
+#endif
 	} * const rt;
 
 	/** Location Descriptor (GATT Bluetooth Namespace Descriptors) */
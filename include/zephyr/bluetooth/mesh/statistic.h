@@ -47,6 +47,32 @@ struct bt_mesh_statistic {
 	uint32_t tx_friend_planned;
 	/** Counter of frames that succeeded to send over friend bearer. */
 	uint32_t tx_friend_succeeded;
+	/** Counter of segmented messages that were initiated to send. */
+	uint32_t tx_seg_msg_planned;
+	/** Counter of segmented messages that were sent completely. Messages to a unicast
+	 *  address are only counted once all segments have been acknowledged.
+	 */
+	uint32_t tx_seg_msg_succeeded;
+	/** Total number of segments in the segmented messages that were initiated to send. */
+	uint32_t tx_seg_planned;
+	/** Counter of segment transmissions, including retransmissions. */
+	uint32_t tx_seg_sent;
+	/** Upper Transport PDU octets of the segmented messages that were sent completely.
+	 *  Together with a time reference, this gives the segmented transfer goodput.
+	 */
+	uint32_t tx_seg_octets;
+};
+
+/** The structure that keeps statistics of a mesh advertising set. */
+struct bt_mesh_adv_set_statistic {
+	/** Counter of frames that were sent over the advertising set. */
+	uint32_t tx_count;
+	/** Total time in milliseconds the advertising set spent sending frames. */
+	uint32_t tx_time;
+	/** Total time in milliseconds the sent frames waited in the advertiser queue. */
+	uint32_t queue_latency;
+	/** Longest time in milliseconds a sent frame waited in the advertiser queue. */
+	uint32_t queue_latency_max;
 };
 
 /** @brief Get mesh frame handling statistic.
@@ -55,6 +81,20 @@ struct bt_mesh_statistic {
  */
 void bt_mesh_stat_get(struct bt_mesh_statistic *st);
 
+/** @brief Get the statistic of a mesh advertising set.
+ *
+ *  Only supported with the extended advertiser, where the first advertising
+ *  set is the main one, followed by the relay advertising sets and the
+ *  separate Friend and GATT advertising sets, if enabled.
+ *
+ *  @param idx  Index of the advertising set.
+ *  @param st   Advertising set statistic.
+ *
+ *  @return 0 on success, -ENOTSUP with the legacy advertiser, or -EINVAL if
+ *          there's no advertising set with the given index.
+ */
+int bt_mesh_stat_adv_set_get(uint8_t idx, struct bt_mesh_adv_set_statistic *st);
+
 /** @brief Reset mesh frame handling statistic.
  */
 void bt_mesh_stat_reset(void);
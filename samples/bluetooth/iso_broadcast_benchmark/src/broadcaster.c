@@ -19,6 +19,8 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys_clock.h>
+
+#include "common.h"
 LOG_MODULE_REGISTER(iso_broadcast_broadcaster, LOG_LEVEL_DBG);
 
 #define DEFAULT_BIS_RTN           2
@@ -29,6 +31,7 @@ LOG_MODULE_REGISTER(iso_broadcast_broadcaster, LOG_LEVEL_DBG);
 #define DEFAULT_BIS_PACKING       0
 #define DEFAULT_BIS_FRAMING       0
 #define DEFAULT_BIS_COUNT         CONFIG_BT_ISO_MAX_CHAN
+#define DEFAULT_BIS_ENCRYPTION    0
 #if defined(CONFIG_BT_ISO_TEST_PARAMS)
 #define DEFAULT_BIS_NSE           BT_ISO_NSE_MIN
 #define DEFAULT_BIS_BN            BT_ISO_BN_MIN
@@ -60,6 +63,8 @@ static struct bt_iso_big_create_param big_create_param = {
 	.framing = DEFAULT_BIS_FRAMING, /* 0 - unframed, 1 - framed */
 	.interval = DEFAULT_BIS_INTERVAL_US, /* in microseconds */
 	.latency = DEFAULT_BIS_LATENCY_MS, /* milliseconds */
+	.encryption = DEFAULT_BIS_ENCRYPTION,
+	.bcode = BENCHMARK_BROADCAST_CODE,
 #if defined(CONFIG_BT_ISO_TEST_PARAMS)
 	.irc = DEFAULT_BIS_IRC,
 	.pto = DEFAULT_BIS_PTO,
@@ -480,6 +485,29 @@ static int parse_bis_count_arg(void)
 	return (int)bis_count;
 }
 
+static int parse_encryption_arg(void)
+{
+	char buffer[3];
+	size_t char_count;
+	uint64_t encryption;
+
+	printk("Set encryption (current %u, default %u)\n",
+	       big_create_param.encryption, DEFAULT_BIS_ENCRYPTION);
+
+	char_count = get_chars(buffer, sizeof(buffer) - 1);
+	if (char_count == 0) {
+		return DEFAULT_BIS_ENCRYPTION;
+	}
+
+	encryption = strtoul(buffer, NULL, 0);
+	if (encryption > 1) {
+		printk("Invalid encryption %llu", encryption);
+		return -EINVAL;
+	}
+
+	return (int)encryption;
+}
+
 static int parse_args(void)
 {
 	int rtn;
@@ -490,6 +518,7 @@ static int parse_args(void)
 	int packing;
 	int framing;
 	int bis_count;
+	int encryption;
 #if defined(CONFIG_BT_ISO_TEST_PARAMS)
 	int num_subevents;
 	int iso_interval;
@@ -541,6 +570,11 @@ static int parse_args(void)
 		return -EINVAL;
 	}
 
+	encryption = parse_encryption_arg();
+	if (encryption < 0) {
+		return -EINVAL;
+	}
+
 #if defined(CONFIG_BT_ISO_TEST_PARAMS)
 	irc = parse_irc_arg();
 	if (irc < 0) {
@@ -581,6 +615,7 @@ static int parse_args(void)
 	big_create_param.packing = packing;
 	big_create_param.framing = framing;
 	big_create_param.num_bis = bis_count;
+	big_create_param.encryption = encryption;
 #if defined(CONFIG_BT_ISO_TEST_PARAMS)
 	bis_iso_qos.num_subevents = num_subevents;
 	iso_tx_qos.max_pdu = max_pdu;
@@ -625,6 +660,7 @@ static void iso_timer_timeout(struct k_work *work)
 
 		if ((iso_send_count % 100) == 0) {
 			LOG_INF("Sent %u packets", iso_send_count);
+			print_cpu_load();
 		}
 	}
 
@@ -809,10 +845,10 @@ int test_run_broadcaster(void)
 
 	printk("Change settings (y/N)? (Current settings: rtn=%u, interval=%u, "
 	       "latency=%u, phy=%u, sdu=%u, packing=%u, framing=%u, "
-	       "bis_count=%u)\n", iso_tx_qos.rtn, big_create_param.interval,
+	       "bis_count=%u, encryption=%u)\n", iso_tx_qos.rtn, big_create_param.interval,
 	       big_create_param.latency, iso_tx_qos.phy, iso_tx_qos.sdu,
 	       big_create_param.packing, big_create_param.framing,
-	       big_create_param.num_bis);
+	       big_create_param.num_bis, big_create_param.encryption);
 
 	c = tolower(console_getchar());
 	if (c == 'y') {
@@ -823,11 +859,12 @@ int test_run_broadcaster(void)
 		}
 
 		printk("New settings: rtn=%u, interval=%u, latency=%u, "
-		       "phy=%u, sdu=%u, packing=%u, framing=%u, bis_count=%u\n",
+		       "phy=%u, sdu=%u, packing=%u, framing=%u, bis_count=%u, "
+		       "encryption=%u\n",
 		       iso_tx_qos.rtn, big_create_param.interval,
 		       big_create_param.latency, iso_tx_qos.phy, iso_tx_qos.sdu,
 		       big_create_param.packing, big_create_param.framing,
-		       big_create_param.num_bis);
+		       big_create_param.num_bis, big_create_param.encryption);
 	}
 
 	err = create_big(&adv, &big);
@@ -4,5 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+/* Broadcast Code of the encrypted BIG, 16 octets including the terminating NULL */
+#define BENCHMARK_BROADCAST_CODE "ISO Bench BCode"
+
 int test_run_receiver(void);
 int test_run_broadcaster(void);
+void print_cpu_load(void);
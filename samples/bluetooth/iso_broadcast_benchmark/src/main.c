@@ -7,6 +7,7 @@
 #include <ctype.h>
 
 #include <zephyr/console/console.h>
+#include <zephyr/debug/cpu_load.h>
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/iso.h>
 
@@ -21,6 +22,24 @@ enum benchmark_role {
 	ROLE_QUIT
 };
 
+void print_cpu_load(void)
+{
+#if defined(CONFIG_CPU_LOAD)
+	int load;
+
+	/* Load since the previous call, including the time spent in the
+	 * Bluetooth Controller ISRs.
+	 */
+	load = cpu_load_get(true);
+	if (load < 0) {
+		LOG_ERR("Failed to get CPU load (err %d)", load);
+		return;
+	}
+
+	LOG_INF("CPU load %d.%d%%", load / 10, load % 10);
+#endif /* CONFIG_CPU_LOAD */
+}
+
 static enum benchmark_role device_role_select(void)
 {
 	char role;
@@ -12,6 +12,8 @@
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/console/console.h>
 
+#include "common.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(iso_broadcast_receiver, LOG_LEVEL_DBG);
 
@@ -35,6 +37,7 @@ static uint8_t      per_sid;
 static uint32_t     per_interval_us;
 static uint32_t     iso_interval_us;
 static uint8_t      bis_count;
+static bool         big_encrypted;
 static uint32_t     last_received_counter;
 static int64_t      big_sync_start_time;
 static size_t       big_sync_count;
@@ -154,6 +157,7 @@ static void biginfo_cb(struct bt_le_per_adv_sync *sync,
 
 	iso_interval_us = BT_CONN_INTERVAL_TO_US(biginfo->iso_interval);
 	bis_count = MIN(biginfo->num_bis, CONFIG_BT_ISO_MAX_CHAN);
+	big_encrypted = biginfo->encryption;
 	biginfo_received = true;
 	k_sem_give(&sem_per_big_info);
 }
@@ -224,6 +228,7 @@ static void iso_recv(struct bt_iso_chan *chan,
 		print_stats("Overall     ", &stats_overall);
 		print_stats("Current Sync", &stats_current_sync);
 		print_stats("Latest 1000 ", &stats_latest);
+		print_cpu_load();
 		LOG_INF(""); /* Empty line to separate the stats */
 	}
 }
@@ -384,6 +389,11 @@ static int create_big_sync(struct bt_iso_big **big, struct bt_le_per_adv_sync *s
 					    BT_ISO_SYNC_TIMEOUT_MIN,
 					    BT_ISO_SYNC_TIMEOUT_MAX);
 	big_sync_param.num_bis = bis_count;
+	if (big_encrypted) {
+		big_sync_param.encryption = true;
+		(void)memcpy(big_sync_param.bcode, BENCHMARK_BROADCAST_CODE,
+			     sizeof(big_sync_param.bcode));
+	}
 	/* BIS indexes start from 0x01 */
 	for (int i = 1; i <= big_sync_param.num_bis; i++) {
 		big_sync_param.bis_bitfield |= BT_ISO_BIS_INDEX_BIT(i);
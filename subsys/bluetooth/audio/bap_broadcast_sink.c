@@ -667,13 +667,33 @@ static bool base_decode_subgroup_cb(const struct bt_bap_base_subgroup *subgroup,
 	return true;
 }
 
+/* Check whether the advertising data is the BASE that has been stored, and thus already validated
+ * and parsed, so that the periodic advertising reports with an unchanged BASE can skip parsing.
+ */
+static bool pa_base_is_stored(const struct bt_bap_broadcast_sink *sink, const struct bt_data *data)
+{
+	return sink->base_size != 0U && data->type == BT_DATA_SVC_DATA16 &&
+	       data->data_len == BT_UUID_SIZE_16 + sink->base_size &&
+	       sys_get_le16(data->data) == BT_UUID_BASIC_AUDIO_VAL &&
+	       memcmp(&data->data[BT_UUID_SIZE_16], sink->base, sink->base_size) == 0;
+}
+
 static bool pa_decode_base(struct bt_data *data, void *user_data)
 {
 	struct bt_bap_broadcast_sink *sink = (struct bt_bap_broadcast_sink *)user_data;
-	const struct bt_bap_base *base = bt_bap_base_get_base_from_ad(data);
 	struct bt_bap_broadcast_sink_cb *listener;
+	const struct bt_bap_base *base;
 	int base_size;
 
+	if (pa_base_is_stored(sink, data)) {
+		base = (const struct bt_bap_base *)&data->data[BT_UUID_SIZE_16];
+		base_size = sink->base_size;
+
+		goto notify;
+	}
+
+	base = bt_bap_base_get_base_from_ad(data);
+
 	/* Base is NULL if the data does not contain a valid BASE */
 	if (base == NULL) {
 		return true;
@@ -720,6 +740,7 @@ static bool pa_decode_base(struct bt_data *data, void *user_data)
 		}
 	}
 
+notify:
 	SYS_SLIST_FOR_EACH_CONTAINER(&sink_cbs, listener, _node) {
 		if (listener->base_recv != NULL) {
 			listener->base_recv(sink, base, (size_t)base_size);
@@ -847,6 +847,7 @@ int bt_bap_broadcast_source_create(struct bt_bap_broadcast_source_param *param,
 
 	/* Finalize state changes and store information */
 	broadcast_source_set_state(source, BT_BAP_EP_STATE_QOS_CONFIGURED);
+	source->stream_count = stream_count;
 	source->qos = qos;
 	source->packing = param->packing;
 #if defined(CONFIG_BT_ISO_TEST_PARAMS)
@@ -1374,3 +1375,75 @@ int bt_bap_broadcast_source_foreach_stream(struct bt_bap_broadcast_source *sourc
 
 	return 0;
 }
+
+#if defined(CONFIG_BT_AUDIO_TX)
+static int broadcast_source_send(struct bt_bap_broadcast_source *source, struct net_buf *bufs[],
+				 size_t count, uint16_t seq_num, uint32_t ts, bool has_ts,
+				 int results[])
+{
+	struct bt_bap_broadcast_subgroup *subgroup;
+	size_t i = 0U;
+	int err = 0;
+
+	CHECKIF(source == NULL) {
+		LOG_DBG("source is NULL");
+		return -EINVAL;
+	}
+
+	CHECKIF(bufs == NULL) {
+		LOG_DBG("bufs is NULL");
+		return -EINVAL;
+	}
+
+	CHECKIF(results == NULL) {
+		LOG_DBG("results is NULL");
+		return -EINVAL;
+	}
+
+	CHECKIF(count != source->stream_count) {
+		LOG_DBG("Invalid count %zu for %u streams", count, source->stream_count);
+		return -EINVAL;
+	}
+
+	if (source->big == NULL) {
+		LOG_DBG("Source is not started");
+		return -EBADMSG;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&source->subgroups, subgroup, _node) {
+		struct bt_bap_stream *stream;
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&subgroup->streams, stream, _node) {
+			if (stream->ep->state != BT_BAP_EP_STATE_STREAMING) {
+				LOG_DBG("Stream %p not ready for streaming (state: %s)", stream,
+					bt_bap_ep_state_str(stream->ep->state));
+				results[i] = -EBADMSG;
+			} else {
+				results[i] = bt_bap_stream_iso_send(stream, bufs[i], seq_num, ts,
+								    has_ts);
+			}
+
+			if (results[i] < 0) {
+				err = -EIO;
+			}
+
+			i++;
+		}
+	}
+
+	return err;
+}
+
+int bt_bap_broadcast_source_send(struct bt_bap_broadcast_source *source, struct net_buf *bufs[],
+				 size_t count, uint16_t seq_num, int results[])
+{
+	return broadcast_source_send(source, bufs, count, seq_num, 0, false, results);
+}
+
+int bt_bap_broadcast_source_send_ts(struct bt_bap_broadcast_source *source,
+				    struct net_buf *bufs[], size_t count, uint16_t seq_num,
+				    uint32_t ts, int results[])
+{
+	return broadcast_source_send(source, bufs, count, seq_num, ts, true, results);
+}
+#endif /* CONFIG_BT_AUDIO_TX */
@@ -364,9 +364,7 @@ static bool bt_bap_stream_can_send(const struct bt_bap_stream *stream)
 static int bap_stream_send(struct bt_bap_stream *stream, struct net_buf *buf, uint16_t seq_num,
 			   uint32_t ts, bool has_ts)
 {
-	struct bt_iso_chan *iso_chan;
 	struct bt_bap_ep *ep;
-	int ret;
 
 	if (stream == NULL) {
 		LOG_DBG("stream is NULL");
@@ -392,6 +390,15 @@ static int bap_stream_send(struct bt_bap_stream *stream, struct net_buf *buf, ui
 		return -EBADMSG;
 	}
 
+	return bt_bap_stream_iso_send(stream, buf, seq_num, ts, has_ts);
+}
+
+int bt_bap_stream_iso_send(struct bt_bap_stream *stream, struct net_buf *buf, uint16_t seq_num,
+			   uint32_t ts, bool has_ts)
+{
+	struct bt_iso_chan *iso_chan;
+	int ret;
+
 	iso_chan = bt_bap_stream_iso_chan_get(stream);
 
 	if (has_ts) {
@@ -37,3 +37,7 @@ enum bt_bap_ascs_reason bt_bap_stream_verify_qos(const struct bt_bap_stream *str
 						 const struct bt_bap_qos_cfg *qos);
 
 struct bt_iso_chan *bt_bap_stream_iso_chan_get(struct bt_bap_stream *stream);
+
+/* Send on the ISO channel of a stream that is known to be streaming and able to send */
+int bt_bap_stream_iso_send(struct bt_bap_stream *stream, struct net_buf *buf, uint16_t seq_num,
+			   uint32_t ts, bool has_ts);
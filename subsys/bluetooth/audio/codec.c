@@ -549,6 +549,153 @@ int bt_audio_codec_cfg_set_frame_blocks_per_sdu(struct bt_audio_codec_cfg *codec
 	return bt_audio_codec_cfg_set_val(codec_cfg, BT_AUDIO_CODEC_CFG_FRAME_BLKS_PER_SDU,
 					  &frame_blocks, sizeof(frame_blocks));
 }
+
+/* Bit per codec configuration type, set once the first occurrence has been decoded */
+#define CFG_PARAMS_FREQ         BIT(0)
+#define CFG_PARAMS_DURATION     BIT(1)
+#define CFG_PARAMS_CHAN_ALLOC   BIT(2)
+#define CFG_PARAMS_FRAME_LEN    BIT(3)
+#define CFG_PARAMS_FRAME_BLKS   BIT(4)
+#define CFG_PARAMS_ALL          BIT_MASK(5)
+
+struct cfg_params_data {
+	struct bt_audio_codec_cfg_params *params;
+	uint8_t found;
+};
+
+static bool cfg_params_parse_cb(struct bt_data *data, void *user_data)
+{
+	struct cfg_params_data *parse_data = user_data;
+	struct bt_audio_codec_cfg_params *params = parse_data->params;
+
+	switch (data->type) {
+	case BT_AUDIO_CODEC_CFG_FREQ:
+		if (parse_data->found & CFG_PARAMS_FREQ) {
+			break;
+		}
+
+		parse_data->found |= CFG_PARAMS_FREQ;
+
+		if (data->data_len != sizeof(uint8_t) ||
+		    bt_audio_codec_cfg_freq_to_freq_hz(data->data[0]) < 0) {
+			params->freq = -EBADMSG;
+		} else {
+			params->freq = data->data[0];
+		}
+		break;
+	case BT_AUDIO_CODEC_CFG_DURATION:
+		if (parse_data->found & CFG_PARAMS_DURATION) {
+			break;
+		}
+
+		parse_data->found |= CFG_PARAMS_DURATION;
+
+		if (data->data_len != sizeof(uint8_t) ||
+		    bt_audio_codec_cfg_frame_dur_to_frame_dur_us(data->data[0]) < 0) {
+			params->frame_dur = -EBADMSG;
+		} else {
+			params->frame_dur = data->data[0];
+		}
+		break;
+	case BT_AUDIO_CODEC_CFG_CHAN_ALLOC:
+		if (parse_data->found & CFG_PARAMS_CHAN_ALLOC) {
+			break;
+		}
+
+		parse_data->found |= CFG_PARAMS_CHAN_ALLOC;
+
+		if (data->data_len != sizeof(uint32_t)) {
+			params->chan_allocation_err = -EBADMSG;
+		} else {
+			params->chan_allocation = sys_get_le32(data->data);
+			params->chan_allocation_err = 0;
+		}
+		break;
+	case BT_AUDIO_CODEC_CFG_FRAME_LEN:
+		if (parse_data->found & CFG_PARAMS_FRAME_LEN) {
+			break;
+		}
+
+		parse_data->found |= CFG_PARAMS_FRAME_LEN;
+
+		if (data->data_len != sizeof(uint16_t)) {
+			params->octets_per_frame = -EBADMSG;
+		} else {
+			params->octets_per_frame = sys_get_le16(data->data);
+		}
+		break;
+	case BT_AUDIO_CODEC_CFG_FRAME_BLKS_PER_SDU:
+		if (parse_data->found & CFG_PARAMS_FRAME_BLKS) {
+			break;
+		}
+
+		parse_data->found |= CFG_PARAMS_FRAME_BLKS;
+
+		if (data->data_len != sizeof(uint8_t)) {
+			params->frame_blocks_per_sdu = -EBADMSG;
+		} else {
+			params->frame_blocks_per_sdu = data->data[0];
+		}
+		break;
+	default:
+		break;
+	}
+
+	/* Stop parsing once all the values have been found */
+	return parse_data->found != CFG_PARAMS_ALL;
+}
+
+int bt_audio_codec_cfg_get_params(const struct bt_audio_codec_cfg *codec_cfg,
+				  struct bt_audio_codec_cfg_params *params,
+				  bool fallback_to_default)
+{
+	struct cfg_params_data parse_data = {
+		.params = params,
+		.found = 0U,
+	};
+	int err;
+
+	CHECKIF(codec_cfg == NULL) {
+		LOG_DBG("codec is NULL");
+		return -EINVAL;
+	}
+
+	CHECKIF(params == NULL) {
+		LOG_DBG("params is NULL");
+		return -EINVAL;
+	}
+
+	params->freq = -ENODATA;
+	params->frame_dur = -ENODATA;
+	params->chan_allocation = 0;
+	params->chan_allocation_err = -ENODATA;
+	params->octets_per_frame = -ENODATA;
+	params->frame_blocks_per_sdu = -ENODATA;
+
+	if (codec_cfg->data_len > 0U) {
+		err = bt_audio_data_parse(codec_cfg->data, codec_cfg->data_len,
+					  cfg_params_parse_cb, &parse_data);
+		if (err != 0 && err != -ECANCELED) {
+			/* Keep the values found before the malformed entry, like the getters that
+			 * stop at the first match
+			 */
+			LOG_DBG("Could not parse the data: %d", err);
+		}
+	}
+
+	if (fallback_to_default && codec_cfg->id == BT_HCI_CODING_FORMAT_LC3) {
+		if ((parse_data.found & CFG_PARAMS_CHAN_ALLOC) == 0U) {
+			params->chan_allocation = BT_AUDIO_LOCATION_MONO_AUDIO;
+			params->chan_allocation_err = 0;
+		}
+
+		if ((parse_data.found & CFG_PARAMS_FRAME_BLKS) == 0U) {
+			params->frame_blocks_per_sdu = 1;
+		}
+	}
+
+	return 0;
+}
 #endif /* CONFIG_BT_AUDIO_CODEC_CFG_MAX_DATA_SIZE > 0 */
 
 #if CONFIG_BT_AUDIO_CODEC_CFG_MAX_METADATA_SIZE > 0 ||                                             \
@@ -2914,12 +2914,17 @@ static void stream_started_cb(struct bt_bap_stream *bap_stream)
 	const struct bt_audio_codec_cfg *codec_cfg = bap_stream->codec_cfg;
 
 	if (codec_cfg->id == BT_HCI_CODING_FORMAT_LC3) {
+		struct bt_audio_codec_cfg_params params;
+
 		if (sh_stream->is_tx) {
 			atomic_set(&sh_stream->tx.lc3_enqueue_cnt, PRIME_COUNT);
 			sh_stream->tx.lc3_sdu_cnt = 0U;
 		}
 
-		ret = bt_audio_codec_cfg_get_freq(codec_cfg);
+		/* Don't fall back to the default channel allocation */
+		(void)bt_audio_codec_cfg_get_params(codec_cfg, &params, false);
+
+		ret = params.freq;
 		if (ret >= 0) {
 			ret = bt_audio_codec_cfg_freq_to_freq_hz(ret);
 
@@ -2940,7 +2945,7 @@ static void stream_started_cb(struct bt_bap_stream *bap_stream)
 			sh_stream->lc3_freq_hz = 0U;
 		}
 
-		ret = bt_audio_codec_cfg_get_frame_dur(codec_cfg);
+		ret = params.frame_dur;
 		if (ret >= 0) {
 			ret = bt_audio_codec_cfg_frame_dur_to_frame_dur_us(ret);
 			if (ret > 0) {
@@ -2954,9 +2959,9 @@ static void stream_started_cb(struct bt_bap_stream *bap_stream)
 			sh_stream->lc3_frame_duration_us = 0U;
 		}
 
-		ret = bt_audio_codec_cfg_get_chan_allocation(
-			codec_cfg, &sh_stream->lc3_chan_allocation, false);
+		ret = params.chan_allocation_err;
 		if (ret == 0) {
+			sh_stream->lc3_chan_allocation = params.chan_allocation;
 			sh_stream->lc3_chan_cnt =
 				bt_audio_get_chan_count(sh_stream->lc3_chan_allocation);
 		} else {
@@ -2965,7 +2970,12 @@ static void stream_started_cb(struct bt_bap_stream *bap_stream)
 			sh_stream->lc3_chan_cnt = 1U;
 		}
 
-		ret = bt_audio_codec_cfg_get_frame_blocks_per_sdu(codec_cfg, true);
+		ret = params.frame_blocks_per_sdu;
+		if (ret == -ENODATA) {
+			/* Default value for LC3 */
+			ret = 1;
+		}
+
 		if (ret >= 0) {
 			sh_stream->lc3_frame_blocks_per_sdu = (uint8_t)ret;
 		} else {
@@ -2973,7 +2983,7 @@ static void stream_started_cb(struct bt_bap_stream *bap_stream)
 			sh_stream->lc3_frame_blocks_per_sdu = 0U;
 		}
 
-		ret = bt_audio_codec_cfg_get_octets_per_frame(codec_cfg);
+		ret = params.octets_per_frame;
 		if (ret >= 0) {
 			sh_stream->lc3_octets_per_frame = (uint16_t)ret;
 		} else {
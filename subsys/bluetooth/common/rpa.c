@@ -18,6 +18,11 @@
 #include "common/bt_str.h"
 
 #include <zephyr/bluetooth/crypto.h>
+#include <zephyr/sys/byteorder.h>
+
+#if defined(CONFIG_BT_HOST_CRYPTO) && !defined(CONFIG_BT_CTLR_CRYPTO)
+#include <psa/crypto.h>
+#endif /* CONFIG_BT_HOST_CRYPTO && !CONFIG_BT_CTLR_CRYPTO */
 
 #define LOG_LEVEL CONFIG_BT_RPA_LOG_LEVEL
 #include <zephyr/logging/log.h>
@@ -95,6 +100,101 @@ bool bt_rpa_irk_matches(const uint8_t irk[16], const bt_addr_t *addr)
 
 	return !memcmp(addr->val, hash, 3);
 }
+
+#if defined(CONFIG_BT_HOST_CRYPTO) && !defined(CONFIG_BT_CTLR_CRYPTO)
+static int irk_matches_batch_psa(const uint8_t *const irks[], size_t count,
+				 const bt_addr_t *addr)
+{
+	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+	uint8_t plaintext[16] = { 0 };
+	uint8_t key[16];
+	uint8_t res[16];
+	uint8_t hash[3];
+	int err = -ENOENT;
+
+	/* PSA works on big-endian data, so r' = padding || r is built once in
+	 * that order and the key attributes are shared by all the IRKs.
+	 */
+	sys_memcpy_swap(&plaintext[13], addr->val + 3, 3);
+
+	psa_set_key_type(&attr, PSA_KEY_TYPE_AES);
+	psa_set_key_bits(&attr, 128);
+	psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_ENCRYPT);
+	psa_set_key_algorithm(&attr, PSA_ALG_ECB_NO_PADDING);
+
+	for (size_t i = 0; i < count; i++) {
+		psa_key_id_t key_id = MBEDTLS_SVC_KEY_ID_INIT;
+		psa_status_t status, destroy_status;
+		size_t out_len;
+
+		sys_memcpy_swap(key, irks[i], sizeof(key));
+
+		status = psa_import_key(&attr, key, sizeof(key), &key_id);
+		if (status != PSA_SUCCESS) {
+			LOG_ERR("Failed to import AES key %d", status);
+			err = -EINVAL;
+			break;
+		}
+
+		status = psa_cipher_encrypt(key_id, PSA_ALG_ECB_NO_PADDING, plaintext,
+					    sizeof(plaintext), res, sizeof(res), &out_len);
+		if (status != PSA_SUCCESS) {
+			LOG_ERR("AES encryption failed %d", status);
+		}
+
+		destroy_status = psa_destroy_key(key_id);
+		if (destroy_status != PSA_SUCCESS) {
+			LOG_ERR("Failed to destroy AES key %d", destroy_status);
+		}
+
+		if ((status != PSA_SUCCESS) || (destroy_status != PSA_SUCCESS)) {
+			err = -EIO;
+			break;
+		}
+
+		/* ah() is the least significant 24 bits of the little-endian result */
+		sys_memcpy_swap(hash, &res[13], sizeof(hash));
+		if (!memcmp(addr->val, hash, sizeof(hash))) {
+			err = i;
+			break;
+		}
+	}
+
+	(void)memset(key, 0, sizeof(key));
+
+	return err;
+}
+#endif /* CONFIG_BT_HOST_CRYPTO && !CONFIG_BT_CTLR_CRYPTO */
+
+int bt_rpa_irk_matches_batch(const uint8_t *const irks[], size_t count, const bt_addr_t *addr)
+{
+	LOG_DBG("%zu IRKs bdaddr %s", count, bt_addr_str(addr));
+
+#if defined(CONFIG_BT_HOST_CRYPTO) && !defined(CONFIG_BT_CTLR_CRYPTO)
+	return irk_matches_batch_psa(irks, count, addr);
+#else /* !CONFIG_BT_HOST_CRYPTO || CONFIG_BT_CTLR_CRYPTO */
+	uint8_t r[16];
+	uint8_t res[16];
+	int err;
+
+	/* r' = padding || r, shared by all the IRKs */
+	memcpy(r, addr->val + 3, 3);
+	(void)memset(r + 3, 0, 13);
+
+	for (size_t i = 0; i < count; i++) {
+		err = internal_encrypt_le(irks[i], r, res);
+		if (err) {
+			return err;
+		}
+
+		if (!memcmp(addr->val, res, 3)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+#endif /* CONFIG_BT_HOST_CRYPTO && !CONFIG_BT_CTLR_CRYPTO */
+}
 #endif
 
 #if defined(CONFIG_BT_PRIVACY) || defined(CONFIG_BT_CTLR_PRIVACY)
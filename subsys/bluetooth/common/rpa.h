@@ -13,4 +13,12 @@
 #include <zephyr/bluetooth/hci.h>
 
 bool bt_rpa_irk_matches(const uint8_t irk[16], const bt_addr_t *addr);
+
+/* Check an RPA against several IRKs, sharing the setup of the AES operation
+ * between them.
+ *
+ * Returns the index of the first matching IRK, -ENOENT if none of them
+ * matches or another negative error code if the encryption failed.
+ */
+int bt_rpa_irk_matches_batch(const uint8_t *const irks[], size_t count, const bt_addr_t *addr);
 int bt_rpa_create(const uint8_t irk[16], bt_addr_t *rpa);
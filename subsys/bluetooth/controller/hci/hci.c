@@ -5112,6 +5112,10 @@ static void vs_read_supported_commands(struct net_buf *buf,
 	/* Write Tx Power, Read Tx Power */
 	rp->commands[1] |= BIT(5) | BIT(6);
 #endif /* CONFIG_BT_CTLR_TX_PWR_DYNAMIC_CONTROL */
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+	/* Read BIS Anomaly Counters */
+	rp->commands[2] |= BIT(2);
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
 }
 
 static void vs_read_supported_features(struct net_buf *buf,
@@ -5263,6 +5267,51 @@ static void vs_read_tx_power_level(struct net_buf *buf, struct net_buf **evt)
 }
 #endif /* CONFIG_BT_CTLR_TX_PWR_DYNAMIC_CONTROL */
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+static void vs_read_bis_anomaly_counters(struct net_buf *buf,
+					 struct net_buf **evt)
+{
+	struct bt_hci_cp_vs_read_bis_anomaly_counters *cmd = (void *)buf->data;
+	struct bt_hci_rp_vs_read_bis_anomaly_counters *rp;
+	uint32_t ctrl_unexpected_packets;
+	uint32_t duplicate_mismatches;
+	uint32_t unexpected_packets;
+	uint32_t timing_outliers;
+	uint32_t rssi_outliers;
+	uint32_t rx_packets;
+	uint16_t handle;
+	int8_t rssi_avg;
+	uint8_t status;
+
+	handle = sys_le16_to_cpu(cmd->handle);
+	status = ll_big_sync_anomaly_get(handle, &rx_packets, &rssi_outliers,
+					 &timing_outliers,
+					 &duplicate_mismatches,
+					 &unexpected_packets,
+					 &ctrl_unexpected_packets, &rssi_avg);
+
+	rp = hci_cmd_complete(evt, sizeof(*rp));
+	if (status) {
+		/* Do not return counters for an unknown or disallowed handle */
+		(void)memset(rp, 0x00, sizeof(*rp));
+		rp->status = status;
+		rp->handle = cmd->handle;
+
+		return;
+	}
+
+	rp->status = status;
+	rp->handle = cmd->handle;
+	rp->rx_packets = sys_cpu_to_le32(rx_packets);
+	rp->rssi_outliers = sys_cpu_to_le32(rssi_outliers);
+	rp->timing_outliers = sys_cpu_to_le32(timing_outliers);
+	rp->duplicate_mismatches = sys_cpu_to_le32(duplicate_mismatches);
+	rp->unexpected_packets = sys_cpu_to_le32(unexpected_packets);
+	rp->ctrl_unexpected_packets = sys_cpu_to_le32(ctrl_unexpected_packets);
+	rp->rssi_avg = rssi_avg;
+}
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 #if defined(CONFIG_BT_HCI_VS_FATAL_ERROR)
 /* A memory pool for vandor specific events for fatal error reporting purposes. */
 NET_BUF_POOL_FIXED_DEFINE(vs_err_tx_pool, 1, BT_BUF_EVT_RX_SIZE, 0, NULL);
@@ -5797,6 +5846,12 @@ int hci_vendor_cmd_handle_common(uint16_t ocf, struct net_buf *cmd,
 		break;
 #endif /* CONFIG_BT_CTLR_MIN_USED_CHAN && CONFIG_BT_PERIPHERAL */
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+	case BT_OCF(BT_HCI_OP_VS_READ_BIS_ANOMALY_COUNTERS):
+		vs_read_bis_anomaly_counters(cmd, evt);
+		break;
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 #if defined(CONFIG_BT_HCI_MESH_EXT)
 	case BT_OCF(BT_HCI_OP_VS_MESH):
 		mesh_cmd_handle(cmd, evt);
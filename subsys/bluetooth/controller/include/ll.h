@@ -133,6 +133,13 @@ uint8_t ll_big_sync_create(uint8_t big_handle, uint16_t sync_handle,
 			   uint16_t sync_timeout, uint8_t num_bis,
 			   uint8_t *bis);
 uint8_t ll_big_sync_terminate(uint8_t big_handle, void **rx);
+uint8_t ll_big_sync_anomaly_get(uint16_t handle, uint32_t *rx_packets,
+				uint32_t *rssi_outliers,
+				uint32_t *timing_outliers,
+				uint32_t *duplicate_mismatches,
+				uint32_t *unexpected_packets,
+				uint32_t *ctrl_unexpected_packets,
+				int8_t *rssi_avg);
 
 /* Connected ISO State Interfaces */
 uint8_t ll_cig_parameters_open(uint8_t cig_id,
@@ -97,6 +97,10 @@ struct lll_adv_iso {
 	/* Encryption */
 	uint8_t giv[8];
 	struct ccm ccm_tx;
+	/* IV octets 0-3 of the BIG Control PDUs (index 0) and of each BIS,
+	 * prepared at BIG setup.
+	 */
+	uint8_t bis_iv[BT_CTLR_ADV_ISO_STREAM_MAX + 1U][4];
 
 #if defined(CONFIG_BT_TICKER_EXT_EXPIRE_INFO)
 	/* contains the offset in ticks from the adv_sync pointing to this ISO */
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "hal/ccm.h"
 #include "hal/radio.h"
@@ -13,12 +14,35 @@
 #include <soc.h>
 #include "hal/debug.h"
 
+#if defined(CONFIG_BT_CTLR_CHAN_SEL_2) && defined(CONFIG_BT_CTLR_ISO)
+/* Number of octets and channel indices covered by a channel map */
+#define CHAN_MAP_OCTETS  5U
+#define CHAN_MAP_BITS    (CHAN_MAP_OCTETS << 3)
+
+/* Used channel tables of the most recently used ISO channel map. The ISO
+ * channel selection functions are only called from LLL context, hence the
+ * tables are rebuilt only when a different channel map is used, and not for
+ * each event and subevent.
+ */
+static struct {
+	uint8_t chan_map[CHAN_MAP_OCTETS];
+	/* Channel index of each used channel index */
+	uint8_t chan[CHAN_MAP_BITS];
+	/* Used channel index, i.e. number of used channels below each channel
+	 * index
+	 */
+	uint8_t remap_idx[CHAN_MAP_BITS];
+} chan_remap;
+#endif /* CONFIG_BT_CTLR_CHAN_SEL_2 && CONFIG_BT_CTLR_ISO */
+
 static uint8_t chan_sel_remap(uint8_t *chan_map, uint8_t chan_index);
 #if defined(CONFIG_BT_CTLR_CHAN_SEL_2)
 static uint16_t chan_prn_s(uint16_t counter, uint16_t chan_id);
 static uint16_t chan_prn_e(uint16_t counter, uint16_t chan_id);
 
 #if defined(CONFIG_BT_CTLR_ISO)
+static void chan_iso_remap_update(const uint8_t *chan_map);
+static uint8_t chan_iso_remap(uint8_t *chan_map, uint8_t chan_index);
 static uint8_t chan_sel_remap_index(uint8_t *chan_map, uint8_t chan_index);
 static uint16_t chan_prn_subevent_se(uint16_t chan_id,
 				     uint16_t *prn_subevent_lu);
@@ -109,7 +133,7 @@ uint8_t lll_chan_iso_event(uint16_t counter, uint16_t chan_id,
 
 	if ((chan_map[chan_idx >> 3] & (1 << (chan_idx % 8))) == 0U) {
 		*remap_idx = ((uint32_t)chan_count * prn_e) >> 16;
-		chan_idx = chan_sel_remap(chan_map, *remap_idx);
+		chan_idx = chan_iso_remap(chan_map, *remap_idx);
 
 	} else {
 		*remap_idx = chan_sel_remap_index(chan_map, chan_idx);
@@ -147,7 +171,7 @@ uint8_t lll_chan_iso_subevent(uint16_t chan_id, uint8_t *chan_map,
 	*remap_idx = ((((uint32_t)prn_subevent_se * x) >> 16) +
 		      d + *remap_idx) % chan_count;
 
-	return chan_sel_remap(chan_map, *remap_idx);
+	return chan_iso_remap(chan_map, *remap_idx);
 }
 #endif /* CONFIG_BT_CTLR_ISO */
 #endif /* CONFIG_BT_CTLR_CHAN_SEL_2 */
@@ -191,23 +215,19 @@ static uint8_t chan_sel_remap(uint8_t *chan_map, uint8_t chan_index)
 }
 
 #if defined(CONFIG_BT_CTLR_CHAN_SEL_2)
-/* Attribution:
- * http://graphics.stanford.edu/%7Eseander/bithacks.html#ReverseByteWith32Bits
- */
 /* Refer to Bluetooth Specification v5.2 Vol 6, Part B, Section 4.5.8.3.2
  * Inputs and basic components, for below operations
  */
-static uint8_t chan_rev_8(uint8_t b)
-{
-	b = (((uint32_t)b * 0x0802LU & 0x22110LU) |
-	     ((uint32_t)b * 0x8020LU & 0x88440LU)) * 0x10101LU >> 16;
-
-	return b;
-}
-
 static uint16_t chan_perm(uint16_t i)
 {
-	return (chan_rev_8((i >> 8) & 0xFF) << 8) | chan_rev_8(i & 0xFF);
+	/* Reverse the bits of both octets in parallel, swapping adjacent bits,
+	 * then bit pairs, then nibbles.
+	 */
+	i = ((i & 0x5555U) << 1) | ((i >> 1) & 0x5555U);
+	i = ((i & 0x3333U) << 2) | ((i >> 2) & 0x3333U);
+	i = ((i & 0x0F0FU) << 4) | ((i >> 4) & 0x0F0FU);
+
+	return i;
 }
 
 static uint16_t chan_mam(uint16_t a, uint16_t b)
@@ -250,33 +270,59 @@ static uint16_t chan_prn_e(uint16_t counter, uint16_t chan_id)
  */
 static uint8_t chan_sel_remap_index(uint8_t *chan_map, uint8_t chan_index)
 {
-	uint8_t octet_count;
-	uint8_t remap_index;
+	if (chan_index >= CHAN_MAP_BITS) {
+		return 0U;
+	}
 
-	remap_index = 0U;
-	octet_count = 5U;
-	while (octet_count--) {
-		uint8_t octet;
-		uint8_t bit_count;
+	chan_iso_remap_update(chan_map);
 
-		octet = *chan_map;
-		bit_count = 8U;
-		while (bit_count--) {
-			if (!chan_index) {
-				return remap_index;
-			}
-			chan_index--;
+	return chan_remap.remap_idx[chan_index];
+}
 
-			if (octet & BIT(0)) {
-				remap_index++;
-			}
-			octet >>= 1;
+/* Rebuild the ISO used channel tables if the channel map differs from the one
+ * they were built for.
+ */
+static void chan_iso_remap_update(const uint8_t *chan_map)
+{
+	uint8_t chan_used;
+	uint8_t chan_idx;
+
+	if (!memcmp(chan_remap.chan_map, chan_map, sizeof(chan_remap.chan_map))) {
+		return;
+	}
+
+	(void)memcpy(chan_remap.chan_map, chan_map, sizeof(chan_remap.chan_map));
+
+	chan_used = 0U;
+	for (chan_idx = 0U; chan_idx < CHAN_MAP_BITS; chan_idx++) {
+		chan_remap.remap_idx[chan_idx] = chan_used;
+
+		if (chan_map[chan_idx >> 3] & BIT(chan_idx & 0x07)) {
+			chan_remap.chan[chan_used++] = chan_idx;
 		}
+	}
 
-		chan_map++;
+	/* Out of range used channel indices map past the last channel, as
+	 * when walking the channel map.
+	 */
+	while (chan_used < CHAN_MAP_BITS) {
+		chan_remap.chan[chan_used++] = CHAN_MAP_BITS;
 	}
+}
+
+/* Refer to Bluetooth Specification v5.2 Vol 6, Part B, Section 4.5.8.3
+ * Channel Selection algorithm #2, and Section 4.5.8.3.4 Event mapping to used
+ * channel index, using the used channel tables
+ */
+static uint8_t chan_iso_remap(uint8_t *chan_map, uint8_t chan_index)
+{
+	if (chan_index >= CHAN_MAP_BITS) {
+		return CHAN_MAP_BITS;
+	}
+
+	chan_iso_remap_update(chan_map);
 
-	return 0;
+	return chan_remap.chan[chan_index];
 }
 
 /* Refer to Bluetooth Specification v5.2 Vol 6, Part B, Section 4.5.8.3
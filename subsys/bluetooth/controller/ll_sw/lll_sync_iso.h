@@ -4,11 +4,35 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+struct lll_sync_iso_anomaly {
+	/* Received PDUs with valid CRC */
+	uint32_t rx_cnt;
+	/* PDUs with an RSSI or reception time off the running average */
+	uint32_t rssi_cnt;
+	uint32_t offset_cnt;
+	/* Repetitions of a received payload with different content */
+	uint32_t dup_cnt;
+	/* PDUs not valid in the subevent, dropped */
+	uint32_t unexpected_cnt;
+
+	/* Running averages, in 1/16 dB and 1/16 us */
+	int16_t rssi_avg;
+	int16_t offset_avg;
+	uint8_t rssi_init;
+	uint8_t offset_init;
+};
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 struct lll_sync_iso_stream {
 	uint8_t big_handle;
 	uint8_t bis_index;
 	struct ll_iso_rx_test_mode *test_mode;
 	struct ll_iso_datapath *dp;
+
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+	struct lll_sync_iso_anomaly anomaly;
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
 };
 
 struct lll_sync_iso_data_chan {
@@ -80,6 +104,10 @@ struct lll_sync_iso {
 	/* Encryption */
 	uint8_t giv[8];
 	struct ccm ccm_rx;
+	/* IV octets 0-3 of the BIG Control PDUs (index 0) and of each selected
+	 * stream (index stream_curr + 1), prepared at BIG setup.
+	 */
+	uint8_t bis_iv[BT_CTLR_SYNC_ISO_STREAM_MAX + 1U][4];
 
 	uint8_t chm_chan_map[PDU_CHANNEL_MAP_SIZE];
 	uint8_t chm_chan_count:6;
@@ -88,6 +116,11 @@ struct lll_sync_iso {
 
 	uint16_t ctrl_instant;
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+	/* Data PDUs received in the Control subevent, not of any BIS */
+	uint32_t anomaly_ctrl_cnt;
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 	uint8_t stream_count;
 	uint16_t stream_handle[BT_CTLR_SYNC_ISO_STREAM_MAX];
 
@@ -361,8 +361,7 @@ static int prepare_cb_common(struct lll_prepare_param *p)
 		/* Encryption */
 		lll->ccm_tx.counter = payload_count;
 
-		(void)memcpy(lll->ccm_tx.iv, lll->giv, 4U);
-		mem_xor_32(lll->ccm_tx.iv, lll->ccm_tx.iv, access_addr);
+		(void)memcpy(lll->ccm_tx.iv, lll->bis_iv[lll->bis_curr], 4U);
 
 		radio_pkt_configure(RADIO_PKT_CONF_LENGTH_8BIT,
 				    (lll->max_pdu + PDU_MIC_SIZE), pkt_flags);
@@ -812,8 +811,7 @@ static void isr_tx_common(void *param,
 	    pdu->len && lll->enc) {
 		lll->ccm_tx.counter = payload_count;
 
-		(void)memcpy(lll->ccm_tx.iv, lll->giv, 4U);
-		mem_xor_32(lll->ccm_tx.iv, lll->ccm_tx.iv, access_addr);
+		(void)memcpy(lll->ccm_tx.iv, lll->bis_iv[bis], 4U);
 
 		radio_pkt_tx_set(radio_ccm_iso_tx_pkt_set(&lll->ccm_tx,
 						RADIO_PKT_CONF_PDU_TYPE_BIS,
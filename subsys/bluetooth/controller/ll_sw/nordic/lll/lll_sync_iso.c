@@ -65,6 +65,15 @@ static void isr_rx_iso_data_invalid(const struct lll_sync_iso *const lll,
 				    uint16_t handle,
 				    struct node_rx_pdu *node_rx);
 static void isr_rx_ctrl_recv(struct lll_sync_iso *lll, struct pdu_bis *pdu);
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+static bool isr_rx_anomaly_mic_is_valid(const struct lll_sync_iso *lll,
+					const struct pdu_bis *pdu);
+static bool isr_rx_anomaly_check(const struct lll_sync_iso *lll,
+				 struct lll_sync_iso_anomaly *anomaly,
+				 const struct pdu_bis *pdu,
+				 const struct node_rx_pdu *node_rx_prev,
+				 uint8_t rssi_ready);
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
 
 /* FIXME: Optimize by moving to a common place, as similar variable is used for
  *        connections too.
@@ -72,6 +81,13 @@ static void isr_rx_ctrl_recv(struct lll_sync_iso *lll, struct pdu_bis *pdu);
 static uint8_t trx_cnt;
 static uint8_t crc_ok_anchor;
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+/* Expected start of the current subevent PDU, zero when the BIG event anchor
+ * point has not been synchronized yet.
+ */
+static uint32_t se_expected_us;
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 int lll_sync_iso_init(void)
 {
 	int err;
@@ -219,6 +235,10 @@ static int prepare_cb_common(struct lll_prepare_param *p)
 	/* Initialize anchor point CRC ok flag */
 	crc_ok_anchor = 0U;
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+	se_expected_us = 0U;
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 	/* Initialize to mandatory parameter values */
 	lll->bis_curr = 1U;
 	lll->ptc_curr = 0U;
@@ -324,8 +344,8 @@ static int prepare_cb_common(struct lll_prepare_param *p)
 		payload_count = lll->payload_count - lll->bn;
 		lll->ccm_rx.counter = payload_count;
 
-		(void)memcpy(lll->ccm_rx.iv, lll->giv, 4U);
-		mem_xor_32(lll->ccm_rx.iv, lll->ccm_rx.iv, access_addr);
+		/* First selected stream */
+		(void)memcpy(lll->ccm_rx.iv, lll->bis_iv[lll->stream_curr + 1U], 4U);
 
 		pkt_flags = RADIO_PKT_CONF_FLAGS(RADIO_PKT_CONF_PDU_TYPE_BIS,
 						 phy,
@@ -686,6 +706,16 @@ static void isr_rx(void *param)
 				isr_rx_ctrl_recv(lll, pdu);
 			}
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+			/* Data PDU in the Control subevent, counted for the BIG
+			 * as the Control subevent does not belong to a BIS.
+			 */
+			if ((pdu->ll_id != PDU_BIS_LLID_CTRL) &&
+			    isr_rx_anomaly_mic_is_valid(lll, pdu)) {
+				lll->anomaly_ctrl_cnt++;
+			}
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 			goto isr_rx_done;
 		}
 
@@ -728,6 +758,20 @@ static void isr_rx(void *param)
 		stream_handle = lll->stream_handle[stream_curr];
 		sync_stream = ull_sync_iso_lll_stream_get(stream_handle);
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+		/* Drop PDUs that are not valid in this subevent before they
+		 * reach ISOAL. PDUs failing the MIC check are not counted, and
+		 * are handled as without anomaly detection.
+		 */
+		if ((lll->bis_curr == sync_stream->bis_index) &&
+		    isr_rx_anomaly_mic_is_valid(lll, pdu) &&
+		    !isr_rx_anomaly_check(lll, &sync_stream->anomaly, pdu,
+					  lll->payload[stream_curr][payload_index],
+					  rssi_ready)) {
+			goto isr_rx_done;
+		}
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 		/* Store the received PDU if selected stream and not already
 		 * received (say in previous event as pre-transmitted PDU.
 		 */
@@ -1251,8 +1295,9 @@ isr_rx_next_subevent:
 
 		lll->ccm_rx.counter = payload_count;
 
-		(void)memcpy(lll->ccm_rx.iv, lll->giv, 4U);
-		mem_xor_32(lll->ccm_rx.iv, lll->ccm_rx.iv, access_addr);
+		/* A BIS subevent is always of the current selected stream */
+		(void)memcpy(lll->ccm_rx.iv,
+			     lll->bis_iv[bis ? (lll->stream_curr + 1U) : 0U], 4U);
 
 		radio_pkt_rx_set(radio_ccm_iso_rx_pkt_set(&lll->ccm_rx, lll->phy,
 							  RADIO_PKT_CONF_PDU_TYPE_BIS,
@@ -1281,6 +1326,11 @@ isr_rx_next_subevent:
 
 	radio_switch_complete_and_disable();
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+	/* RSSI of each subevent PDU */
+	radio_rssi_measure();
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 	/* Setup Access Address capture for subsequent subevent if there has been no anchor point
 	 * sync previously.
 	 */
@@ -1364,6 +1414,10 @@ isr_rx_next_subevent:
 		hcto = radio_tmr_start_us(0U, start_us);
 		LL_ASSERT_ERR(hcto == (start_us + 1U));
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+		se_expected_us = start_us + jitter_us;
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 		/* Add 8 us * subevents so far, as radio was setup to listen
 		 * 4 us early and subevents could have a 4 us drift each until
 		 * the current subevent we are listening.
@@ -1841,3 +1895,106 @@ static void isr_rx_ctrl_recv(struct lll_sync_iso *lll, struct pdu_bis *pdu)
 		/* Unknown control PDU, ignore */
 	}
 }
+
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+/* Update a running average, in 1/16 units with a weight of 1/8 for the new
+ * sample, and return the deviation of the sample from the previous average.
+ */
+static uint32_t anomaly_avg_update(int16_t *avg, uint8_t *init, int32_t sample)
+{
+	int32_t delta;
+
+	/* Keep the average within its 16-bit range */
+	sample = CLAMP(sample, -2047, 2047) << 4;
+
+	if (!*init) {
+		*avg = sample;
+		*init = 1U;
+
+		return 0U;
+	}
+
+	delta = sample - *avg;
+	*avg += delta / 8;
+
+	return (delta < 0) ? ((-delta) >> 4) : (delta >> 4);
+}
+
+/* Only authenticated PDUs of an encrypted BIG update the counters, so that an
+ * injected PDU can not be used to skew the running averages.
+ */
+static bool isr_rx_anomaly_mic_is_valid(const struct lll_sync_iso *lll,
+					const struct pdu_bis *pdu)
+{
+	if (!IS_ENABLED(CONFIG_BT_CTLR_BROADCAST_ISO_ENC) || !lll->enc ||
+	    !pdu->len) {
+		return true;
+	}
+
+	return radio_ccm_is_done() && radio_ccm_mic_is_valid();
+}
+
+static bool isr_rx_anomaly_check(const struct lll_sync_iso *lll,
+				 struct lll_sync_iso_anomaly *anomaly,
+				 const struct pdu_bis *pdu,
+				 const struct node_rx_pdu *node_rx_prev,
+				 uint8_t rssi_ready)
+{
+	anomaly->rx_cnt++;
+
+	/* Only unframed or only framed Data PDUs, within the BIG Max_PDU, are
+	 * valid in a BIS subevent.
+	 */
+	if ((pdu->len > lll->max_pdu) || (pdu->ll_id == PDU_BIS_LLID_CTRL) ||
+	    ((pdu->ll_id == PDU_BIS_LLID_FRAMED) != lll->framing)) {
+		anomaly->unexpected_cnt++;
+
+		return false;
+	}
+
+	/* Repetition of an already received payload, compare the header and
+	 * the first and last octets of the payload.
+	 */
+	if (node_rx_prev) {
+		const struct pdu_bis *pdu_prev = (void *)node_rx_prev->pdu;
+
+		if ((pdu_prev->ll_id != pdu->ll_id) ||
+		    (pdu_prev->len != pdu->len) ||
+		    (pdu->len &&
+		     ((pdu_prev->payload[0] != pdu->payload[0]) ||
+		      (pdu_prev->payload[pdu->len - 1U] !=
+		       pdu->payload[pdu->len - 1U])))) {
+			anomaly->dup_cnt++;
+		}
+	}
+
+	if (rssi_ready) {
+		uint32_t delta;
+
+		delta = anomaly_avg_update(&anomaly->rssi_avg,
+					   &anomaly->rssi_init,
+					   radio_rssi_get());
+		if (delta > CONFIG_BT_CTLR_SYNC_ISO_ANOMALY_RSSI_DB) {
+			anomaly->rssi_cnt++;
+		}
+	}
+
+	if (se_expected_us) {
+		uint32_t pdu_us;
+		uint32_t delta;
+
+		/* Offset of the PDU start to the expected subevent start */
+		pdu_us = PDU_BIS_US(pdu->len, (lll->enc && pdu->len), lll->phy,
+				    PHY_FLAGS_S8);
+		delta = anomaly_avg_update(&anomaly->offset_avg,
+					   &anomaly->offset_init,
+					   radio_tmr_end_get() - pdu_us -
+					   se_expected_us);
+		if (delta > CONFIG_BT_CTLR_SYNC_ISO_ANOMALY_OFFSET_US) {
+			anomaly->offset_cnt++;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
@@ -616,6 +616,19 @@ static uint8_t big_create(uint8_t big_handle, uint8_t adv_handle, uint8_t num_bi
 		(void)memcpy(&ccm_tx->iv[4], &lll_adv_iso->giv[4], 4U);
 		(void)mem_rcopy(ccm_tx->key, gsk, sizeof(ccm_tx->key));
 
+		/* Prepare the IV of the BIG Control PDUs and of each BIS, GIV
+		 * octets 0-3 XOR'ed with their Access Address, so that LLL
+		 * only copies it for each PDU.
+		 */
+		for (uint8_t bis = 0U; bis <= lll_adv_iso->num_bis; bis++) {
+			uint8_t access_addr[4];
+
+			util_bis_aa_le32(bis, lll_adv_iso->seed_access_addr,
+					 access_addr);
+			mem_xor_32(lll_adv_iso->bis_iv[bis], lll_adv_iso->giv,
+				   access_addr);
+		}
+
 		/* NOTE: counter is filled in LLL */
 
 		lll_adv_iso->enc = 1U;
@@ -194,6 +194,9 @@ uint8_t ll_big_sync_create(uint8_t big_handle, uint16_t sync_handle,
 	lll->cssn_curr = 0U;
 	lll->cssn_next = 0U;
 	lll->term_reason = 0U;
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+	lll->anomaly_ctrl_cnt = 0U;
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
 
 	if (IS_ENABLED(CONFIG_BT_CTLR_BROADCAST_ISO_ENC) && encryption) {
 		const uint8_t BIG1[16] = {0x31, 0x47, 0x49, 0x42, };
@@ -225,6 +228,9 @@ uint8_t ll_big_sync_create(uint8_t big_handle, uint16_t sync_handle,
 		stream->dp = NULL;
 		stream->test_mode = &test_mode[i];
 		memset(stream->test_mode, 0, sizeof(struct ll_iso_rx_test_mode));
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+		memset(&stream->anomaly, 0, sizeof(stream->anomaly));
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
 		lll->stream_handle[i] = sync_iso_stream_handle_get(stream);
 	}
 
@@ -323,6 +329,52 @@ uint8_t ll_big_sync_terminate(uint8_t big_handle, void **rx)
 	return BT_HCI_ERR_SUCCESS;
 }
 
+#if defined(CONFIG_BT_CTLR_SYNC_ISO_ANOMALY)
+uint8_t ll_big_sync_anomaly_get(uint16_t handle, uint32_t *rx_packets,
+				uint32_t *rssi_outliers,
+				uint32_t *timing_outliers,
+				uint32_t *duplicate_mismatches,
+				uint32_t *unexpected_packets,
+				uint32_t *ctrl_unexpected_packets,
+				int8_t *rssi_avg)
+{
+	const struct lll_sync_iso_anomaly *anomaly;
+	struct lll_sync_iso_stream *stream;
+	struct ll_sync_iso_set *sync_iso;
+
+	if (!IS_SYNC_ISO_HANDLE(handle)) {
+		return BT_HCI_ERR_UNKNOWN_CONN_ID;
+	}
+
+	stream = ull_sync_iso_stream_get(LL_BIS_SYNC_IDX_FROM_HANDLE(handle));
+	if (!stream) {
+		return BT_HCI_ERR_UNKNOWN_CONN_ID;
+	}
+
+	sync_iso = ull_sync_iso_by_stream_get(LL_BIS_SYNC_IDX_FROM_HANDLE(handle));
+
+	/* NOTE: Counters are updated in LLL context, each of them is read
+	 *       atomically but they are not a snapshot of the same instant.
+	 */
+	anomaly = &stream->anomaly;
+	*rx_packets = anomaly->rx_cnt;
+	*rssi_outliers = anomaly->rssi_cnt;
+	*timing_outliers = anomaly->offset_cnt;
+	*duplicate_mismatches = anomaly->dup_cnt;
+	*unexpected_packets = anomaly->unexpected_cnt;
+	*ctrl_unexpected_packets = sync_iso->lll.anomaly_ctrl_cnt;
+
+	/* Average is the magnitude of the RSSI in 1/16 dB */
+	if (anomaly->rssi_init) {
+		*rssi_avg = -(int8_t)(anomaly->rssi_avg >> 4);
+	} else {
+		*rssi_avg = BT_HCI_LE_RSSI_NOT_AVAILABLE;
+	}
+
+	return BT_HCI_ERR_SUCCESS;
+}
+#endif /* CONFIG_BT_CTLR_SYNC_ISO_ANOMALY */
+
 int ull_sync_iso_init(void)
 {
 	int err;
@@ -543,6 +595,27 @@ void ull_sync_iso_setup(struct ll_sync_iso_set *sync_iso,
 		(void)memcpy(&ccm_rx->iv[4], &lll->giv[4], 4U);
 		(void)mem_rcopy(ccm_rx->key, gsk, sizeof(ccm_rx->key));
 
+		/* Prepare the IV of the BIG Control PDUs and of each selected
+		 * stream, GIV octets 0-3 XOR'ed with their Access Address, so
+		 * that LLL only copies it for each PDU.
+		 */
+		for (uint8_t i = 0U; i <= lll->stream_count; i++) {
+			uint8_t access_addr[4];
+			uint8_t bis;
+
+			if (i) {
+				struct lll_sync_iso_stream *stream;
+
+				stream = ull_sync_iso_stream_get(lll->stream_handle[i - 1U]);
+				bis = stream->bis_index;
+			} else {
+				bis = 0U;
+			}
+
+			util_bis_aa_le32(bis, lll->seed_access_addr, access_addr);
+			mem_xor_32(lll->bis_iv[i], lll->giv, access_addr);
+		}
+
 		/* NOTE: counter is filled in LLL */
 	} else {
 		lll->enc = 0U;
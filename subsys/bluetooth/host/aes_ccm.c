@@ -6,6 +6,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -15,11 +16,83 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/byteorder.h>
 
+#if defined(CONFIG_BT_HOST_CRYPTO)
+#include <psa/crypto.h>
+#endif
+
 #include "common/bt_str.h"
 
 #define LOG_LEVEL CONFIG_BT_HCI_CORE_LOG_LEVEL
 LOG_MODULE_REGISTER(bt_aes_ccm);
 
+/* AES-128 block encryption, with the key set up once per message */
+struct ccm_aes {
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	psa_key_id_t key_id;
+#else
+	const uint8_t *key;
+#endif
+};
+
+static int ccm_aes_init(struct ccm_aes *aes, const uint8_t key[16])
+{
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+	psa_status_t status;
+
+	psa_set_key_type(&attr, PSA_KEY_TYPE_AES);
+	psa_set_key_bits(&attr, 128);
+	psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_ENCRYPT);
+	psa_set_key_algorithm(&attr, PSA_ALG_ECB_NO_PADDING);
+	status = psa_import_key(&attr, key, 16, &aes->key_id);
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("Failed to import AES key %d", status);
+		return -EIO;
+	}
+#else
+	aes->key = key;
+#endif
+
+	return 0;
+}
+
+static int ccm_aes_encrypt(const struct ccm_aes *aes, const uint8_t in[16], uint8_t out[16])
+{
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	psa_status_t status;
+	size_t out_len;
+
+	status = psa_cipher_encrypt(aes->key_id, PSA_ALG_ECB_NO_PADDING, in, 16, out, 16,
+				    &out_len);
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("AES encryption failed %d", status);
+		return -EIO;
+	}
+#else
+	int err;
+
+	err = bt_encrypt_be(aes->key, in, out);
+	if (err) {
+		LOG_ERR("AES encryption failed %d", err);
+		return -EIO;
+	}
+#endif
+
+	return 0;
+}
+
+static void ccm_aes_deinit(struct ccm_aes *aes)
+{
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	psa_status_t status;
+
+	status = psa_destroy_key(aes->key_id);
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("Failed to destroy AES key %d", status);
+	}
+#endif
+}
+
 static inline void xor16(uint8_t *dst, const uint8_t *a, const uint8_t *b)
 {
 	dst[0] = a[0] ^ b[0];
@@ -41,7 +114,7 @@ static inline void xor16(uint8_t *dst, const uint8_t *a, const uint8_t *b)
 }
 
 /* b field is assumed to have the nonce already present in bytes 1-13 */
-static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t aad_len,
+static int ccm_calculate_X0(const struct ccm_aes *aes, const uint8_t *aad, uint8_t aad_len,
 			    size_t mic_size, uint16_t msg_len, uint8_t b[16],
 			    uint8_t X0[16])
 {
@@ -52,7 +125,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 
 	sys_put_be16(msg_len, b + 14);
 
-	err = bt_encrypt_be(key, b, X0);
+	err = ccm_aes_encrypt(aes, b, X0);
 	if (err) {
 		return err;
 	}
@@ -76,7 +149,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 			aad_len -= 16;
 			i = 0;
 
-			err = bt_encrypt_be(key, b, X0);
+			err = ccm_aes_encrypt(aes, b, X0);
 			if (err) {
 				return err;
 			}
@@ -90,7 +163,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 			b[i] = X0[i];
 		}
 
-		err = bt_encrypt_be(key, b, X0);
+		err = ccm_aes_encrypt(aes, b, X0);
 		if (err) {
 			return err;
 		}
@@ -99,7 +172,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 	return 0;
 }
 
-static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
+static int ccm_auth(const struct ccm_aes *aes, const uint8_t nonce[13],
 		    const uint8_t *cleartext_msg, uint16_t msg_len, const uint8_t *aad,
 		    size_t aad_len, uint8_t *mic, size_t mic_size)
 {
@@ -119,12 +192,15 @@ static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
 	/* S[0] = e(AppKey, 0x01 || nonce || 0x0000) */
 	sys_put_be16(0x0000, &b[14]);
 
-	err = bt_encrypt_be(key, b, s0);
+	err = ccm_aes_encrypt(aes, b, s0);
 	if (err) {
 		return err;
 	}
 
-	ccm_calculate_X0(key, aad, aad_len, mic_size, msg_len, b, Xn);
+	err = ccm_calculate_X0(aes, aad, aad_len, mic_size, msg_len, b, Xn);
+	if (err) {
+		return err;
+	}
 
 	for (j = 0; j < blk_cnt; j++) {
 		/* X_1 = e(AppKey, X_0 ^ Payload[0-15]) */
@@ -138,7 +214,7 @@ static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
 			xor16(b, Xn, &cleartext_msg[j * 16]);
 		}
 
-		err = bt_encrypt_be(key, b, Xn);
+		err = ccm_aes_encrypt(aes, b, Xn);
 		if (err) {
 			return err;
 		}
@@ -152,7 +228,7 @@ static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
 	return 0;
 }
 
-static int ccm_crypt(const uint8_t key[16], const uint8_t nonce[13],
+static int ccm_crypt(const struct ccm_aes *aes, const uint8_t nonce[13],
 		     const uint8_t *in_msg, uint8_t *out_msg, uint16_t msg_len)
 {
 	uint8_t a_i[16], s_i[16];
@@ -173,7 +249,7 @@ static int ccm_crypt(const uint8_t key[16], const uint8_t nonce[13],
 		/* S_1 = e(AppKey, 0x01 || nonce || 0x0001) */
 		sys_put_be16(j + 1, &a_i[14]);
 
-		err = bt_encrypt_be(key, a_i, s_i);
+		err = ccm_aes_encrypt(aes, a_i, s_i);
 		if (err) {
 			return err;
 		}
@@ -191,19 +267,133 @@ static int ccm_crypt(const uint8_t key[16], const uint8_t nonce[13],
 	return 0;
 }
 
+#if defined(CONFIG_BT_HOST_CCM_PSA)
+/* MIC sizes supported by the CCM algorithm of the PSA Crypto API */
+static bool ccm_psa_mic_size_valid(size_t mic_size)
+{
+	return (mic_size >= 4U) && (mic_size <= 16U) && !(mic_size & 1U);
+}
+
+static int ccm_psa_key_import(const uint8_t key[16], psa_key_usage_t usage,
+			      psa_algorithm_t alg, psa_key_id_t *key_id)
+{
+	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+	psa_status_t status;
+
+	psa_set_key_type(&attr, PSA_KEY_TYPE_AES);
+	psa_set_key_bits(&attr, 128);
+	psa_set_key_usage_flags(&attr, usage);
+	psa_set_key_algorithm(&attr, alg);
+	status = psa_import_key(&attr, key, 16, key_id);
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("Failed to import AES key %d", status);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int ccm_psa_decrypt(const uint8_t key[16], const uint8_t nonce[13],
+			   const uint8_t *enc_data, size_t len, const uint8_t *aad,
+			   size_t aad_len, uint8_t *plaintext, size_t mic_size)
+{
+	psa_algorithm_t alg = PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, mic_size);
+	psa_status_t status, destroy_status;
+	psa_key_id_t key_id;
+	size_t out_len;
+	int err;
+
+	err = ccm_psa_key_import(key, PSA_KEY_USAGE_DECRYPT, alg, &key_id);
+	if (err) {
+		return err;
+	}
+
+	status = psa_aead_decrypt(key_id, alg, nonce, 13, aad, aad_len, enc_data,
+				  len + mic_size, plaintext, len, &out_len);
+
+	destroy_status = psa_destroy_key(key_id);
+	if (destroy_status != PSA_SUCCESS) {
+		LOG_ERR("Failed to destroy AES key %d", destroy_status);
+	}
+
+	if (status == PSA_ERROR_INVALID_SIGNATURE) {
+		return -EBADMSG;
+	}
+
+	if ((status != PSA_SUCCESS) || (destroy_status != PSA_SUCCESS)) {
+		LOG_ERR("AES-CCM decryption failed %d", status);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int ccm_psa_encrypt(const uint8_t key[16], const uint8_t nonce[13],
+			   const uint8_t *plaintext, size_t len, const uint8_t *aad,
+			   size_t aad_len, uint8_t *enc_data, size_t mic_size)
+{
+	psa_algorithm_t alg = PSA_ALG_AEAD_WITH_SHORTENED_TAG(PSA_ALG_CCM, mic_size);
+	psa_status_t status, destroy_status;
+	psa_key_id_t key_id;
+	size_t out_len;
+	int err;
+
+	err = ccm_psa_key_import(key, PSA_KEY_USAGE_ENCRYPT, alg, &key_id);
+	if (err) {
+		return err;
+	}
+
+	status = psa_aead_encrypt(key_id, alg, nonce, 13, aad, aad_len, plaintext, len,
+				  enc_data, len + mic_size, &out_len);
+
+	destroy_status = psa_destroy_key(key_id);
+	if (destroy_status != PSA_SUCCESS) {
+		LOG_ERR("Failed to destroy AES key %d", destroy_status);
+	}
+
+	if ((status != PSA_SUCCESS) || (destroy_status != PSA_SUCCESS)) {
+		LOG_ERR("AES-CCM encryption failed %d", status);
+		return -EIO;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_BT_HOST_CCM_PSA */
+
 int bt_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
 		   const uint8_t *enc_data, size_t len, const uint8_t *aad,
 		   size_t aad_len, uint8_t *plaintext, size_t mic_size)
 {
+	struct ccm_aes aes;
 	uint8_t mic[16];
+	int err;
 
 	if (aad_len >= 0xff00 || mic_size > sizeof(mic) || len > UINT16_MAX) {
 		return -EINVAL;
 	}
 
-	ccm_crypt(key, nonce, enc_data, plaintext, len);
+#if defined(CONFIG_BT_HOST_CCM_PSA)
+	if (ccm_psa_mic_size_valid(mic_size)) {
+		return ccm_psa_decrypt(key, nonce, enc_data, len, aad, aad_len, plaintext,
+				       mic_size);
+	}
+#endif /* CONFIG_BT_HOST_CCM_PSA */
 
-	ccm_auth(key, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+	err = ccm_aes_init(&aes, key);
+	if (err) {
+		return err;
+	}
+
+	err = ccm_crypt(&aes, nonce, enc_data, plaintext, len);
+	if (!err) {
+		err = ccm_auth(&aes, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+	}
+
+	ccm_aes_deinit(&aes);
+
+	if (err) {
+		return err;
+	}
 
 	if (memcmp(mic, enc_data + len, mic_size)) {
 		return -EBADMSG;
@@ -217,6 +407,8 @@ int bt_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
 		   size_t aad_len, uint8_t *enc_data, size_t mic_size)
 {
 	uint8_t *mic = enc_data + len;
+	struct ccm_aes aes;
+	int err;
 
 	LOG_DBG("key %s", bt_hex(key, 16));
 	LOG_DBG("nonce %s", bt_hex(nonce, 13));
@@ -228,9 +420,24 @@ int bt_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
 		return -EINVAL;
 	}
 
-	ccm_auth(key, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+#if defined(CONFIG_BT_HOST_CCM_PSA)
+	if (ccm_psa_mic_size_valid(mic_size)) {
+		return ccm_psa_encrypt(key, nonce, plaintext, len, aad, aad_len, enc_data,
+				       mic_size);
+	}
+#endif /* CONFIG_BT_HOST_CCM_PSA */
 
-	ccm_crypt(key, nonce, plaintext, enc_data, len);
+	err = ccm_aes_init(&aes, key);
+	if (err) {
+		return err;
+	}
 
-	return 0;
+	err = ccm_auth(&aes, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+	if (!err) {
+		err = ccm_crypt(&aes, nonce, plaintext, enc_data, len);
+	}
+
+	ccm_aes_deinit(&aes);
+
+	return err;
 }
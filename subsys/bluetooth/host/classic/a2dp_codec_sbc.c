@@ -12,9 +12,19 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/printk.h>
 
+#include <zephyr/net_buf.h>
+
 #include <zephyr/bluetooth/classic/a2dp_codec_sbc.h>
 #include <zephyr/bluetooth/classic/a2dp.h>
+#if defined(CONFIG_LIBSBC)
+#include <zephyr/bluetooth/sbc.h>
+#endif
+
+#include "avdtp_internal.h"
 
+/* SBC media payload header, with a 4 bits Number of Frames field */
+#define A2DP_SBC_MEDIA_HDR_SIZE   (1U)
+#define A2DP_SBC_MEDIA_FRAMES_MAX (15U)
 
 uint8_t bt_a2dp_sbc_get_channel_num(struct bt_a2dp_codec_sbc_params *sbc_codec)
 {
@@ -49,3 +59,111 @@ uint32_t bt_a2dp_sbc_get_sampling_frequency(struct bt_a2dp_codec_sbc_params *sbc
 		return 0U;
 	}
 }
+
+#if defined(CONFIG_BT_A2DP_SOURCE) && defined(CONFIG_LIBSBC)
+int bt_a2dp_stream_sbc_frames_max(struct bt_a2dp_stream *stream, struct sbc_encoder *encoder)
+{
+	uint32_t mtu;
+	int frame_len;
+
+	if ((stream == NULL) || (stream->local_ep == NULL) || (encoder == NULL)) {
+		return -EINVAL;
+	}
+
+	frame_len = sbc_frame_encoded_bytes(encoder);
+	if (frame_len <= 0) {
+		return -EINVAL;
+	}
+
+	mtu = bt_a2dp_get_mtu(stream);
+	if (mtu < (sizeof(struct bt_avdtp_media_hdr) + A2DP_SBC_MEDIA_HDR_SIZE + frame_len)) {
+		return -EMSGSIZE;
+	}
+
+	mtu -= sizeof(struct bt_avdtp_media_hdr) + A2DP_SBC_MEDIA_HDR_SIZE;
+
+	return MIN(mtu / frame_len, A2DP_SBC_MEDIA_FRAMES_MAX);
+}
+
+int bt_a2dp_stream_sbc_encode(struct bt_a2dp_stream *stream, struct sbc_encoder *encoder,
+			      struct net_buf *buf, uint8_t frames_max, const void *pcm,
+			      size_t pcm_len)
+{
+	const uint8_t *in = pcm;
+	size_t pcm_frame_len;
+	size_t frame_len;
+	size_t max_len;
+	uint8_t *sbc_hdr;
+	uint8_t frames;
+	int ret;
+
+	if ((stream == NULL) || (stream->local_ep == NULL) || (encoder == NULL) ||
+	    (buf == NULL) || (pcm == NULL) || (frames_max > A2DP_SBC_MEDIA_FRAMES_MAX)) {
+		return -EINVAL;
+	}
+
+	if (stream->local_ep->codec_type != BT_A2DP_SBC) {
+		return -ENOTSUP;
+	}
+
+	/* The buf starts with the AVDTP media header, see bt_a2dp_stream_create_pdu() */
+	if (buf->len < sizeof(struct bt_avdtp_media_hdr)) {
+		return -EINVAL;
+	}
+
+	ret = sbc_frame_encoded_bytes(encoder);
+	if (ret <= 0) {
+		return -EINVAL;
+	}
+	frame_len = ret;
+
+	ret = sbc_frame_bytes(encoder);
+	if (ret <= 0) {
+		return -EINVAL;
+	}
+	pcm_frame_len = ret;
+
+	if (frames_max == 0U) {
+		frames_max = A2DP_SBC_MEDIA_FRAMES_MAX;
+	}
+
+	if (buf->len == sizeof(struct bt_avdtp_media_hdr)) {
+		if (net_buf_tailroom(buf) < A2DP_SBC_MEDIA_HDR_SIZE) {
+			return -ENOMEM;
+		}
+
+		net_buf_add_u8(buf, 0U);
+	}
+
+	sbc_hdr = &buf->data[sizeof(struct bt_avdtp_media_hdr)];
+	frames = BT_A2DP_SBC_MEDIA_HDR_NUM_FRAMES_GET(*sbc_hdr);
+	max_len = MIN(bt_a2dp_get_mtu(stream), buf->len + net_buf_tailroom(buf));
+
+	ret = 0;
+
+	/* Encode in place, no intermediate frame buffer */
+	while ((pcm_len >= pcm_frame_len) && (frames < frames_max) &&
+	       ((buf->len + frame_len) <= max_len)) {
+		uint32_t len;
+
+		len = sbc_encode(encoder, in, net_buf_tail(buf));
+		if (len == 0U) {
+			ret = -EIO;
+			break;
+		}
+
+		net_buf_add(buf, len);
+		in += pcm_frame_len;
+		pcm_len -= pcm_frame_len;
+		frames++;
+	}
+
+	BT_A2DP_SBC_MEDIA_HDR_NUM_FRAMES_SET(*sbc_hdr, frames);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	return in - (const uint8_t *)pcm;
+}
+#endif /* CONFIG_BT_A2DP_SOURCE && CONFIG_LIBSBC */
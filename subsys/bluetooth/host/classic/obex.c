@@ -2759,6 +2759,58 @@ int bt_obex_add_header_end_body(struct net_buf *buf, uint16_t len, const uint8_t
 	return 0;
 }
 
+int bt_obex_add_header_body_stream(struct net_buf *buf, uint16_t mopl, bt_obex_body_cb_t cb,
+				   void *user_data, uint16_t *added_len, bool *last)
+{
+	uint8_t *hdr;
+	uint16_t tx_len;
+	int len;
+
+	if (!buf || !cb || !added_len || !last || (mopl < BT_OBEX_MIN_MTU)) {
+		LOG_WRN("Invalid parameter");
+		return -EINVAL;
+	}
+
+	*added_len = 0;
+	*last = false;
+
+	tx_len = BT_OBEX_PDU_LEN(mopl);
+	if (tx_len <= buf->len) {
+		return -ENOMEM;
+	}
+
+	tx_len = MIN((tx_len - buf->len), net_buf_tailroom(buf));
+	if (tx_len <= BT_OBEX_HDR_LEN_OF_HEADER_BODY) {
+		return 0;
+	}
+
+	tx_len = BT_OBEX_DATA_LEN_OF_HEADER_BODY(tx_len);
+
+	/* Reserve the header, the body is written right behind it */
+	hdr = net_buf_add(buf, BT_OBEX_HDR_LEN_OF_HEADER_BODY);
+
+	len = cb(net_buf_tail(buf), tx_len, last, user_data);
+	if ((len < 0) || (len > tx_len) || ((len == 0) && !*last)) {
+		net_buf_remove_mem(buf, BT_OBEX_HDR_LEN_OF_HEADER_BODY);
+		*last = false;
+
+		if (len > tx_len) {
+			LOG_WRN("Body chunk too long (%d > %u)", len, tx_len);
+			return -EINVAL;
+		}
+
+		return MIN(len, 0);
+	}
+
+	net_buf_add(buf, len);
+
+	hdr[0] = *last ? BT_OBEX_HEADER_ID_END_BODY : BT_OBEX_HEADER_ID_BODY;
+	sys_put_be16(BT_OBEX_HDR_LEN_OF_HEADER_BODY + len, &hdr[1]);
+
+	*added_len = (uint16_t)len;
+	return 0;
+}
+
 int bt_obex_add_header_who(struct net_buf *buf, uint16_t len, const uint8_t *who)
 {
 	size_t total;
@@ -268,6 +268,63 @@ static void rfcomm_dlc_tx_give_credits(struct bt_rfcomm_dlc *dlc,
 	LOG_DBG("dlc %p updated credits %u", dlc, k_sem_count_get(&dlc->tx_credits));
 }
 
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+BUILD_ASSERT(CONFIG_BT_RFCOMM_DLC_RX_HOLD_MAX < RFCOMM_MAX_CREDITS,
+	     "CONFIG_BT_RFCOMM_DLC_RX_HOLD_MAX must be lower than the maximum number of "
+	     "RFCOMM credits (ACL RX buffer count - 1)");
+
+/* Track a received buffer the application kept a reference to */
+static void rfcomm_dlc_rx_hold(struct bt_rfcomm_dlc *dlc, struct net_buf *buf)
+{
+	if (buf->ref == 1U) {
+		return;
+	}
+
+	ARRAY_FOR_EACH(dlc->rx_held, i) {
+		if (dlc->rx_held[i] == NULL) {
+			dlc->rx_held[i] = net_buf_ref(buf);
+			return;
+		}
+	}
+
+	LOG_WRN("dlc %p holds more than %u RX buffers", dlc, CONFIG_BT_RFCOMM_DLC_RX_HOLD_MAX);
+}
+
+/* Number of received buffers still held by the application. A buffer only
+ * referenced by the DLC itself has been released and is dropped.
+ */
+static uint8_t rfcomm_dlc_rx_held(struct bt_rfcomm_dlc *dlc)
+{
+	uint8_t held = 0U;
+
+	ARRAY_FOR_EACH(dlc->rx_held, i) {
+		if (dlc->rx_held[i] == NULL) {
+			continue;
+		}
+
+		if (dlc->rx_held[i]->ref == 1U) {
+			net_buf_unref(dlc->rx_held[i]);
+			dlc->rx_held[i] = NULL;
+			continue;
+		}
+
+		held++;
+	}
+
+	return held;
+}
+
+static void rfcomm_dlc_rx_release(struct bt_rfcomm_dlc *dlc)
+{
+	ARRAY_FOR_EACH(dlc->rx_held, i) {
+		if (dlc->rx_held[i] != NULL) {
+			net_buf_unref(dlc->rx_held[i]);
+			dlc->rx_held[i] = NULL;
+		}
+	}
+}
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
+
 static void rfcomm_dlc_destroy(struct bt_rfcomm_dlc *dlc)
 {
 	LOG_DBG("dlc %p", dlc);
@@ -278,6 +335,10 @@ static void rfcomm_dlc_destroy(struct bt_rfcomm_dlc *dlc)
 	dlc->state = BT_RFCOMM_STATE_IDLE;
 	dlc->session = NULL;
 
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+	rfcomm_dlc_rx_release(dlc);
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
+
 	if (dlc->ops && dlc->ops->disconnected) {
 		dlc->ops->disconnected(dlc);
 	}
@@ -493,6 +554,9 @@ static void rfcomm_dlc_init(struct bt_rfcomm_dlc *dlc,
 	dlc->dlci = dlci;
 	dlc->session = session;
 	dlc->rx_credit = RFCOMM_DEFAULT_CREDIT;
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+	memset(dlc->rx_held, 0, sizeof(dlc->rx_held));
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
 	dlc->state = BT_RFCOMM_STATE_INIT;
 	dlc->role = role;
 	k_work_init_delayable(&dlc->rtx_work, rfcomm_dlc_rtx_timeout);
@@ -628,6 +692,7 @@ static void rfcomm_sent(struct bt_conn *conn, void *user_data, int err)
 static void rfcomm_dlc_tx_worker(struct k_work *work)
 {
 	struct bt_rfcomm_dlc *dlc = CONTAINER_OF(work, struct bt_rfcomm_dlc, tx_work);
+	uint8_t batch = CONFIG_BT_RFCOMM_TX_MAX;
 	struct net_buf *buf;
 
 	LOG_DBG("Work for dlc %p state %u", dlc, dlc->state);
@@ -638,23 +703,28 @@ static void rfcomm_dlc_tx_worker(struct k_work *work)
 
 	if (dlc->state == BT_RFCOMM_STATE_CONNECTED ||
 	    dlc->state == BT_RFCOMM_STATE_USER_DISCONNECT) {
-		if (k_fifo_is_empty(&dlc->tx_queue) == true) {
-			goto user_disconnect;
-		}
+		/* Send as many queued frames as the credits allow in one run,
+		 * up to a batch limit so that other DLCs get their turn.
+		 */
+		while (batch--) {
+			if (k_fifo_is_empty(&dlc->tx_queue) == true) {
+				goto user_disconnect;
+			}
 
-		if (rfcomm_check_fc(dlc) == false) {
-			LOG_DBG("FC or credit not available");
-			goto user_disconnect;
-		}
+			if (rfcomm_check_fc(dlc) == false) {
+				LOG_DBG("FC or credit not available");
+				goto user_disconnect;
+			}
 
-		buf = k_fifo_get(&dlc->tx_queue, K_NO_WAIT);
-		LOG_DBG("Tx buf %p", buf);
-		if (rfcomm_send_cb(dlc->session, buf, rfcomm_sent, dlc) < 0) {
-			/* This fails only if channel is disconnected */
-			dlc->state = BT_RFCOMM_STATE_DISCONNECTED;
-			bt_rfcomm_tx_destroy(dlc, buf);
-			LOG_ERR("Failed to send buffer, disconnected");
-			goto disconnect;
+			buf = k_fifo_get(&dlc->tx_queue, K_NO_WAIT);
+			LOG_DBG("Tx buf %p", buf);
+			if (rfcomm_send_cb(dlc->session, buf, rfcomm_sent, dlc) < 0) {
+				/* This fails only if channel is disconnected */
+				dlc->state = BT_RFCOMM_STATE_DISCONNECTED;
+				bt_rfcomm_tx_destroy(dlc, buf);
+				LOG_ERR("Failed to send buffer, disconnected");
+				goto disconnect;
+			}
 		}
 
 		if (k_fifo_is_empty(&dlc->tx_queue) == false) {
@@ -1469,6 +1539,7 @@ static void rfcomm_handle_msg(struct bt_rfcomm_session *session,
 static void rfcomm_dlc_update_credits(struct bt_rfcomm_dlc *dlc)
 {
 	uint8_t credits;
+	uint8_t max = RFCOMM_MAX_CREDITS;
 
 	if (dlc->session->cfc == BT_RFCOMM_CFC_NOT_SUPPORTED) {
 		return;
@@ -1481,8 +1552,19 @@ static void rfcomm_dlc_update_credits(struct bt_rfcomm_dlc *dlc)
 		return;
 	}
 
-	/* Restore credits */
-	credits = RFCOMM_MAX_CREDITS - dlc->rx_credit;
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+	/* Each buffer the application holds takes one credit from the DLC,
+	 * the build assert keeps at least one so that the next frame
+	 * triggers another update.
+	 */
+	max -= rfcomm_dlc_rx_held(dlc);
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
+
+	if (max <= dlc->rx_credit) {
+		return;
+	}
+
+	credits = max - dlc->rx_credit;
 	dlc->rx_credit += credits;
 
 	rfcomm_send_credit(dlc, credits);
@@ -1531,6 +1613,10 @@ static void rfcomm_handle_data(struct bt_rfcomm_session *session,
 			dlc->ops->recv(dlc, buf);
 		}
 
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+		rfcomm_dlc_rx_hold(dlc, buf);
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
+
 		dlc->rx_credit--;
 		rfcomm_dlc_update_credits(dlc);
 	}
@@ -75,6 +75,28 @@ static uint8_t num_services;
 
 static struct bt_sdp bt_sdp_pool[CONFIG_BT_MAX_CONN];
 
+#if CONFIG_BT_SDP_UUID_INDEX_SIZE > 0
+/* UUIDs of the registered records, sorted by UUID and record index. UUIDs
+ * are stored in their 32-bit form, 128-bit UUIDs not based on the Bluetooth
+ * Base UUID can't be indexed.
+ */
+struct sdp_uuid_index_entry {
+	uint32_t uuid;
+	uint8_t rec_index;
+};
+
+static struct sdp_uuid_index_entry sdp_uuid_index[CONFIG_BT_SDP_UUID_INDEX_SIZE];
+static uint16_t sdp_uuid_index_count;
+
+/* Records that are not in the index and need to be searched attribute by
+ * attribute, by record index.
+ */
+static ATOMIC_DEFINE(sdp_uuid_unindexed, UINT8_MAX + 1);
+
+static const struct bt_uuid_128 sdp_uuid_base =
+	BT_UUID_INIT_128(BT_UUID_128_ENCODE(0x00000000, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB));
+#endif /* CONFIG_BT_SDP_UUID_INDEX_SIZE > 0 */
+
 /* Pool for outgoing SDP packets */
 NET_BUF_POOL_FIXED_DEFINE(sdp_pool, CONFIG_BT_MAX_CONN, BT_L2CAP_BUF_SIZE(SDP_MTU),
 			  CONFIG_BT_CONN_TX_USER_DATA_SIZE, NULL);
@@ -233,6 +255,137 @@ static struct net_buf *bt_sdp_create_pdu(void)
 	return bt_l2cap_create_pdu(&sdp_pool, sizeof(struct bt_sdp_hdr));
 }
 
+#if CONFIG_BT_SDP_RSP_CACHE_SIZE > 0
+/* Largest request parameters that are used as a cache key */
+#define SDP_RSP_CACHE_REQ_MAX 64
+
+struct sdp_rsp_cache_entry {
+	/* Request the response has been built for */
+	uint8_t req_op;
+	uint16_t req_len;
+	uint8_t req[SDP_RSP_CACHE_REQ_MAX];
+	/* Usable MTU of the channel the response has been built for */
+	uint16_t mtu;
+	/* Response op code and parameters, 0 op code if not valid */
+	uint8_t rsp_op;
+	uint16_t rsp_len;
+	uint8_t rsp[SDP_DATA_MTU];
+	uint32_t last_used;
+};
+
+static struct sdp_rsp_cache_entry sdp_rsp_cache[CONFIG_BT_SDP_RSP_CACHE_SIZE];
+static uint32_t sdp_rsp_cache_age;
+
+/* Entry waiting for the response of the request being handled */
+static struct sdp_rsp_cache_entry *sdp_rsp_cache_pending;
+
+static uint16_t sdp_rsp_cache_mtu(struct bt_sdp *sdp)
+{
+	return MIN(SDP_MTU, sdp->chan.tx.mtu);
+}
+
+static struct sdp_rsp_cache_entry *sdp_rsp_cache_lookup(struct bt_sdp *sdp, uint8_t op,
+							const struct net_buf *buf)
+{
+	ARRAY_FOR_EACH_PTR(sdp_rsp_cache, entry) {
+		if (entry->rsp_op != 0U && entry->req_op == op &&
+		    entry->mtu == sdp_rsp_cache_mtu(sdp) && entry->req_len == buf->len &&
+		    !memcmp(entry->req, buf->data, buf->len)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* @brief Prepare a cache entry for the response to a request
+ *
+ *  Picks an unused or the least recently used entry and fills in the request
+ *  parameters. The entry becomes valid once the response goes through
+ *  bt_sdp_send().
+ *
+ *  @param sdp Pointer to the SDP structure
+ *  @param op Request op code
+ *  @param buf Request parameters
+ *
+ *  @return None
+ */
+static void sdp_rsp_cache_prepare(struct bt_sdp *sdp, uint8_t op, const struct net_buf *buf)
+{
+	struct sdp_rsp_cache_entry *victim = &sdp_rsp_cache[0];
+
+	if (buf->len > SDP_RSP_CACHE_REQ_MAX) {
+		return;
+	}
+
+	ARRAY_FOR_EACH_PTR(sdp_rsp_cache, entry) {
+		if (entry->rsp_op == 0U) {
+			victim = entry;
+			break;
+		}
+
+		if (entry->last_used < victim->last_used) {
+			victim = entry;
+		}
+	}
+
+	victim->rsp_op = 0U;
+	victim->req_op = op;
+	victim->req_len = buf->len;
+	memcpy(victim->req, buf->data, buf->len);
+	victim->mtu = sdp_rsp_cache_mtu(sdp);
+
+	sdp_rsp_cache_pending = victim;
+}
+
+static void sdp_rsp_cache_store(uint8_t op, const struct net_buf *buf)
+{
+	struct sdp_rsp_cache_entry *entry = sdp_rsp_cache_pending;
+
+	sdp_rsp_cache_pending = NULL;
+
+	if (!entry || op == BT_SDP_ERROR_RSP || buf->len > sizeof(entry->rsp)) {
+		return;
+	}
+
+	memcpy(entry->rsp, buf->data, buf->len);
+	entry->rsp_len = buf->len;
+	entry->rsp_op = op;
+	entry->last_used = ++sdp_rsp_cache_age;
+}
+
+static void sdp_rsp_cache_cancel(void)
+{
+	sdp_rsp_cache_pending = NULL;
+}
+
+static void sdp_rsp_cache_clear(void)
+{
+	sdp_rsp_cache_pending = NULL;
+
+	ARRAY_FOR_EACH_PTR(sdp_rsp_cache, entry) {
+		entry->rsp_op = 0U;
+	}
+}
+#else
+static inline void sdp_rsp_cache_prepare(struct bt_sdp *sdp, uint8_t op,
+					 const struct net_buf *buf)
+{
+}
+
+static inline void sdp_rsp_cache_store(uint8_t op, const struct net_buf *buf)
+{
+}
+
+static inline void sdp_rsp_cache_cancel(void)
+{
+}
+
+static inline void sdp_rsp_cache_clear(void)
+{
+}
+#endif /* CONFIG_BT_SDP_RSP_CACHE_SIZE > 0 */
+
 /* @brief Sends out an SDP PDU
  *
  *  Sends out an SDP PDU after adding the relevant header
@@ -251,6 +404,8 @@ static int bt_sdp_send(struct bt_l2cap_chan *chan, struct net_buf *buf,
 	uint16_t param_len = buf->len;
 	int err;
 
+	sdp_rsp_cache_store(op, buf);
+
 	hdr = net_buf_push(buf, sizeof(struct bt_sdp_hdr));
 	hdr->op_code = op;
 	hdr->tid = sys_cpu_to_be16(tid);
@@ -288,6 +443,48 @@ static void send_err_rsp(struct bt_l2cap_chan *chan, uint16_t err,
 	bt_sdp_send(chan, buf, BT_SDP_ERROR_RSP, tid);
 }
 
+#if CONFIG_BT_SDP_RSP_CACHE_SIZE > 0
+/* @brief Sends a cached response
+ *
+ *  Sends the cached response to a request, if there is one
+ *
+ *  @param sdp Pointer to the SDP structure
+ *  @param op Request op code
+ *  @param buf Request parameters
+ *  @param tid Transaction ID to be used in the packet header
+ *
+ *  @return true if a cached response has been sent, false otherwise
+ */
+static bool sdp_rsp_cache_send(struct bt_sdp *sdp, uint8_t op, const struct net_buf *buf,
+			       uint16_t tid)
+{
+	struct sdp_rsp_cache_entry *entry;
+	struct net_buf *rsp_buf;
+
+	entry = sdp_rsp_cache_lookup(sdp, op, buf);
+	if (!entry) {
+		return false;
+	}
+
+	LOG_DBG("Sending cached response, len %u", entry->rsp_len);
+
+	entry->last_used = ++sdp_rsp_cache_age;
+
+	rsp_buf = bt_sdp_create_pdu();
+	net_buf_add_mem(rsp_buf, entry->rsp, entry->rsp_len);
+
+	bt_sdp_send(&sdp->chan.chan, rsp_buf, entry->rsp_op, tid);
+
+	return true;
+}
+#else
+static inline bool sdp_rsp_cache_send(struct bt_sdp *sdp, uint8_t op, const struct net_buf *buf,
+				      uint16_t tid)
+{
+	return false;
+}
+#endif /* CONFIG_BT_SDP_RSP_CACHE_SIZE > 0 */
+
 /* @brief Parses data elements
  *
  * Parses the first data element from a buffer and splits it into type, size,
@@ -441,6 +638,225 @@ static uint32_t search_uuid(struct bt_sdp_data_elem *elem, struct bt_uuid *uuid,
 	return elem->total_size;
 }
 
+#if CONFIG_BT_SDP_UUID_INDEX_SIZE > 0
+/* @brief Get the 32-bit form of a UUID
+ *
+ * @param uuid UUID to be converted
+ * @param key 32-bit form of the UUID (to be returned)
+ *
+ * @return true if the UUID has a 32-bit form, false otherwise
+ */
+static bool sdp_uuid_index_key(const struct bt_uuid *uuid, uint32_t *key)
+{
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		*key = BT_UUID_16(uuid)->val;
+		return true;
+	case BT_UUID_TYPE_32:
+		*key = BT_UUID_32(uuid)->val;
+		return true;
+	case BT_UUID_TYPE_128:
+		if (memcmp(BT_UUID_128(uuid)->val, sdp_uuid_base.val,
+			   BT_UUID_SIZE_128 - BT_UUID_SIZE_32)) {
+			return false;
+		}
+
+		*key = sys_get_le32(&BT_UUID_128(uuid)->val[BT_UUID_SIZE_128 - BT_UUID_SIZE_32]);
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* @brief Find the position of a UUID and record pair in the index
+ *
+ * @return Index of the first entry that is not lower than the pair
+ */
+static uint16_t sdp_uuid_index_lower_bound(uint32_t uuid, uint8_t rec_index)
+{
+	uint16_t lo = 0U;
+	uint16_t hi = sdp_uuid_index_count;
+
+	while (lo < hi) {
+		uint16_t mid = (lo + hi) / 2U;
+		const struct sdp_uuid_index_entry *entry = &sdp_uuid_index[mid];
+
+		if (entry->uuid < uuid || (entry->uuid == uuid && entry->rec_index < rec_index)) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static bool sdp_uuid_index_insert(uint32_t uuid, uint8_t rec_index)
+{
+	uint16_t pos = sdp_uuid_index_lower_bound(uuid, rec_index);
+
+	if (pos < sdp_uuid_index_count && sdp_uuid_index[pos].uuid == uuid &&
+	    sdp_uuid_index[pos].rec_index == rec_index) {
+		/* Already indexed for this record */
+		return true;
+	}
+
+	if (sdp_uuid_index_count == ARRAY_SIZE(sdp_uuid_index)) {
+		return false;
+	}
+
+	memmove(&sdp_uuid_index[pos + 1], &sdp_uuid_index[pos],
+		(sdp_uuid_index_count - pos) * sizeof(sdp_uuid_index[0]));
+	sdp_uuid_index[pos].uuid = uuid;
+	sdp_uuid_index[pos].rec_index = rec_index;
+	sdp_uuid_index_count++;
+
+	return true;
+}
+
+static void sdp_uuid_index_remove(uint8_t rec_index)
+{
+	uint16_t count = 0U;
+
+	for (uint16_t i = 0U; i < sdp_uuid_index_count; i++) {
+		if (sdp_uuid_index[i].rec_index != rec_index) {
+			sdp_uuid_index[count++] = sdp_uuid_index[i];
+		}
+	}
+
+	sdp_uuid_index_count = count;
+}
+
+/* @brief Add the UUIDs of a data element to the index
+ *
+ * Walks the data element the same way search_uuid() does.
+ *
+ * @param elem Data element to be indexed
+ * @param rec_index Index of the record the data element belongs to
+ * @param nest_level Used to limit the extent of recursion into nested data
+ *  elements
+ *
+ * @return true if all UUIDs have been indexed, false otherwise
+ */
+static bool sdp_uuid_index_add_elem(const struct bt_sdp_data_elem *elem, uint8_t rec_index,
+				    uint8_t nest_level)
+{
+	const uint8_t *cur_elem = elem->data;
+	uint32_t seq_size = elem->data_size;
+	union {
+		struct bt_uuid uuid;
+		struct bt_uuid_16 u16;
+		struct bt_uuid_32 u32;
+		struct bt_uuid_128 u128;
+	} u;
+	uint32_t key;
+
+	/* search_uuid() doesn't look any deeper either */
+	if (nest_level == SDP_DATA_ELEM_NEST_LEVEL_MAX) {
+		return true;
+	}
+
+	if ((elem->type & BT_SDP_TYPE_DESC_MASK) == BT_SDP_UUID_UNSPEC) {
+		if (seq_size == 2U) {
+			u.uuid.type = BT_UUID_TYPE_16;
+			u.u16.val = *((const uint16_t *)cur_elem);
+		} else if (seq_size == 4U) {
+			u.uuid.type = BT_UUID_TYPE_32;
+			u.u32.val = *((const uint32_t *)cur_elem);
+		} else if (seq_size == 16U) {
+			u.uuid.type = BT_UUID_TYPE_128;
+			memcpy(u.u128.val, cur_elem, seq_size);
+		} else {
+			return false;
+		}
+
+		return sdp_uuid_index_key(&u.uuid, &key) &&
+		       sdp_uuid_index_insert(key, rec_index);
+	}
+
+	if ((elem->type & BT_SDP_TYPE_DESC_MASK) == BT_SDP_SEQ_UNSPEC ||
+	    (elem->type & BT_SDP_TYPE_DESC_MASK) == BT_SDP_ALT_UNSPEC) {
+		while (seq_size) {
+			const struct bt_sdp_data_elem *child = (const void *)cur_elem;
+
+			if (child->total_size == 0U || child->total_size > seq_size) {
+				return false;
+			}
+
+			if (!sdp_uuid_index_add_elem(child, rec_index, nest_level + 1)) {
+				return false;
+			}
+
+			cur_elem += sizeof(struct bt_sdp_data_elem);
+			seq_size -= child->total_size;
+		}
+	}
+
+	return true;
+}
+
+/* @brief Add the UUIDs of a service record to the index
+ *
+ * If any UUID of the record can't be indexed, the record is left out of the
+ * index altogether and is searched attribute by attribute.
+ *
+ * @param record Newly registered service record
+ *
+ * @return None
+ */
+static void sdp_uuid_index_add(struct bt_sdp_record *record)
+{
+	for (size_t i = 0; i < record->attr_count; i++) {
+		if (!sdp_uuid_index_add_elem(&record->attrs[i].val, record->index, 1)) {
+			LOG_DBG("Record %u not indexed", record->handle);
+			sdp_uuid_index_remove(record->index);
+			atomic_set_bit(sdp_uuid_unindexed, record->index);
+			return;
+		}
+	}
+
+	atomic_clear_bit(sdp_uuid_unindexed, record->index);
+}
+#endif /* CONFIG_BT_SDP_UUID_INDEX_SIZE > 0 */
+
+/* @brief Check if a service record contains a UUID
+ *
+ * @param record SDP record to be searched
+ * @param uuid UUID to be looked for
+ *
+ * @return true if found, false otherwise
+ */
+static bool record_has_uuid(struct bt_sdp_record *record, struct bt_uuid *uuid)
+{
+	bool found = false;
+
+#if CONFIG_BT_SDP_UUID_INDEX_SIZE > 0
+	if (!atomic_test_bit(sdp_uuid_unindexed, record->index)) {
+		uint32_t key;
+		uint16_t pos;
+
+		/* Indexed records only contain UUIDs with a 32-bit form */
+		if (!sdp_uuid_index_key(uuid, &key)) {
+			return false;
+		}
+
+		pos = sdp_uuid_index_lower_bound(key, record->index);
+
+		return pos < sdp_uuid_index_count && sdp_uuid_index[pos].uuid == key &&
+		       sdp_uuid_index[pos].rec_index == record->index;
+	}
+#endif /* CONFIG_BT_SDP_UUID_INDEX_SIZE > 0 */
+
+	for (size_t index = 0; index < record->attr_count; index++) {
+		(void)search_uuid(&record->attrs[index].val, uuid, &found, 1);
+		if (found) {
+			break;
+		}
+	}
+
+	return found;
+}
+
 /* @brief SDP service record iterator.
  *
  * Iterate over service records from a starting point.
@@ -594,19 +1010,12 @@ static bool service_search_pattern_matched(struct net_buf_simple *buf, struct bt
 			continue;
 		}
 
-		for (size_t index = 0; index < record->attr_count; index++) {
-			struct bt_sdp_attribute *attr;
-
-			attr = &record->attrs[index];
-
-			(void)search_uuid(&attr->val, &u.uuid, &found, 1);
-			if (found) {
-				goto matched;
-			}
+		if (record_has_uuid(record, &u.uuid)) {
+			found = true;
+			break;
 		}
 	}
 
-matched:
 	net_buf_simple_restore(buf, &state);
 
 	return found;
@@ -1610,13 +2019,17 @@ static int bt_sdp_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
 
 	if (sys_cpu_to_be16(hdr->param_len) != buf->len) {
 		err = BT_SDP_INVALID_PDU_SIZE;
+	} else if (sdp_rsp_cache_send(sdp, hdr->op_code, buf, sys_be16_to_cpu(hdr->tid))) {
+		err = 0U;
 	} else {
 		for (i = 0; i < ARRAY_SIZE(handlers); i++) {
 			if (hdr->op_code != handlers[i].op_code) {
 				continue;
 			}
 
+			sdp_rsp_cache_prepare(sdp, hdr->op_code, buf);
 			err = handlers[i].func(sdp, buf, sys_be16_to_cpu(hdr->tid));
+			sdp_rsp_cache_cancel();
 			break;
 		}
 	}
@@ -1725,6 +2138,13 @@ int bt_sdp_register_service(struct bt_sdp_record *service)
 
 	num_services++;
 
+#if CONFIG_BT_SDP_UUID_INDEX_SIZE > 0
+	sdp_uuid_index_add(service);
+#endif /* CONFIG_BT_SDP_UUID_INDEX_SIZE > 0 */
+
+	/* Search responses depend on all the records */
+	sdp_rsp_cache_clear();
+
 	LOG_DBG("Service registered at %u", service->handle);
 
 	return 0;
@@ -21,6 +21,9 @@
 #include <zephyr/bluetooth/classic/a2dp_codec_sbc.h>
 #include <zephyr/bluetooth/classic/a2dp.h>
 #include <zephyr/bluetooth/classic/sdp.h>
+#if defined(CONFIG_LIBSBC)
+#include <zephyr/bluetooth/sbc.h>
+#endif
 
 #include <zephyr/shell/shell.h>
 
@@ -42,7 +45,7 @@ static struct bt_a2dp_ep *registered_sbc_endpoint;
 static struct bt_a2dp_stream sbc_stream;
 static struct bt_a2dp_stream_ops stream_ops;
 
-#if defined(CONFIG_BT_A2DP_SOURCE)
+#if defined(CONFIG_BT_A2DP_SOURCE) && !defined(CONFIG_LIBSBC)
 static uint8_t media_data[] = {
 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
@@ -809,29 +812,139 @@ static int cmd_abort(const struct shell *sh, int32_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_BT_A2DP_SOURCE) && defined(CONFIG_LIBSBC)
+static struct sbc_encoder sbc_encoder;
+/* One frame of silence for the largest SBC frame: 16 blocks, 8 subbands, 2 channels */
+static int16_t pcm_silence[16U * 8U * 2U];
+
+static int sbc_encoder_setup(struct bt_a2dp_codec_sbc_params *sbc)
+{
+	struct sbc_encoder_init_param param;
+	uint32_t frame_len;
+
+	param.samp_freq = bt_a2dp_sbc_get_sampling_frequency(sbc);
+	param.ch_num = bt_a2dp_sbc_get_channel_num(sbc);
+	param.min_bitpool = sbc->min_bitpool;
+	param.max_bitpool = sbc->max_bitpool;
+
+	if ((sbc->config[0] & A2DP_SBC_CH_MODE_MONO) != 0U) {
+		param.ch_mode = SBC_CH_MODE_MONO;
+	} else if ((sbc->config[0] & A2DP_SBC_CH_MODE_DUAL) != 0U) {
+		param.ch_mode = SBC_CH_MODE_DUAL_CHANNEL;
+	} else if ((sbc->config[0] & A2DP_SBC_CH_MODE_STEREO) != 0U) {
+		param.ch_mode = SBC_CH_MODE_STEREO;
+	} else {
+		param.ch_mode = SBC_CH_MODE_JOINT_STEREO;
+	}
+
+	if ((sbc->config[1] & A2DP_SBC_BLK_LEN_4) != 0U) {
+		param.blk_len = 4U;
+	} else if ((sbc->config[1] & A2DP_SBC_BLK_LEN_8) != 0U) {
+		param.blk_len = 8U;
+	} else if ((sbc->config[1] & A2DP_SBC_BLK_LEN_12) != 0U) {
+		param.blk_len = 12U;
+	} else {
+		param.blk_len = 16U;
+	}
+
+	param.subband = ((sbc->config[1] & A2DP_SBC_SUBBAND_4) != 0U) ? 4U : 8U;
+	param.alloc_mthd = ((sbc->config[1] & A2DP_SBC_ALLOC_MTHD_SNR) != 0U) ?
+			   SBC_ALLOC_MTHD_SNR : SBC_ALLOC_MTHD_LOUDNESS;
+
+	/* Bit rate in kbps of a frame encoded with the maximum bitpool */
+	frame_len = 4U + (4U * param.subband * param.ch_num) / 8U;
+	switch (param.ch_mode) {
+	case SBC_CH_MODE_MONO:
+	case SBC_CH_MODE_DUAL_CHANNEL:
+		frame_len += (param.blk_len * param.ch_num * param.max_bitpool + 7U) / 8U;
+		break;
+	case SBC_CH_MODE_STEREO:
+		frame_len += (param.blk_len * param.max_bitpool + 7U) / 8U;
+		break;
+	default:
+		frame_len += (param.subband + param.blk_len * param.max_bitpool + 7U) / 8U;
+		break;
+	}
+
+	param.bit_rate = (8U * frame_len * param.samp_freq) /
+			 (param.subband * param.blk_len * 1000U);
+
+	return sbc_setup_encoder(&sbc_encoder, &param);
+}
+#endif /* CONFIG_BT_A2DP_SOURCE && CONFIG_LIBSBC */
+
 static int cmd_send_media(const struct shell *sh, int32_t argc, char *argv[])
 {
 #if defined(CONFIG_BT_A2DP_SOURCE)
 	struct net_buf *buf;
 	int ret;
+#if defined(CONFIG_LIBSBC)
+	unsigned long frames = 0U;
+	int num_frames;
+	int frames_max;
+	int err = 0;
+#endif
 
 	if (a2dp_initied == 0) {
 		shell_print(sh, "need to register a2dp connection callbacks");
 		return -ENOEXEC;
 	}
 
+#if defined(CONFIG_LIBSBC)
+	if (argc > 1) {
+		frames = shell_strtoul(argv[1], 0, &err);
+		if ((err != 0) || (frames > 15U)) {
+			shell_error(sh, "invalid number of frames %s", argv[1]);
+			return -ENOEXEC;
+		}
+	}
+
+	ret = sbc_encoder_setup((struct bt_a2dp_codec_sbc_params *)sbc_stream.codec_config.codec_ie);
+	if (ret != 0) {
+		shell_error(sh, "fail to setup the sbc encoder (err %d)", ret);
+		return -ENOEXEC;
+	}
+
+	frames_max = bt_a2dp_stream_sbc_frames_max(&sbc_stream, &sbc_encoder);
+	if (frames_max < 0) {
+		shell_error(sh, "no sbc frame fits in a packet (err %d)", frames_max);
+		return -ENOEXEC;
+	}
+#endif
+
 	buf = bt_a2dp_stream_create_pdu(&a2dp_tx_pool, K_FOREVER);
 	if (buf == NULL) {
 		shell_error(sh, "fail to allocate buffer");
 		return -ENOEXEC;
 	}
 
+#if defined(CONFIG_LIBSBC)
+	/* Fill the packet up to the requested number of frames, encoding one frame per call */
+	num_frames = 0;
+	do {
+		ret = bt_a2dp_stream_sbc_encode(&sbc_stream, &sbc_encoder, buf, (uint8_t)frames,
+						pcm_silence, sbc_frame_bytes(&sbc_encoder));
+		if (ret > 0) {
+			num_frames++;
+		}
+	} while (ret > 0);
+
+	if (ret < 0) {
+		shell_error(sh, "fail to encode (err %d)", ret);
+		net_buf_unref(buf);
+		return -ENOEXEC;
+	}
+
+	shell_print(sh, "num of frames: %d (max %d), data length: %d", num_frames, frames_max,
+		    buf->len);
+#else
 	/* num of frames is 1 */
 	net_buf_add_u8(buf, (uint8_t)BT_A2DP_SBC_MEDIA_HDR_ENCODE(1, 0, 0, 0));
 	net_buf_add_mem(buf, media_data, sizeof(media_data));
 	shell_print(sh, "num of frames: %d, data length: %d", 1U, sizeof(media_data));
 	shell_print(sh, "data: %d, %d, %d, %d, %d, %d ......", media_data[0],
 		media_data[1], media_data[2], media_data[3], media_data[4], media_data[5]);
+#endif
 
 	ret = bt_a2dp_stream_send(&sbc_stream, buf, 0U, 0U);
 	if (ret < 0) {
@@ -891,7 +1004,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(a2dp_cmds,
 	SHELL_CMD_ARG(start, NULL, "\"start the stream\"", cmd_start, 1, 0),
 	SHELL_CMD_ARG(suspend, NULL, "\"suspend the stream\"", cmd_suspend, 1, 0),
 	SHELL_CMD_ARG(abort, NULL, "\"abort the stream\"", cmd_abort, 1, 0),
-	SHELL_CMD_ARG(send_media, NULL, HELP_NONE, cmd_send_media, 1, 0),
+	SHELL_CMD_ARG(send_media, NULL, "[frames per packet, 0 for as many as fit]",
+		      cmd_send_media, 1, 1),
 #if defined(CONFIG_BT_A2DP_SINK)
 	SHELL_CMD_ARG(send_delay_report, NULL, HELP_NONE, cmd_send_delay_report, 1, 0),
 #endif
@@ -14,6 +14,7 @@
 #include <zephyr/sys/byteorder.h>
 #include <stdlib.h>
 
+#include <zephyr/kernel.h>
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/bluetooth/l2cap.h>
@@ -249,6 +250,82 @@ static int bip_parse_headers(struct net_buf *buf)
 	return err;
 }
 
+/* SRM header value to enable the Single Response Mode */
+#define BIP_SRM_ENABLE 0x01
+
+#define BIP_STREAM_RSP_TIMEOUT K_SECONDS(10)
+
+struct bip_metrics {
+	uint32_t bytes;
+	uint32_t packets;
+	int64_t start;
+	int64_t end;
+	bool done;
+};
+
+static struct bip_metrics bip_tx_metrics;
+static struct bip_metrics bip_rx_metrics;
+
+/* State of the put_image stream sent by the client */
+static struct {
+	uint32_t size;
+	uint32_t offset;
+	uint8_t rsp_code;
+	bool active;
+	bool srm;
+} bip_client_stream;
+
+static K_SEM_DEFINE(bip_client_stream_sem, 0, 1);
+
+/* Automatic put_image responses of the server */
+static struct {
+	bool enabled;
+	bool srm;
+} bip_server_stream;
+
+static void bip_metrics_add(struct bip_metrics *metrics, uint16_t len, bool done)
+{
+	int64_t now = k_uptime_get();
+
+	if (metrics->done || metrics->packets == 0U) {
+		(void)memset(metrics, 0, sizeof(*metrics));
+		metrics->start = now;
+	}
+
+	metrics->bytes += len;
+	metrics->packets++;
+	metrics->end = now;
+	metrics->done = done;
+}
+
+static void bip_metrics_print(const char *name, const struct bip_metrics *metrics)
+{
+	int64_t ms = MAX(metrics->end - metrics->start, 1);
+
+	if (metrics->packets == 0U) {
+		bt_shell_print("BIP %s: no transfer", name);
+		return;
+	}
+
+	bt_shell_print("BIP %s: %u body bytes in %u packets, %lld ms, %u bps%s", name,
+		       metrics->bytes, metrics->packets, ms,
+		       (uint32_t)((uint64_t)metrics->bytes * 8U * MSEC_PER_SEC / ms),
+		       metrics->done ? "" : " (in progress)");
+}
+
+static uint16_t bip_body_len(struct net_buf *buf)
+{
+	const uint8_t *body;
+	uint16_t len;
+
+	if ((bt_obex_get_header_body(buf, &len, &body) == 0) ||
+	    (bt_obex_get_header_end_body(buf, &len, &body) == 0)) {
+		return len;
+	}
+
+	return 0;
+}
+
 static void bip_server_connect(struct bt_bip_server *server, uint8_t version, uint16_t mopl,
 			       struct net_buf *buf)
 {
@@ -332,9 +409,18 @@ static void bip_server_get_status(struct bt_bip_server *server, bool final, stru
 }
 
 static bool server_put_image_final;
+static void bip_server_put_image_stream(struct bt_bip_server *server, bool final,
+					struct net_buf *buf);
 static void bip_server_put_image(struct bt_bip_server *server, bool final, struct net_buf *buf)
 {
 	server_put_image_final = final;
+	bip_metrics_add(&bip_rx_metrics, bip_body_len(buf), final);
+
+	if (bip_server_stream.enabled) {
+		bip_server_put_image_stream(server, final, buf);
+		return;
+	}
+
 	bt_shell_print("BIP server %p put_image req, final %s, data len %u", server,
 		       final ? "true" : "false", buf->len);
 	bip_parse_headers(buf);
@@ -398,6 +484,7 @@ static void bip_server_start_archive(struct bt_bip_server *server, bool final, s
 
 static void bip_server_abort(struct bt_bip_server *server, struct net_buf *buf)
 {
+	bip_server_stream.srm = false;
 	server_put_image_final = false;
 	server_put_linked_thumbnail_final = false;
 	server_put_linked_attachment_final = false;
@@ -492,9 +579,14 @@ static void bip_client_get_image(struct bt_bip_client *client, uint8_t rsp_code,
 				 struct net_buf *buf)
 {
 	client_get_image_rsp_code = rsp_code;
+	bip_metrics_add(&bip_rx_metrics, bip_body_len(buf), rsp_code != BT_OBEX_RSP_CODE_CONTINUE);
 	bt_shell_print("BIP client %p get_image rsp, rsp_code %s, data len %u", client,
 		       bt_obex_rsp_code_to_str(rsp_code), buf->len);
 	bip_parse_headers(buf);
+
+	if (rsp_code != BT_OBEX_RSP_CODE_CONTINUE) {
+		bip_metrics_print("rx", &bip_rx_metrics);
+	}
 }
 
 static uint8_t client_get_linked_thumbnail_rsp_code;
@@ -556,6 +648,19 @@ static void bip_client_put_image(struct bt_bip_client *client, uint8_t rsp_code,
 	if (client_put_image_rsp_code != BT_OBEX_RSP_CODE_CONTINUE) {
 		client_put_image_final = false;
 	}
+
+	if (bip_client_stream.active) {
+		uint8_t srm;
+
+		if ((bt_obex_get_header_srm(buf, &srm) == 0) && (srm == BIP_SRM_ENABLE)) {
+			bip_client_stream.srm = true;
+		}
+
+		bip_client_stream.rsp_code = rsp_code;
+		k_sem_give(&bip_client_stream_sem);
+		return;
+	}
+
 	bt_shell_print("BIP client %p put_image rsp, rsp_code %s, data len %u", client,
 		       bt_obex_rsp_code_to_str(rsp_code), buf->len);
 	bip_parse_headers(buf);
@@ -2349,6 +2454,180 @@ continue_req:
 	return err;
 }
 
+static int bip_client_stream_body_cb(uint8_t *data, uint16_t len, bool *last, void *user_data)
+{
+	len = (uint16_t)MIN(len, bip_client_stream.size - bip_client_stream.offset);
+
+	/* The image content is generated right into the buffer */
+	for (uint16_t i = 0; i < len; i++) {
+		data[i] = (uint8_t)(bip_client_stream.offset + i);
+	}
+
+	bip_client_stream.offset += len;
+	*last = (bip_client_stream.offset == bip_client_stream.size);
+
+	return len;
+}
+
+static int bip_client_stream_add_headers(const struct shell *sh, struct net_buf *buf)
+{
+	int err;
+
+	err = bt_obex_add_header_conn_id(buf, bip_app.conn_id);
+	if (err != 0) {
+		shell_error(sh, "Fail to add conn id header %d", err);
+		return err;
+	}
+
+	err = bt_obex_add_header_type(buf, sizeof(BT_BIP_HDR_TYPE_PUT_IMAGE),
+				      BT_BIP_HDR_TYPE_PUT_IMAGE);
+	if (err != 0) {
+		shell_error(sh, "Fail to add type header %d", err);
+		return err;
+	}
+
+	err = bt_obex_add_header_name(buf, sizeof(IMAGE_PUT_FILE_NAME) - 1, IMAGE_PUT_FILE_NAME);
+	if (err != 0) {
+		shell_error(sh, "Fail to add name header %d", err);
+		return err;
+	}
+
+	err = bt_bip_add_header_image_desc(buf, sizeof(IMAGE_DESC), IMAGE_DESC);
+	if (err != 0) {
+		shell_error(sh, "Fail to add image desc header %d", err);
+		return err;
+	}
+
+	err = bt_obex_add_header_len(buf, bip_client_stream.size);
+	if (err != 0) {
+		shell_error(sh, "Fail to add len header %d", err);
+		return err;
+	}
+
+	err = bt_obex_add_header_srm(buf, BIP_SRM_ENABLE);
+	if (err != 0) {
+		shell_error(sh, "Fail to add srm header %d", err);
+	}
+
+	return err;
+}
+
+static int bip_client_stream_wait_rsp(const struct shell *sh, uint8_t rsp_code)
+{
+	if (k_sem_take(&bip_client_stream_sem, BIP_STREAM_RSP_TIMEOUT) != 0) {
+		shell_error(sh, "Timeout waiting for put_image rsp");
+		return -ETIMEDOUT;
+	}
+
+	if (bip_client_stream.rsp_code != rsp_code) {
+		shell_error(sh, "Unexpected put_image rsp %s",
+			    bt_obex_rsp_code_to_str(bip_client_stream.rsp_code));
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int cmd_bip_client_put_image_stream(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct net_buf *buf;
+	uint32_t size;
+	uint16_t len;
+	bool first = true;
+	bool last = false;
+	int err = 0;
+
+	if (default_conn == NULL) {
+		shell_error(sh, "Not connected");
+		return -ENOEXEC;
+	}
+
+	if (bip_app.conn == NULL) {
+		shell_error(sh, "No bip transport connection");
+		return -ENOEXEC;
+	}
+
+	size = strtoul(argv[1], NULL, 0);
+	if (size == 0U) {
+		shell_error(sh, "Invalid size %s", argv[1]);
+		return -ENOEXEC;
+	}
+
+	if (bip_app.tx_buf != NULL) {
+		net_buf_unref(bip_app.tx_buf);
+		bip_app.tx_buf = NULL;
+	}
+
+	k_sem_reset(&bip_client_stream_sem);
+	bip_client_stream.size = size;
+	bip_client_stream.offset = 0U;
+	bip_client_stream.srm = false;
+	bip_client_stream.active = true;
+	(void)memset(&bip_tx_metrics, 0, sizeof(bip_tx_metrics));
+
+	while (!last) {
+		/* With SRM, the server only responds early to report an error */
+		if (bip_client_stream.srm && (k_sem_take(&bip_client_stream_sem, K_NO_WAIT) == 0)) {
+			shell_error(sh, "put_image rsp %s during SRM",
+				    bt_obex_rsp_code_to_str(bip_client_stream.rsp_code));
+			err = -EIO;
+			break;
+		}
+
+		buf = bt_goep_create_pdu(&bip_app.bip.goep, &tx_pool);
+		if (buf == NULL) {
+			shell_error(sh, "Fail to allocate tx buffer");
+			err = -ENOBUFS;
+			break;
+		}
+
+		if (first) {
+			err = bip_client_stream_add_headers(sh, buf);
+		}
+
+		if (err == 0) {
+			err = bt_obex_add_header_body_stream(buf, bip_app.server_mopl,
+							     bip_client_stream_body_cb, NULL, &len,
+							     &last);
+		}
+
+		if (err == 0) {
+			err = bt_bip_put_image(&bip_app.client, last, buf);
+		}
+
+		if (err != 0) {
+			shell_error(sh, "Fail to send put_image req %d", err);
+			net_buf_unref(buf);
+			break;
+		}
+
+		bip_metrics_add(&bip_tx_metrics, len, last);
+		first = false;
+
+		/* Wait for each response until the server enabled the SRM */
+		if (!last && !bip_client_stream.srm) {
+			err = bip_client_stream_wait_rsp(sh, BT_OBEX_RSP_CODE_CONTINUE);
+			if (err != 0) {
+				break;
+			}
+		}
+	}
+
+	if (err == 0) {
+		err = bip_client_stream_wait_rsp(sh, BT_OBEX_RSP_CODE_SUCCESS);
+	}
+
+	bip_client_stream.active = false;
+
+	if (err == 0) {
+		shell_print(sh, "put_image stream done, SRM %s",
+			    bip_client_stream.srm ? "enabled" : "disabled");
+		bip_metrics_print("tx", &bip_tx_metrics);
+	}
+
+	return err;
+}
+
 static int cmd_bip_client_put_linked_thumbnail(const struct shell *sh, size_t argc, char *argv[])
 {
 	int err = 0;
@@ -3860,6 +4139,68 @@ error_rsp:
 	return err;
 }
 
+static void bip_server_put_image_stream(struct bt_bip_server *server, bool final,
+					struct net_buf *buf)
+{
+	struct net_buf *rsp_buf;
+	uint8_t srm;
+	int err = 0;
+
+	/* With SRM, only the final request is responded */
+	if (!final && bip_server_stream.srm) {
+		return;
+	}
+
+	rsp_buf = bt_goep_create_pdu(&bip_app.bip.goep, &tx_pool);
+	if (rsp_buf == NULL) {
+		bt_shell_error("Fail to allocate tx buffer");
+		return;
+	}
+
+	if (final) {
+		bip_server_stream.srm = false;
+		err = bt_bip_add_header_image_handle(rsp_buf, sizeof(IMAGE_HANDLE) - 1,
+						     IMAGE_HANDLE);
+	} else if ((bt_obex_get_header_srm(buf, &srm) == 0) && (srm == BIP_SRM_ENABLE)) {
+		err = bt_obex_add_header_srm(rsp_buf, BIP_SRM_ENABLE);
+		bip_server_stream.srm = (err == 0);
+	}
+
+	if (err == 0) {
+		err = bt_bip_put_image_rsp(server, final ? BT_OBEX_RSP_CODE_SUCCESS
+							 : BT_OBEX_RSP_CODE_CONTINUE,
+					   rsp_buf);
+	}
+
+	if (err != 0) {
+		bt_shell_error("Fail to send put_image rsp %d", err);
+		net_buf_unref(rsp_buf);
+		return;
+	}
+
+	server_put_image_final = false;
+
+	if (final) {
+		bip_metrics_print("rx", &bip_rx_metrics);
+	}
+}
+
+static int cmd_bip_server_put_image_stream(const struct shell *sh, size_t argc, char *argv[])
+{
+	if (!strcmp(argv[1], "on")) {
+		bip_server_stream.enabled = true;
+	} else if (!strcmp(argv[1], "off")) {
+		bip_server_stream.enabled = false;
+	} else {
+		shell_help(sh);
+		return SHELL_CMD_HELP_PRINTED;
+	}
+
+	bip_server_stream.srm = false;
+
+	return 0;
+}
+
 static int cmd_bip_server_put_linked_thumbnail(const struct shell *sh, size_t argc, char *argv[])
 {
 	uint8_t rsp_code;
@@ -4473,6 +4814,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		      0),
 	SHELL_CMD_ARG(get_status, NULL, HELP_NONE, cmd_bip_client_get_status, 1, 0),
 	SHELL_CMD_ARG(put_image, NULL, HELP_NONE, cmd_bip_client_put_image, 1, 0),
+	SHELL_CMD_ARG(put_image_stream, NULL, "<size>", cmd_bip_client_put_image_stream, 2, 0),
 	SHELL_CMD_ARG(put_linked_thumbnail, NULL, HELP_NONE, cmd_bip_client_put_linked_thumbnail, 1,
 		      0),
 	SHELL_CMD_ARG(put_linked_attachment, NULL, HELP_NONE, cmd_bip_client_put_linked_attachment,
@@ -4512,6 +4854,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		      cmd_bip_server_get_status, 2, 1),
 	SHELL_CMD_ARG(put_image, NULL, "<rsp: noerror, error> [rsp_code]", cmd_bip_server_put_image,
 		      2, 1),
+	SHELL_CMD_ARG(put_image_stream, NULL, "<auto responses with SRM: on, off>",
+		      cmd_bip_server_put_image_stream, 2, 0),
 	SHELL_CMD_ARG(put_linked_thumbnail, NULL, "<rsp: noerror, error> [rsp_code]",
 		      cmd_bip_server_put_linked_thumbnail, 2, 1),
 	SHELL_CMD_ARG(put_linked_attachment, NULL, "<rsp: noerror, error> [rsp_code]",
@@ -4563,6 +4907,25 @@ static int cmd_release_buf(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_metrics(const struct shell *sh, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset")) {
+			shell_help(sh);
+			return SHELL_CMD_HELP_PRINTED;
+		}
+
+		(void)memset(&bip_tx_metrics, 0, sizeof(bip_tx_metrics));
+		(void)memset(&bip_rx_metrics, 0, sizeof(bip_rx_metrics));
+		return 0;
+	}
+
+	bip_metrics_print("tx", &bip_tx_metrics);
+	bip_metrics_print("rx", &bip_rx_metrics);
+
+	return 0;
+}
+
 static int cmd_common(const struct shell *sh, size_t argc, char **argv)
 {
 	if (argc == 1) {
@@ -4584,6 +4947,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	SHELL_CMD_ARG(disconnect-l2cap, NULL, HELP_NONE, cmd_disconnect_l2cap, 1, 0),
 	SHELL_CMD_ARG(alloc-buf, NULL, "Alloc tx buffer", cmd_alloc_buf, 1, 0),
 	SHELL_CMD_ARG(release-buf, NULL, "Free allocated tx buffer", cmd_release_buf, 1, 0),
+	SHELL_CMD_ARG(metrics, NULL, "Body throughput of the last transfers [reset]", cmd_metrics,
+		      1, 1),
 	SHELL_CMD_ARG(add-header, &obex_add_header_cmds, "Adding header sets", cmd_common, 1, 0),
 	SHELL_CMD_ARG(client, &obex_client_cmds, "Client sets", cmd_common, 1, 0),
 	SHELL_CMD_ARG(server, &obex_server_cmds, "Server sets", cmd_common, 1, 0),
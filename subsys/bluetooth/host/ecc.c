@@ -45,6 +45,7 @@ K_WORK_DEFINE(dh_key_work, generate_dh_key);
 enum {
 	PENDING_PUB_KEY,
 	PENDING_DHKEY,
+	DHKEY_POOL_KEY,
 
 	/* Total number of flags - must be at the end of the enum */
 	NUM_FLAGS,
@@ -55,12 +56,34 @@ static ATOMIC_DEFINE(flags, NUM_FLAGS);
 static struct {
 	uint8_t private_key_be[BT_PRIV_KEY_LEN];
 
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	/* Private key of the pool key pair used by the pending DH Key calculation */
+	uint8_t dh_private_key_be[BT_PRIV_KEY_LEN];
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 	union {
 		uint8_t public_key_be[BT_PUB_KEY_LEN];
 		uint8_t dhkey_be[BT_DH_KEY_LEN];
 	};
 } ecc;
 
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+/* Pool of pre-generated key pairs. A slot is free when it is neither ready
+ * nor busy. Only the refill work item writes to free slots, so a slot handed
+ * out by bt_pub_key_pool_take() stays untouched until it is released.
+ */
+static struct {
+	uint8_t private_key_be[BT_PRIV_KEY_LEN];
+	uint8_t public_key[BT_PUB_KEY_LEN];
+} key_pool[CONFIG_BT_ECC_KEY_POOL_SIZE];
+
+static ATOMIC_DEFINE(key_pool_ready, CONFIG_BT_ECC_KEY_POOL_SIZE);
+static ATOMIC_DEFINE(key_pool_busy, CONFIG_BT_ECC_KEY_POOL_SIZE);
+
+static void key_pool_refill(struct k_work *work);
+K_WORK_DEFINE(key_pool_work, key_pool_refill);
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 /* based on Core Specification 4.2 Vol 3. Part H 2.3.5.6.1 */
 static const uint8_t debug_private_key_be[BT_PRIV_KEY_LEN] = {
 	0x3f, 0x49, 0xf6, 0xd4, 0xa3, 0xc5, 0x5f, 0x38,
@@ -125,14 +148,23 @@ static void set_key_attributes(psa_key_attributes_t *attr)
 	psa_set_key_algorithm(attr, PSA_ALG_ECDH);
 }
 
-static void generate_pub_key(struct k_work *work)
+static void ecc_work_submit(struct k_work *work)
+{
+	if (IS_ENABLED(CONFIG_BT_LONG_WQ)) {
+		bt_long_wq_submit(work);
+	} else {
+		k_work_submit(work);
+	}
+}
+
+/* Generate a key pair, both keys in big-endian as used by the crypto API */
+static int generate_key_pair(uint8_t private_key_be[BT_PRIV_KEY_LEN],
+			     uint8_t public_key_be[BT_PUB_KEY_LEN])
 {
 	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
-	struct bt_pub_key_cb *cb;
 	psa_key_id_t key_id;
 	uint8_t tmp_pub_key_buf[BT_PUB_KEY_LEN + 1];
 	size_t tmp_len;
-	int err;
 	psa_status_t ret;
 
 	set_key_attributes(&attr);
@@ -140,32 +172,41 @@ static void generate_pub_key(struct k_work *work)
 	ret = psa_generate_key(&attr, &key_id);
 	if (ret != PSA_SUCCESS) {
 		LOG_ERR("Failed to generate ECC key %d", ret);
-		err = BT_HCI_ERR_UNSPECIFIED;
-		goto done;
+		return -EIO;
 	}
 
 	ret = psa_export_public_key(key_id, tmp_pub_key_buf, sizeof(tmp_pub_key_buf), &tmp_len);
 	if (ret != PSA_SUCCESS) {
 		LOG_ERR("Failed to export ECC public key %d", ret);
-		err = BT_HCI_ERR_UNSPECIFIED;
-		goto done;
+		return -EIO;
 	}
 	/* secp256r1 PSA exported public key has an extra 0x04 predefined byte at
 	 * the beginning of the buffer which is not part of the coordinate so
 	 * we remove that.
 	 */
-	memcpy(ecc.public_key_be, &tmp_pub_key_buf[1], BT_PUB_KEY_LEN);
+	memcpy(public_key_be, &tmp_pub_key_buf[1], BT_PUB_KEY_LEN);
 
-	ret = psa_export_key(key_id, ecc.private_key_be, BT_PRIV_KEY_LEN, &tmp_len);
+	ret = psa_export_key(key_id, private_key_be, BT_PRIV_KEY_LEN, &tmp_len);
 	if (ret != PSA_SUCCESS) {
 		LOG_ERR("Failed to export ECC private key %d", ret);
-		err = BT_HCI_ERR_UNSPECIFIED;
-		goto done;
+		return -EIO;
 	}
 
 	ret = psa_destroy_key(key_id);
 	if (ret != PSA_SUCCESS) {
 		LOG_ERR("Failed to destroy ECC key ID %d", ret);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void generate_pub_key(struct k_work *work)
+{
+	struct bt_pub_key_cb *cb;
+	int err;
+
+	if (generate_key_pair(ecc.private_key_be, ecc.public_key_be)) {
 		err = BT_HCI_ERR_UNSPECIFIED;
 		goto done;
 	}
@@ -192,8 +233,92 @@ done:
 	sys_slist_init(&pub_key_cb_slist);
 
 	k_sched_unlock();
+
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	/* Fill the pool in the background once the device key pair exists */
+	if (!err) {
+		ecc_work_submit(&key_pool_work);
+	}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
 }
 
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+static void key_pool_refill(struct k_work *work)
+{
+	uint8_t public_key_be[BT_PUB_KEY_LEN];
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_pool); i++) {
+		if (atomic_test_bit(key_pool_ready, i) || atomic_test_bit(key_pool_busy, i)) {
+			continue;
+		}
+
+		if (generate_key_pair(key_pool[i].private_key_be, public_key_be)) {
+			LOG_WRN("Failed to refill ECC key pool");
+			return;
+		}
+
+		sys_memcpy_swap(key_pool[i].public_key, public_key_be, BT_PUB_KEY_COORD_LEN);
+		sys_memcpy_swap(&key_pool[i].public_key[BT_PUB_KEY_COORD_LEN],
+				&public_key_be[BT_PUB_KEY_COORD_LEN], BT_PUB_KEY_COORD_LEN);
+
+		atomic_set_bit(key_pool_ready, i);
+
+		/* Generate a single key pair per run so that a DH Key calculation
+		 * queued meanwhile only waits for one key generation.
+		 */
+		ecc_work_submit(&key_pool_work);
+		return;
+	}
+}
+
+static int key_pool_index(const uint8_t *public_key)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(key_pool); i++) {
+		if (public_key == key_pool[i].public_key) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+const uint8_t *bt_pub_key_pool_take(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(key_pool); i++) {
+		if (!atomic_test_bit(key_pool_ready, i) ||
+		    atomic_test_and_set_bit(key_pool_busy, i)) {
+			continue;
+		}
+
+		atomic_clear_bit(key_pool_ready, i);
+		ecc_work_submit(&key_pool_work);
+
+		return key_pool[i].public_key;
+	}
+
+	LOG_DBG("ECC key pool empty");
+
+	/* A failed refill is retried here, nothing else would restart it */
+	ecc_work_submit(&key_pool_work);
+
+	return NULL;
+}
+
+void bt_pub_key_pool_release(const uint8_t *public_key)
+{
+	int i = key_pool_index(public_key);
+
+	if (i < 0) {
+		return;
+	}
+
+	memset(key_pool[i].private_key_be, 0, BT_PRIV_KEY_LEN);
+	atomic_clear_bit(key_pool_busy, i);
+
+	ecc_work_submit(&key_pool_work);
+}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 static void generate_dh_key(struct k_work *work)
 {
 	int err;
@@ -212,6 +337,13 @@ static void generate_dh_key(struct k_work *work)
 	const uint8_t *priv_key = (IS_ENABLED(CONFIG_BT_USE_DEBUG_KEYS) ?
 				   debug_private_key_be :
 				   ecc.private_key_be);
+
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	if (atomic_test_bit(flags, DHKEY_POOL_KEY)) {
+		priv_key = ecc.dh_private_key_be;
+	}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 	ret = psa_import_key(&attr, priv_key, BT_PRIV_KEY_LEN, &key_id);
 	if (ret != PSA_SUCCESS) {
 		err = -EIO;
@@ -238,6 +370,10 @@ static void generate_dh_key(struct k_work *work)
 	err = 0;
 
 exit:
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	memset(ecc.dh_private_key_be, 0, sizeof(ecc.dh_private_key_be));
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 	/* Change to cooperative priority while we do the callback */
 	k_sched_lock();
 
@@ -245,6 +381,7 @@ exit:
 		bt_dh_key_cb_t cb = dh_key_cb;
 
 		dh_key_cb = NULL;
+		atomic_clear_bit(flags, DHKEY_POOL_KEY);
 		atomic_clear_bit(flags, PENDING_DHKEY);
 
 		if (err) {
@@ -295,11 +432,7 @@ int bt_pub_key_gen(struct bt_pub_key_cb *new_cb)
 
 	atomic_clear_bit(bt_dev.flags, BT_DEV_HAS_PUB_KEY);
 
-	if (IS_ENABLED(CONFIG_BT_LONG_WQ)) {
-		bt_long_wq_submit(&pub_key_work);
-	} else {
-		k_work_submit(&pub_key_work);
-	}
+	ecc_work_submit(&pub_key_work);
 
 	return 0;
 }
@@ -332,13 +465,25 @@ const uint8_t *bt_pub_key_get(void)
 	return NULL;
 }
 
-int bt_dh_key_gen(const uint8_t remote_pk[BT_PUB_KEY_LEN], bt_dh_key_cb_t cb)
+int bt_dh_key_gen(const uint8_t local_pk[BT_PUB_KEY_LEN],
+		  const uint8_t remote_pk[BT_PUB_KEY_LEN], bt_dh_key_cb_t cb)
 {
+	bool pool_key = false;
+
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	int pool_index = key_pool_index(local_pk);
+
+	pool_key = (pool_index >= 0);
+	if (pool_key && !atomic_test_bit(key_pool_busy, pool_index)) {
+		return -EADDRNOTAVAIL;
+	}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 	if (dh_key_cb == cb) {
 		return -EALREADY;
 	}
 
-	if (!atomic_test_bit(bt_dev.flags, BT_DEV_HAS_PUB_KEY)) {
+	if (!pool_key && !atomic_test_bit(bt_dev.flags, BT_DEV_HAS_PUB_KEY)) {
 		return -EADDRNOTAVAIL;
 	}
 
@@ -350,6 +495,17 @@ int bt_dh_key_gen(const uint8_t remote_pk[BT_PUB_KEY_LEN], bt_dh_key_cb_t cb)
 
 	dh_key_cb = cb;
 
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	/* Copy the private key so that releasing the pool slot while the
+	 * calculation is queued cannot change the key it uses.
+	 */
+	if (pool_key) {
+		memcpy(ecc.dh_private_key_be, key_pool[pool_index].private_key_be,
+		       BT_PRIV_KEY_LEN);
+		atomic_set_bit(flags, DHKEY_POOL_KEY);
+	}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 	/* Convert X and Y coordinates from little-endian to
 	 * big-endian (expected by the crypto API).
 	 */
@@ -357,11 +513,7 @@ int bt_dh_key_gen(const uint8_t remote_pk[BT_PUB_KEY_LEN], bt_dh_key_cb_t cb)
 	sys_memcpy_swap(&ecc.public_key_be[BT_PUB_KEY_COORD_LEN],
 			&remote_pk[BT_PUB_KEY_COORD_LEN], BT_PUB_KEY_COORD_LEN);
 
-	if (IS_ENABLED(CONFIG_BT_LONG_WQ)) {
-		bt_long_wq_submit(&dh_key_work);
-	} else {
-		k_work_submit(&dh_key_work);
-	}
+	ecc_work_submit(&dh_key_work);
 
 	return 0;
 }
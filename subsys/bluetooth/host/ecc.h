@@ -88,6 +88,26 @@ void bt_pub_key_hci_disrupted(void);
  */
 const uint8_t *bt_pub_key_get(void);
 
+/*  @brief Take a pre-generated key pair from the key pool.
+ *
+ *  Hand out one of the key pairs generated in the background when
+ *  CONFIG_BT_ECC_KEY_POOL_SIZE is non-zero. The key pair stays reserved for
+ *  the caller until bt_pub_key_pool_release() is called, and a replacement is
+ *  generated in the background.
+ *
+ *  @return Public Key of the key pair, or NULL if the pool is empty.
+ */
+const uint8_t *bt_pub_key_pool_take(void);
+
+/*  @brief Release a key pair taken from the key pool.
+ *
+ *  The private key is erased and the slot is refilled in the background.
+ *  Keys not taken from the pool are ignored.
+ *
+ *  @param pub_key Public Key returned by bt_pub_key_pool_take().
+ */
+void bt_pub_key_pool_release(const uint8_t *pub_key);
+
 /*  @typedef bt_dh_key_cb_t
  *  @brief Callback type for DH Key calculation.
  *
@@ -99,11 +119,15 @@ typedef void (*bt_dh_key_cb_t)(const uint8_t key[BT_DH_KEY_LEN]);
 
 /*  @brief Calculate a DH Key from a remote Public Key.
  *
- *  Calculate a DH Key from the remote Public Key.
+ *  Calculate a DH Key from the remote Public Key, using the private key that
+ *  belongs to the given local Public Key.
  *
+ *  @param local_pk Local Public Key, either the one returned by
+ *                  bt_pub_key_get() or one taken from the key pool.
  *  @param remote_pk Remote Public Key.
  *  @param cb Callback to notify the calculated key.
  *
  *  @return Zero on success or negative error code otherwise
  */
-int bt_dh_key_gen(const uint8_t remote_pk[BT_PUB_KEY_LEN], bt_dh_key_cb_t cb);
+int bt_dh_key_gen(const uint8_t local_pk[BT_PUB_KEY_LEN],
+		  const uint8_t remote_pk[BT_PUB_KEY_LEN], bt_dh_key_cb_t cb);
@@ -1500,20 +1500,45 @@ static void delayed_store(struct k_work *work)
 }
 #endif	/* CONFIG_BT_SETTINGS_DELAYED_STORE */
 
+#if defined(CONFIG_BT_SETTINGS_DEFERRED_DISCONNECT_STORE)
+/* Bonded CCC and CF values are kept after the disconnection, so they can be
+ * written by the delayed store work instead of the disconnection path. Values
+ * stored on write are already queued; the others are queued here.
+ */
+static void gatt_store_ccc_cf_deferred(uint8_t id, const bt_addr_le_t *peer_addr)
+{
+	if (!IS_ENABLED(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE)) {
+		gatt_delayed_store_enqueue(id, peer_addr, DELAYED_STORE_CCC);
+	}
+
+	if (IS_ENABLED(CONFIG_BT_GATT_CACHING) &&
+	    !IS_ENABLED(CONFIG_BT_SETTINGS_CF_STORE_ON_WRITE)) {
+		gatt_delayed_store_enqueue(id, peer_addr, DELAYED_STORE_CF);
+	}
+}
+#endif /* CONFIG_BT_SETTINGS_DEFERRED_DISCONNECT_STORE */
+
 static void gatt_store_ccc_cf(uint8_t id, const bt_addr_le_t *peer_addr)
 {
 	struct ds_peer *el = gatt_delayed_store_find(id, peer_addr);
 
 	if (bt_le_bond_exists(id, peer_addr)) {
-		if (!IS_ENABLED(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE) ||
-		    (IS_ENABLED(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE) && el &&
-		     atomic_test_and_clear_bit(el->flags, DELAYED_STORE_CCC))) {
+		bool store_ccc = !IS_ENABLED(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE);
+		bool store_cf = !IS_ENABLED(CONFIG_BT_SETTINGS_CF_STORE_ON_WRITE);
+
+		/* The flags are set on write or by a deferred disconnection
+		 * store, clear them in both cases so the slot can be freed.
+		 */
+		if (el) {
+			store_ccc |= atomic_test_and_clear_bit(el->flags, DELAYED_STORE_CCC);
+			store_cf |= atomic_test_and_clear_bit(el->flags, DELAYED_STORE_CF);
+		}
+
+		if (store_ccc) {
 			gatt_store_ccc(id, peer_addr);
 		}
 
-		if (!IS_ENABLED(CONFIG_BT_SETTINGS_CF_STORE_ON_WRITE) ||
-		    (IS_ENABLED(CONFIG_BT_SETTINGS_CF_STORE_ON_WRITE) && el &&
-		     atomic_test_and_clear_bit(el->flags, DELAYED_STORE_CF))) {
+		if (store_cf) {
 			bt_gatt_store_cf(id, peer_addr);
 		}
 
@@ -5806,12 +5831,30 @@ static void ccc_clear(struct bt_gatt_ccc_managed_user_data *ccc,
 	clear_ccc_cfg(cfg);
 }
 
+static void ccc_restore_cfg(struct bt_gatt_ccc_managed_user_data *ccc,
+			    const bt_addr_le_t *addr, uint8_t id, uint16_t value)
+{
+	struct bt_gatt_ccc_cfg *cfg;
+
+	cfg = ccc_find_cfg(ccc, addr, id);
+	if (!cfg) {
+		cfg = ccc_find_cfg(ccc, BT_ADDR_LE_ANY, 0);
+		if (!cfg) {
+			LOG_DBG("Unable to restore CCC: no cfg left");
+			return;
+		}
+		bt_addr_le_copy(&cfg->peer, addr);
+		cfg->id = id;
+	}
+
+	cfg->value = value;
+}
+
 static uint8_t ccc_load(const struct bt_gatt_attr *attr, uint16_t handle,
 			void *user_data)
 {
 	struct ccc_load *load = user_data;
 	struct bt_gatt_ccc_managed_user_data *ccc;
-	struct bt_gatt_ccc_cfg *cfg;
 
 	if (!is_host_managed_ccc(attr)) {
 		return BT_GATT_ITER_CONTINUE;
@@ -5844,18 +5887,8 @@ static uint8_t ccc_load(const struct bt_gatt_attr *attr, uint16_t handle,
 	LOG_DBG("Restoring CCC: handle 0x%04x value 0x%04x", load->entry->handle,
 		load->entry->value);
 
-	cfg = ccc_find_cfg(ccc, load->addr_with_id.addr, load->addr_with_id.id);
-	if (!cfg) {
-		cfg = ccc_find_cfg(ccc, BT_ADDR_LE_ANY, 0);
-		if (!cfg) {
-			LOG_DBG("Unable to restore CCC: no cfg left");
-			goto next;
-		}
-		bt_addr_le_copy(&cfg->peer, load->addr_with_id.addr);
-		cfg->id = load->addr_with_id.id;
-	}
-
-	cfg->value = load->entry->value;
+	ccc_restore_cfg(ccc, load->addr_with_id.addr, load->addr_with_id.id,
+			load->entry->value);
 
 next:
 	load->entry++;
@@ -5864,8 +5897,98 @@ next:
 	return load->count ? BT_GATT_ITER_CONTINUE : BT_GATT_ITER_STOP;
 }
 
+#if CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0
+/* CCC values read from settings and not yet applied to the attribute database.
+ * A handle of zero means that all values of the peer were invalidated.
+ */
+static struct {
+	struct {
+		bt_addr_le_t addr;
+		uint8_t id;
+		uint16_t handle;
+		uint16_t value;
+	} entry[CONFIG_BT_SETTINGS_CCC_LOAD_BATCH];
+	size_t count;
+} ccc_restore;
+
+static uint8_t ccc_restore_attr(const struct bt_gatt_attr *attr, uint16_t handle,
+				void *user_data)
+{
+	struct bt_gatt_ccc_managed_user_data *ccc;
+
+	if (!is_host_managed_ccc(attr)) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	ccc = attr->user_data;
+
+	/* Apply in the order the values were read so that later settings
+	 * entries supersede earlier ones.
+	 */
+	for (size_t i = 0; i < ccc_restore.count; i++) {
+		if (ccc_restore.entry[i].handle == 0U) {
+			ccc_clear(ccc, &ccc_restore.entry[i].addr, ccc_restore.entry[i].id);
+		} else if (ccc_restore.entry[i].handle == handle) {
+			LOG_DBG("Restoring CCC: handle 0x%04x value 0x%04x", handle,
+				ccc_restore.entry[i].value);
+
+			ccc_restore_cfg(ccc, &ccc_restore.entry[i].addr, ccc_restore.entry[i].id,
+					ccc_restore.entry[i].value);
+		}
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void ccc_restore_flush(void)
+{
+	if (!ccc_restore.count) {
+		return;
+	}
+
+	LOG_DBG("Restoring %zu CCC values", ccc_restore.count);
+
+	bt_gatt_foreach_attr(0x0001, 0xffff, ccc_restore_attr, NULL);
+	ccc_restore.count = 0;
+}
+
+static void ccc_restore_add(const struct addr_with_id *addr_with_id, uint16_t handle,
+			    uint16_t value)
+{
+	if (ccc_restore.count == ARRAY_SIZE(ccc_restore.entry)) {
+		ccc_restore_flush();
+	}
+
+	bt_addr_le_copy(&ccc_restore.entry[ccc_restore.count].addr, addr_with_id->addr);
+	ccc_restore.entry[ccc_restore.count].id = addr_with_id->id;
+	ccc_restore.entry[ccc_restore.count].handle = handle;
+	ccc_restore.entry[ccc_restore.count].value = value;
+	ccc_restore.count++;
+}
+
+/* Queue the values for ccc_restore_flush() instead of walking the attribute
+ * database once per bonded peer.
+ */
+static void ccc_restore_queue(const struct ccc_load *load)
+{
+	if (!load->entry) {
+		ccc_restore_add(&load->addr_with_id, 0U, 0U);
+		return;
+	}
+
+	for (size_t i = 0; i < load->count; i++) {
+		if (load->entry[i].handle == 0U) {
+			continue;
+		}
+
+		ccc_restore_add(&load->addr_with_id, load->entry[i].handle,
+				load->entry[i].value);
+	}
+}
+#endif /* CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0 */
+
 static int ccc_set(const char *name, size_t len_rd, settings_read_cb read_cb,
-		   void *cb_arg)
+		   void *cb_arg, bool batch)
 {
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		struct ccc_store ccc_store[CCC_STORE_MAX];
@@ -5921,6 +6044,13 @@ static int ccc_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 			load.count = 0;
 		}
 
+#if CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0
+		if (batch) {
+			ccc_restore_queue(&load);
+			return 0;
+		}
+#endif /* CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0 */
+
 		bt_gatt_foreach_attr(0x0001, 0xffff, ccc_load, &load);
 
 		LOG_DBG("Restored CCC for id:%" PRIu8 " addr:%s", load.addr_with_id.id,
@@ -5939,10 +6069,21 @@ static int ccc_set_cb(const char *name, size_t len_rd, settings_read_cb read_cb,
 		return 0;
 	}
 
-	return ccc_set(name, len_rd, read_cb, cb_arg);
+	return ccc_set(name, len_rd, read_cb, cb_arg, true);
 }
 
+#if CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0
+static int ccc_commit(void)
+{
+	ccc_restore_flush();
+
+	return 0;
+}
+
+BT_SETTINGS_DEFINE(ccc, "ccc", ccc_set_cb, ccc_commit);
+#else
 BT_SETTINGS_DEFINE(ccc, "ccc", ccc_set_cb, NULL);
+#endif /* CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0 */
 #endif /* CONFIG_BT_SETTINGS */
 
 static int ccc_set_direct(const char *key, size_t len, settings_read_cb read_cb,
@@ -5959,7 +6100,7 @@ static int ccc_set_direct(const char *key, size_t len, settings_read_cb read_cb,
 			return -EINVAL;
 		}
 
-		return ccc_set(name, len, read_cb, cb_arg);
+		return ccc_set(name, len, read_cb, cb_arg, false);
 	}
 	return 0;
 }
@@ -5992,6 +6133,11 @@ void bt_gatt_connected(struct bt_conn *conn)
 		settings_load_subtree_direct(key, ccc_set_direct, (void *)key);
 	}
 
+#if CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0
+	/* Values loaded without committing the "bt/ccc" subtree */
+	ccc_restore_flush();
+#endif /* CONFIG_BT_SETTINGS_CCC_LOAD_BATCH > 0 */
+
 	bt_gatt_foreach_attr(0x0001, 0xffff, update_ccc, &data);
 
 	/* BLUETOOTH CORE SPECIFICATION Version 5.1 | Vol 3, Part C page 2192:
@@ -6557,9 +6703,13 @@ void bt_gatt_disconnected(struct bt_conn *conn)
 	cleanup_notify(conn);
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
+#if defined(CONFIG_BT_SETTINGS_DEFERRED_DISCONNECT_STORE)
+	gatt_store_ccc_cf_deferred(conn->id, &conn->le.dst);
+#else
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		gatt_store_ccc_cf(conn->id, &conn->le.dst);
 	}
+#endif /* CONFIG_BT_SETTINGS_DEFERRED_DISCONNECT_STORE */
 
 	/* Make sure to clear the CCC entry when using lazy loading */
 	if (IS_ENABLED(CONFIG_BT_SETTINGS_CCC_LAZY_LOADING) &&
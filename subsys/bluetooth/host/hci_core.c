@@ -156,6 +156,13 @@ struct cmd_data {
 
 	/** Used by bt_hci_cmd_send_sync. */
 	struct k_sem *sync;
+
+	/** Used by bt_hci_cmd_send_cb. */
+	bt_hci_cmd_cb_t cb;
+	void *user_data;
+
+	/** The command may be outstanding together with other pipelined commands. */
+	bool pipeline;
 };
 
 static struct cmd_data cmd_data[BT_BUF_CMD_TX_COUNT];
@@ -163,6 +170,18 @@ static struct cmd_data cmd_data[BT_BUF_CMD_TX_COUNT];
 #define cmd(buf) (&cmd_data[net_buf_id(buf)])
 #define acl(buf) ((struct bt_conn_rx *)net_buf_user_data(buf))
 
+#if CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1
+/* Command credits in circulation, i.e. available in ncmd_sem or held by a
+ * command not yet completed. Only updated from the HCI RX context.
+ */
+static uint8_t cmd_credits;
+
+/* Given whenever a command completes, for non-pipelined commands waiting for
+ * the outstanding ones.
+ */
+static K_SEM_DEFINE(cmd_done_sem, 0, 1);
+#endif /* CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1 */
+
 static bool drv_quirk_no_reset(void)
 {
 	return ((BT_HCI_QUIRKS & BT_HCI_QUIRK_NO_RESET) != 0);
@@ -384,6 +403,9 @@ struct net_buf *bt_hci_cmd_alloc(k_timeout_t timeout)
 	cmd(buf)->opcode = 0;
 	cmd(buf)->sync = NULL;
 	cmd(buf)->state = NULL;
+	cmd(buf)->cb = NULL;
+	cmd(buf)->user_data = NULL;
+	cmd(buf)->pipeline = false;
 
 	return buf;
 }
@@ -418,6 +440,8 @@ int bt_hci_cmd_send(uint16_t opcode, struct net_buf *buf)
 	 * and does not generate any cmd complete/status events.
 	 */
 	if (opcode == BT_HCI_OP_HOST_NUM_COMPLETED_PACKETS) {
+		bt_hci_cmd_cb_t cb = cmd(buf)->cb;
+		void *user_data = cmd(buf)->user_data;
 		int err;
 
 		err = bt_send(buf);
@@ -426,6 +450,11 @@ int bt_hci_cmd_send(uint16_t opcode, struct net_buf *buf)
 			net_buf_unref(buf);
 		}
 
+		if (cb) {
+			cb(opcode, err ? BT_HCI_ERR_UNSPECIFIED : BT_HCI_ERR_SUCCESS, NULL,
+			   user_data);
+		}
+
 		return err;
 	}
 
@@ -435,6 +464,29 @@ int bt_hci_cmd_send(uint16_t opcode, struct net_buf *buf)
 	return 0;
 }
 
+int bt_hci_cmd_send_cb(uint16_t opcode, struct net_buf *buf, bt_hci_cmd_cb_t cb,
+		       void *user_data)
+{
+	if (!buf) {
+		buf = bt_hci_cmd_alloc(K_FOREVER);
+		if (!buf) {
+			return -ENOBUFS;
+		}
+	} else {
+		/* `cmd(buf)` depends on this  */
+		if (net_buf_pool_get(buf->pool_id) != &hci_cmd_pool) {
+			__ASSERT_NO_MSG(false);
+			return -EINVAL;
+		}
+	}
+
+	cmd(buf)->cb = cb;
+	cmd(buf)->user_data = user_data;
+	cmd(buf)->pipeline = true;
+
+	return bt_hci_cmd_send(opcode, buf);
+}
+
 static bool process_pending_cmd(k_timeout_t timeout);
 int bt_hci_cmd_send_sync(uint16_t opcode, struct net_buf *buf,
 			 struct net_buf **rsp)
@@ -2536,7 +2588,54 @@ static void hci_reset_complete(void)
 	atomic_set(bt_dev.flags, flags);
 }
 
-static void hci_cmd_done(uint16_t opcode, uint8_t status, struct net_buf *evt_buf)
+static void sent_cmd_add(struct net_buf *buf)
+{
+	struct net_buf *old;
+
+	for (size_t i = 0; i < ARRAY_SIZE(bt_dev.sent_cmd); i++) {
+		if (atomic_ptr_cas((atomic_ptr_t *)&bt_dev.sent_cmd[i], NULL, buf)) {
+			return;
+		}
+	}
+
+	/* Clear out an existing sent command */
+	LOG_ERR("Uncleared pending sent_cmd");
+	old = atomic_ptr_set((atomic_ptr_t *)&bt_dev.sent_cmd[0], buf);
+	if (old) {
+		net_buf_unref(old);
+	}
+}
+
+/* Take the reference to the sent command waiting for a response to OpCode */
+static struct net_buf *sent_cmd_take(uint16_t opcode)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(bt_dev.sent_cmd); i++) {
+		struct net_buf *buf = atomic_ptr_get((atomic_ptr_t *)&bt_dev.sent_cmd[i]);
+
+		if (buf && cmd(buf)->opcode == opcode &&
+		    atomic_ptr_cas((atomic_ptr_t *)&bt_dev.sent_cmd[i], buf, NULL)) {
+			return buf;
+		}
+	}
+
+	return NULL;
+}
+
+static struct net_buf *sent_cmd_peek(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(bt_dev.sent_cmd); i++) {
+		struct net_buf *buf = atomic_ptr_get((atomic_ptr_t *)&bt_dev.sent_cmd[i]);
+
+		if (buf) {
+			return buf;
+		}
+	}
+
+	return NULL;
+}
+
+/* Return `true` if the command completed a command sent by the host */
+static bool hci_cmd_done(uint16_t opcode, uint8_t status, struct net_buf *evt_buf)
 {
 	/* Original command buffer. */
 	struct net_buf *buf = NULL;
@@ -2552,19 +2651,19 @@ static void hci_cmd_done(uint16_t opcode, uint8_t status, struct net_buf *evt_bu
 	}
 
 	/* Take the original command buffer reference. */
-	buf = atomic_ptr_clear((atomic_ptr_t *)&bt_dev.sent_cmd);
+	buf = sent_cmd_take(opcode);
 
 	if (!buf) {
-		LOG_ERR("No command sent for cmd complete 0x%04x", opcode);
-		goto exit;
-	}
+		struct net_buf *sent = sent_cmd_peek();
 
-	if (cmd(buf)->opcode != opcode) {
-		LOG_ERR("OpCode 0x%04x completed instead of expected 0x%04x", opcode,
-			cmd(buf)->opcode);
-		buf = atomic_ptr_set((atomic_ptr_t *)&bt_dev.sent_cmd, buf);
-		__ASSERT_NO_MSG(!buf);
-		goto exit;
+		if (!sent) {
+			LOG_ERR("No command sent for cmd complete 0x%04x", opcode);
+		} else {
+			LOG_ERR("OpCode 0x%04x completed instead of expected 0x%04x", opcode,
+				cmd(sent)->opcode);
+		}
+
+		return false;
 	}
 
 	/* Response data is to be delivered in the original command
@@ -2581,6 +2680,10 @@ static void hci_cmd_done(uint16_t opcode, uint8_t status, struct net_buf *evt_bu
 		atomic_set_bit_to(update->target, update->bit, update->val);
 	}
 
+	if (cmd(buf)->cb) {
+		cmd(buf)->cb(opcode, status, buf, cmd(buf)->user_data);
+	}
+
 	/* If the command was synchronous wake up bt_hci_cmd_send_sync() */
 	if (cmd(buf)->sync) {
 		LOG_DBG("sync cmd released");
@@ -2588,10 +2691,57 @@ static void hci_cmd_done(uint16_t opcode, uint8_t status, struct net_buf *evt_bu
 		k_sem_give(cmd(buf)->sync);
 	}
 
+	net_buf_unref(buf);
+
+#if CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1
+	k_sem_give(&cmd_done_sem);
+#endif /* CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1 */
+
+	return true;
+
 exit:
-	if (buf) {
-		net_buf_unref(buf);
+	return false;
+}
+
+/* Update the number of commands the host may send from the Num_HCI_Command_Packets
+ * of a Command Complete or Command Status event.
+ */
+static void hci_cmd_credits_update(uint8_t ncmd, bool completed)
+{
+#if CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1
+	bool raise = completed;
+
+	/* A credit may be used by a command the Controller had not received yet
+	 * when it reported ncmd. Hand the credit of the completed command back
+	 * only if ncmd covers all credits in circulation, and add a credit only
+	 * if ncmd exceeds them.
+	 */
+	if (completed) {
+		if (ncmd >= cmd_credits) {
+			k_sem_give(&bt_dev.ncmd_sem);
+		} else {
+			cmd_credits--;
+		}
 	}
+
+	if (ncmd > cmd_credits && cmd_credits < CONFIG_BT_HCI_CMD_PIPELINE_MAX) {
+		cmd_credits++;
+		k_sem_give(&bt_dev.ncmd_sem);
+		raise = true;
+	}
+
+	if (raise) {
+		bt_tx_irq_raise();
+	}
+#else
+	ARG_UNUSED(completed);
+
+	/* Allow next command to be sent */
+	if (ncmd) {
+		k_sem_give(&bt_dev.ncmd_sem);
+		bt_tx_irq_raise();
+	}
+#endif /* CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1 */
 }
 
 static void hci_cmd_complete(struct net_buf *buf)
@@ -2599,6 +2749,7 @@ static void hci_cmd_complete(struct net_buf *buf)
 	struct bt_hci_evt_cmd_complete *evt;
 	uint8_t status, ncmd;
 	uint16_t opcode;
+	bool completed;
 
 	evt = net_buf_pull_mem(buf, sizeof(*evt));
 	ncmd = evt->ncmd;
@@ -2620,13 +2771,9 @@ static void hci_cmd_complete(struct net_buf *buf)
 		return;
 	}
 
-	hci_cmd_done(opcode, status, buf);
+	completed = hci_cmd_done(opcode, status, buf);
 
-	/* Allow next command to be sent */
-	if (ncmd) {
-		k_sem_give(&bt_dev.ncmd_sem);
-		bt_tx_irq_raise();
-	}
+	hci_cmd_credits_update(ncmd, completed);
 }
 
 static void hci_cmd_status(struct net_buf *buf)
@@ -2634,6 +2781,7 @@ static void hci_cmd_status(struct net_buf *buf)
 	struct bt_hci_evt_cmd_status *evt;
 	uint16_t opcode;
 	uint8_t ncmd;
+	bool completed;
 
 	evt = net_buf_pull_mem(buf, sizeof(*evt));
 	opcode = sys_le16_to_cpu(evt->opcode);
@@ -2641,13 +2789,9 @@ static void hci_cmd_status(struct net_buf *buf)
 
 	LOG_DBG("opcode 0x%04x", opcode);
 
-	hci_cmd_done(opcode, evt->status, buf);
+	completed = hci_cmd_done(opcode, evt->status, buf);
 
-	/* Allow next command to be sent */
-	if (ncmd) {
-		k_sem_give(&bt_dev.ncmd_sem);
-		bt_tx_irq_raise();
-	}
+	hci_cmd_credits_update(ncmd, completed);
 }
 
 int bt_hci_get_conn_handle(const struct bt_conn *conn, uint16_t *conn_handle)
@@ -3261,14 +3405,7 @@ static void hci_core_send_cmd(void)
 	buf = k_fifo_get(&bt_dev.cmd_tx_queue, K_NO_WAIT);
 	BT_ASSERT(buf);
 
-	/* Clear out any existing sent command */
-	if (bt_dev.sent_cmd) {
-		LOG_ERR("Uncleared pending sent_cmd");
-		net_buf_unref(bt_dev.sent_cmd);
-		bt_dev.sent_cmd = NULL;
-	}
-
-	bt_dev.sent_cmd = net_buf_ref(buf);
+	sent_cmd_add(net_buf_ref(buf));
 
 	LOG_DBG("Sending command 0x%04x (buf %p) to driver", cmd(buf)->opcode, buf);
 
@@ -3511,9 +3648,79 @@ static void le_read_resolving_list_size_complete(struct net_buf *buf)
 }
 #endif /* defined(CONFIG_BT_SMP) */
 
+static struct {
+	struct k_sem done;
+	uint8_t status;
+} init_read;
+
+static void init_read_complete(uint16_t opcode, uint8_t status, struct net_buf *rsp,
+			       void *user_data)
+{
+	if (status) {
+		LOG_WRN("opcode 0x%04x status 0x%02x %s", opcode, status,
+			bt_hci_err_to_str(status));
+		init_read.status = status;
+	} else if (opcode == BT_HCI_OP_READ_LOCAL_FEATURES) {
+		read_local_features_complete(rsp);
+	} else if (opcode == BT_HCI_OP_READ_LOCAL_VERSION_INFO) {
+		read_local_ver_complete(rsp);
+	} else if (opcode == BT_HCI_OP_READ_SUPPORTED_COMMANDS) {
+		read_supported_commands_complete(rsp);
+	}
+
+	k_sem_give(&init_read.done);
+}
+
+static int init_reads(void)
+{
+	static const uint16_t opcodes[] = {
+		BT_HCI_OP_READ_LOCAL_FEATURES,
+		BT_HCI_OP_READ_LOCAL_VERSION_INFO,
+		BT_HCI_OP_READ_SUPPORTED_COMMANDS,
+	};
+	size_t sent;
+	int err = 0;
+
+	k_sem_init(&init_read.done, 0, ARRAY_SIZE(opcodes));
+	init_read.status = BT_HCI_ERR_SUCCESS;
+
+	for (sent = 0; sent < ARRAY_SIZE(opcodes); sent++) {
+		err = bt_hci_cmd_send_cb(opcodes[sent], NULL, init_read_complete, NULL);
+		if (err) {
+			break;
+		}
+	}
+
+	/* Same as bt_hci_cmd_send_sync(): if the commands are processed in
+	 * the syswq and we are on the syswq, send them from here.
+	 */
+	if (!IS_ENABLED(CONFIG_BT_TX_PROCESSOR_THREAD) && k_current_get() == &k_sys_work_q.thread) {
+		while (!k_fifo_is_empty(&bt_dev.cmd_tx_queue)) {
+			__maybe_unused bool success = process_pending_cmd(HCI_CMD_TIMEOUT);
+
+			BT_ASSERT_MSG(success, "init read commands timeout");
+		}
+	}
+
+	/* Wait for every command that was sent, even on error, as the
+	 * callbacks use init_read.
+	 */
+	for (size_t i = 0; i < sent; i++) {
+		__maybe_unused int ret = k_sem_take(&init_read.done, HCI_CMD_TIMEOUT);
+
+		BT_ASSERT_MSG(ret == 0, "Controller unresponsive, init read timeout with err %d",
+			      ret);
+	}
+
+	if (err) {
+		return err;
+	}
+
+	return init_read.status ? -EIO : 0;
+}
+
 static int common_init(void)
 {
-	struct net_buf *rsp;
 	int err;
 
 	if (!drv_quirk_no_reset()) {
@@ -3526,31 +3733,14 @@ static int common_init(void)
 		hci_reset_complete();
 	}
 
-	/* Read Local Supported Features */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_LOCAL_FEATURES, NULL, &rsp);
-	if (err) {
-		return err;
-	}
-	read_local_features_complete(rsp);
-	net_buf_unref(rsp);
-
-	/* Read Local Version Information */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_LOCAL_VERSION_INFO, NULL,
-				   &rsp);
-	if (err) {
-		return err;
-	}
-	read_local_ver_complete(rsp);
-	net_buf_unref(rsp);
-
-	/* Read Local Supported Commands */
-	err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_SUPPORTED_COMMANDS, NULL,
-				   &rsp);
+	/* Read Local Supported Features, Local Version Information and
+	 * Local Supported Commands. None of them depend on each other so
+	 * they may be pipelined.
+	 */
+	err = init_reads();
 	if (err) {
 		return err;
 	}
-	read_supported_commands_complete(rsp);
-	net_buf_unref(rsp);
 
 	if (IS_ENABLED(CONFIG_BT_HOST_CRYPTO)) {
 		/* Initialize crypto for host */
@@ -4695,10 +4885,14 @@ int bt_enable(bt_ready_cb_t cb)
 	 * initial Command Complete for NOP.
 	 */
 	if (!IS_ENABLED(CONFIG_BT_WAIT_NOP)) {
-		k_sem_init(&bt_dev.ncmd_sem, 1, 1);
+		k_sem_init(&bt_dev.ncmd_sem, 1, CONFIG_BT_HCI_CMD_PIPELINE_MAX);
 	} else {
-		k_sem_init(&bt_dev.ncmd_sem, 0, 1);
+		k_sem_init(&bt_dev.ncmd_sem, 0, CONFIG_BT_HCI_CMD_PIPELINE_MAX);
 	}
+
+#if CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1
+	cmd_credits = IS_ENABLED(CONFIG_BT_WAIT_NOP) ? 0U : 1U;
+#endif /* CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1 */
 	k_fifo_init(&bt_dev.cmd_tx_queue);
 
 #if defined(CONFIG_BT_RECV_WORKQ_BT)
@@ -5088,11 +5282,56 @@ int bt_configure_data_path(uint8_t dir, uint8_t id, uint8_t vs_config_len,
 	return err;
 }
 
+#if CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1
+/* A command is sent while others are outstanding only if all of them are
+ * pipelined and none has the same OpCode, since responses are matched to the
+ * sent commands by OpCode.
+ */
+static bool cmd_can_send(struct net_buf *buf)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(bt_dev.sent_cmd); i++) {
+		struct net_buf *sent = atomic_ptr_get((atomic_ptr_t *)&bt_dev.sent_cmd[i]);
+
+		if (!sent) {
+			continue;
+		}
+
+		if (!cmd(buf)->pipeline || !cmd(sent)->pipeline ||
+		    cmd(sent)->opcode == cmd(buf)->opcode) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool cmd_pipeline_ready(k_timeout_t timeout)
+{
+	struct net_buf *buf = k_fifo_peek_head(&bt_dev.cmd_tx_queue);
+
+	while (!cmd_can_send(buf)) {
+		/* The TX processor is kicked again when a command completes */
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+		    k_sem_take(&cmd_done_sem, timeout) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1 */
+
 /* Return `true` if a command was processed/sent */
 static bool process_pending_cmd(k_timeout_t timeout)
 {
 	if (!k_fifo_is_empty(&bt_dev.cmd_tx_queue)) {
 		if (k_sem_take(&bt_dev.ncmd_sem, timeout) == 0) {
+#if CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1
+			if (!cmd_pipeline_ready(timeout)) {
+				k_sem_give(&bt_dev.ncmd_sem);
+				return false;
+			}
+#endif /* CONFIG_BT_HCI_CMD_PIPELINE_MAX > 1 */
 			hci_core_send_cmd();
 			return true;
 		}
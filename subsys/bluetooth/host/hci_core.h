@@ -405,8 +405,8 @@ struct bt_dev {
 	/* Number of commands controller can accept */
 	struct k_sem		ncmd_sem;
 
-	/* Last sent HCI command */
-	struct net_buf		*sent_cmd;
+	/* Sent HCI commands waiting for Command Complete or Command Status */
+	struct net_buf		*sent_cmd[CONFIG_BT_HCI_CMD_PIPELINE_MAX];
 
 	/* Queue for incoming HCI events & ACL data */
 	sys_slist_t rx_queue;
@@ -43,6 +43,35 @@ static struct bt_keys key_pool[CONFIG_BT_MAX_PAIRED];
 
 #define BT_KEYS_STORAGE_LEN_COMPAT (BT_KEYS_STORAGE_LEN - sizeof(uint32_t))
 
+/* Identity lookups go through a chained hash index over key_pool. Links are
+ * stored as slot + 1 so that 0 marks the end of a chain. The index only
+ * narrows down the candidates: each of them is still compared against the
+ * pool entry, so a slot that was modified without being relinked is never
+ * returned for the wrong identity.
+ */
+#define KEYS_INDEX_SIZE MAX(CONFIG_BT_MAX_PAIRED, 1)
+
+/* Number of IRKs handed to the RPA resolver at once */
+#define KEYS_IRK_BATCH_SIZE MAX(MIN(CONFIG_BT_MAX_PAIRED, 8), 1)
+
+static uint8_t index_head[KEYS_INDEX_SIZE];
+static uint8_t index_next[KEYS_INDEX_SIZE];
+/* Bucket + 1 each slot is currently linked into, 0 if not linked */
+static uint8_t index_bucket[KEYS_INDEX_SIZE];
+
+#if CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0
+struct rpa_cache_entry {
+	bt_addr_t rpa;
+	uint8_t id;
+	/* Slot + 1 of the keys the RPA resolved to, 0 if it did not resolve */
+	uint8_t slot;
+	/* Uptime in milliseconds, 0 for an unused entry */
+	int64_t expires;
+};
+
+static struct rpa_cache_entry rpa_cache[CONFIG_BT_KEYS_RPA_CACHE_SIZE];
+#endif /* CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0 */
+
 #if defined(CONFIG_BT_KEYS_OVERWRITE_OLDEST)
 static uint32_t aging_counter_val;
 static struct bt_keys *last_keys_updated;
@@ -85,9 +114,144 @@ static bool key_is_in_use(uint8_t id)
 }
 #endif /* CONFIG_BT_KEYS_OVERWRITE_OLDEST */
 
+static uint8_t keys_index_hash(uint8_t id, const bt_addr_le_t *addr)
+{
+	/* FNV-1a over the ID, address type and address value */
+	uint32_t hash = 2166136261U;
+
+	hash = (hash ^ id) * 16777619U;
+	hash = (hash ^ addr->type) * 16777619U;
+
+	for (size_t i = 0; i < sizeof(addr->a.val); i++) {
+		hash = (hash ^ addr->a.val[i]) * 16777619U;
+	}
+
+	return hash % KEYS_INDEX_SIZE;
+}
+
+static void keys_index_unlink(size_t slot)
+{
+	uint8_t *link;
+
+	if (index_bucket[slot] == 0U) {
+		return;
+	}
+
+	for (link = &index_head[index_bucket[slot] - 1U]; *link != 0U;
+	     link = &index_next[*link - 1U]) {
+		if (*link == slot + 1U) {
+			*link = index_next[slot];
+			break;
+		}
+	}
+
+	index_next[slot] = 0U;
+	index_bucket[slot] = 0U;
+}
+
+static void keys_index_link(struct bt_keys *keys)
+{
+	size_t slot = keys - key_pool;
+	uint8_t bucket = keys_index_hash(keys->id, &keys->addr);
+
+	keys_index_unlink(slot);
+
+	index_next[slot] = index_head[bucket];
+	index_head[bucket] = slot + 1U;
+	index_bucket[slot] = bucket + 1U;
+}
+
+/* Find the keys for an ID and address pair having any of the given types,
+ * or any keys at all if type is 0.
+ */
+static struct bt_keys *keys_index_find(uint16_t type, uint8_t id, const bt_addr_le_t *addr)
+{
+	uint8_t entry = index_head[keys_index_hash(id, addr)];
+
+	while (entry != 0U) {
+		struct bt_keys *keys = &key_pool[entry - 1U];
+
+		if ((type == 0U || (keys->keys & type)) && keys->id == id &&
+		    bt_addr_le_eq(&keys->addr, addr)) {
+			return keys;
+		}
+
+		entry = index_next[entry - 1U];
+	}
+
+	return NULL;
+}
+
+#if CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0
+static struct rpa_cache_entry *rpa_cache_entry(const bt_addr_t *rpa)
+{
+	/* The lower 24 bits of an RPA are the output of the ah() hash, so they
+	 * are uniformly distributed and can be used directly as cache index.
+	 */
+	return &rpa_cache[sys_get_le24(rpa->val) % ARRAY_SIZE(rpa_cache)];
+}
+
+static bool rpa_cache_lookup(uint8_t id, const bt_addr_t *rpa, struct bt_keys **keys)
+{
+	struct rpa_cache_entry *entry = rpa_cache_entry(rpa);
+
+	if (entry->expires == 0 || entry->id != id || !bt_addr_eq(&entry->rpa, rpa)) {
+		return false;
+	}
+
+	if (entry->expires <= k_uptime_get()) {
+		entry->expires = 0;
+		return false;
+	}
+
+	if (entry->slot == 0U) {
+		*keys = NULL;
+		return true;
+	}
+
+	*keys = &key_pool[entry->slot - 1U];
+	if (!((*keys)->keys & BT_KEYS_IRK) || (*keys)->id != id) {
+		entry->expires = 0;
+		return false;
+	}
+
+	return true;
+}
+
+static void rpa_cache_store(uint8_t id, const bt_addr_t *rpa, struct bt_keys *keys)
+{
+	struct rpa_cache_entry *entry = rpa_cache_entry(rpa);
+
+	bt_addr_copy(&entry->rpa, rpa);
+	entry->id = id;
+	entry->slot = keys ? (keys - key_pool) + 1U : 0U;
+	entry->expires = k_uptime_get() + CONFIG_BT_KEYS_RPA_CACHE_TIMEOUT * MSEC_PER_SEC;
+}
+
+/* Must be called whenever an IRK is added, changed or removed, since cached
+ * results (in particular the unresolvable ones) may no longer hold.
+ */
+static void rpa_cache_flush(void)
+{
+	(void)memset(rpa_cache, 0, sizeof(rpa_cache));
+}
+#else
+static bool rpa_cache_lookup(uint8_t id, const bt_addr_t *rpa, struct bt_keys **keys)
+{
+	return false;
+}
+
+static void rpa_cache_store(uint8_t id, const bt_addr_t *rpa, struct bt_keys *keys) {}
+static void rpa_cache_flush(void) {}
+#endif /* CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0 */
+
 void bt_keys_reset(void)
 {
 	memset(key_pool, 0, sizeof(key_pool));
+	memset(index_head, 0, sizeof(index_head));
+	memset(index_next, 0, sizeof(index_next));
+	memset(index_bucket, 0, sizeof(index_bucket));
+	rpa_cache_flush();
 }
 
 struct bt_keys *bt_keys_get_addr(uint8_t id, const bt_addr_le_t *addr)
@@ -100,15 +264,15 @@ struct bt_keys *bt_keys_get_addr(uint8_t id, const bt_addr_le_t *addr)
 
 	LOG_DBG("%s", bt_addr_le_str(addr));
 
-	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
-		keys = &key_pool[i];
+	keys = keys_index_find(0U, id, addr);
+	if (keys) {
+		return keys;
+	}
 
-		if (keys->id == id && bt_addr_le_eq(&keys->addr, addr)) {
-			return keys;
-		}
-		if (first_free_slot == ARRAY_SIZE(key_pool) &&
-		    bt_addr_le_eq(&keys->addr, BT_ADDR_LE_ANY)) {
+	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
+		if (bt_addr_le_eq(&key_pool[i].addr, BT_ADDR_LE_ANY)) {
 			first_free_slot = i;
+			break;
 		}
 	}
 
@@ -148,6 +312,7 @@ struct bt_keys *bt_keys_get_addr(uint8_t id, const bt_addr_le_t *addr)
 		keys = &key_pool[first_free_slot];
 		keys->id = id;
 		bt_addr_le_copy(&keys->addr, addr);
+		keys_index_link(keys);
 #if defined(CONFIG_BT_KEYS_OVERWRITE_OLDEST)
 		keys->aging_counter = ++aging_counter_val;
 		last_keys_updated = keys;
@@ -197,20 +362,15 @@ void bt_keys_foreach_type(enum bt_keys_type type, void (*func)(struct bt_keys *k
 
 struct bt_keys *bt_keys_find(enum bt_keys_type type, uint8_t id, const bt_addr_le_t *addr)
 {
-	int i;
-
 	__ASSERT_NO_MSG(addr != NULL);
 
 	LOG_DBG("type %d %s", type, bt_addr_le_str(addr));
 
-	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
-		if ((key_pool[i].keys & type) && key_pool[i].id == id &&
-		    bt_addr_le_eq(&key_pool[i].addr, addr)) {
-			return &key_pool[i];
-		}
+	if (!type) {
+		return NULL;
 	}
 
-	return NULL;
+	return keys_index_find(type, id, addr);
 }
 
 struct bt_keys *bt_keys_get_type(enum bt_keys_type type, uint8_t id, const bt_addr_le_t *addr)
@@ -221,6 +381,11 @@ struct bt_keys *bt_keys_get_type(enum bt_keys_type type, uint8_t id, const bt_ad
 
 	LOG_DBG("type %d %s", type, bt_addr_le_str(addr));
 
+	if (type & BT_KEYS_IRK) {
+		/* The caller is about to set a new IRK value */
+		rpa_cache_flush();
+	}
+
 	keys = bt_keys_find(type, id, addr);
 	if (keys) {
 		return keys;
@@ -236,8 +401,45 @@ struct bt_keys *bt_keys_get_type(enum bt_keys_type type, uint8_t id, const bt_ad
 	return keys;
 }
 
+static struct bt_keys *keys_irk_resolve(struct bt_keys *const batch[], size_t count,
+					const bt_addr_t *rpa, bool *failed)
+{
+	const uint8_t *irks[KEYS_IRK_BATCH_SIZE];
+	int idx;
+
+	for (size_t i = 0; i < count; i++) {
+		irks[i] = batch[i]->irk.val;
+	}
+
+	idx = bt_rpa_irk_matches_batch(irks, count, rpa);
+	if (idx >= 0) {
+		return batch[idx];
+	}
+
+	if (idx == -ENOENT) {
+		return NULL;
+	}
+
+	LOG_WRN("Failed to resolve %s in a batch (err %d)", bt_addr_str(rpa), idx);
+
+	/* The batch stops at the failing IRK, check them one at a time. */
+	*failed = true;
+
+	for (size_t i = 0; i < count; i++) {
+		if (bt_rpa_irk_matches(irks[i], rpa)) {
+			return batch[i];
+		}
+	}
+
+	return NULL;
+}
+
 struct bt_keys *bt_keys_find_irk(uint8_t id, const bt_addr_le_t *addr)
 {
+	struct bt_keys *batch[KEYS_IRK_BATCH_SIZE];
+	struct bt_keys *keys;
+	bool failed = false;
+	size_t count = 0;
 	int i;
 
 	__ASSERT_NO_MSG(addr != NULL);
@@ -248,6 +450,16 @@ struct bt_keys *bt_keys_find_irk(uint8_t id, const bt_addr_le_t *addr)
 		return NULL;
 	}
 
+	if (rpa_cache_lookup(id, &addr->a, &keys)) {
+		LOG_DBG("cached resolution of %s", bt_addr_le_str(addr));
+
+		if (keys) {
+			bt_addr_copy(&keys->irk.rpa, &addr->a);
+		}
+
+		return keys;
+	}
+
 	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
 		if (!(key_pool[i].keys & BT_KEYS_IRK)) {
 			continue;
@@ -261,52 +473,66 @@ struct bt_keys *bt_keys_find_irk(uint8_t id, const bt_addr_le_t *addr)
 		}
 	}
 
-	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
-		if (!(key_pool[i].keys & BT_KEYS_IRK)) {
-			continue;
+	keys = NULL;
+
+	for (i = 0; i < ARRAY_SIZE(key_pool) && !keys; i++) {
+		if ((key_pool[i].keys & BT_KEYS_IRK) && key_pool[i].id == id) {
+			batch[count++] = &key_pool[i];
 		}
 
-		if (key_pool[i].id != id) {
-			continue;
+		if (count == ARRAY_SIZE(batch) || (count && i == ARRAY_SIZE(key_pool) - 1)) {
+			keys = keys_irk_resolve(batch, count, &addr->a, &failed);
+			count = 0;
 		}
+	}
 
-		if (bt_rpa_irk_matches(key_pool[i].irk.val, &addr->a)) {
-			LOG_DBG("RPA %s matches %s", bt_addr_str(&key_pool[i].irk.rpa),
-				bt_addr_le_str(&key_pool[i].addr));
+	if (keys) {
+		LOG_DBG("RPA %s matches %s", bt_addr_str(&addr->a), bt_addr_le_str(&keys->addr));
 
-			bt_addr_copy(&key_pool[i].irk.rpa, &addr->a);
+		bt_addr_copy(&keys->irk.rpa, &addr->a);
+		rpa_cache_store(id, &addr->a, keys);
 
-			return &key_pool[i];
-		}
+		return keys;
 	}
 
 	LOG_DBG("No IRK for %s", bt_addr_le_str(addr));
 
+	/* A failed encryption may have hidden a match, so only remember the
+	 * RPA as unresolvable if every IRK was checked.
+	 */
+	if (!failed) {
+		rpa_cache_store(id, &addr->a, NULL);
+	}
+
 	return NULL;
 }
 
 struct bt_keys *bt_keys_find_addr(uint8_t id, const bt_addr_le_t *addr)
 {
-	int i;
-
 	__ASSERT_NO_MSG(addr != NULL);
 
 	LOG_DBG("%s", bt_addr_le_str(addr));
 
-	for (i = 0; i < ARRAY_SIZE(key_pool); i++) {
-		if (key_pool[i].id == id &&
-		    bt_addr_le_eq(&key_pool[i].addr, addr)) {
-			return &key_pool[i];
-		}
-	}
+	return keys_index_find(0U, id, addr);
+}
 
-	return NULL;
+void bt_keys_set_addr(struct bt_keys *keys, const bt_addr_le_t *addr)
+{
+	__ASSERT_NO_MSG(keys != NULL);
+	__ASSERT_NO_MSG(addr != NULL);
+
+	bt_addr_le_copy(&keys->addr, addr);
+	keys_index_link(keys);
 }
 
 void bt_keys_add_type(struct bt_keys *keys, enum bt_keys_type type)
 {
 	__ASSERT_NO_MSG(keys != NULL);
 
+	if (type & BT_KEYS_IRK) {
+		rpa_cache_flush();
+	}
+
 	keys->keys |= type;
 }
 
@@ -325,6 +551,11 @@ void bt_keys_clear(struct bt_keys *keys)
 		bt_settings_delete_keys(keys->id, &keys->addr);
 	}
 
+	if (keys->keys & BT_KEYS_IRK) {
+		rpa_cache_flush();
+	}
+
+	keys_index_unlink(keys - key_pool);
 	(void)memset(keys, 0, sizeof(*keys));
 }
 
@@ -395,6 +626,11 @@ static int keys_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 	if (!len) {
 		keys = bt_keys_find(BT_KEYS_ALL, id, &addr);
 		if (keys) {
+			if (keys->keys & BT_KEYS_IRK) {
+				rpa_cache_flush();
+			}
+
+			keys_index_unlink(keys - key_pool);
 			(void)memset(keys, 0, sizeof(*keys));
 			LOG_DBG("Cleared keys for %s", bt_addr_le_str(&addr));
 		} else {
@@ -427,6 +663,10 @@ static int keys_set(const char *name, size_t len_rd, settings_read_cb read_cb,
 		memcpy(keys->storage_start, val, len);
 	}
 
+	if (keys->keys & BT_KEYS_IRK) {
+		rpa_cache_flush();
+	}
+
 	/* As of Core v6.2, authenticated keys are only valid for OOB or LE SC pairing
 	 * methods. This check ensures that keys are valid if a device is updated from a
 	 * previous version that did not enforce this requirement.
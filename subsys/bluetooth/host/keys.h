@@ -178,6 +178,17 @@ struct bt_keys *bt_keys_find_irk(uint8_t id, const bt_addr_le_t *addr);
  */
 struct bt_keys *bt_keys_find_addr(uint8_t id, const bt_addr_le_t *addr);
 
+/**
+ * @brief Change the address of a key
+ *
+ * The address of a key must not be written directly, since the keys are
+ * indexed by ID and address.
+ *
+ * @param keys Key reference.
+ * @param addr New destination address.
+ */
+void bt_keys_set_addr(struct bt_keys *keys, const bt_addr_le_t *addr);
+
 /**
  * @brief Add a type to a key
  *
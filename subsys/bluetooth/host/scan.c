@@ -21,6 +21,7 @@
 #include <zephyr/bluetooth/addr.h>
 #include <zephyr/bluetooth/hci.h>
 #include <zephyr/bluetooth/hci_vs.h>
+#include <zephyr/bluetooth/uuid.h>
 #include <zephyr/kernel.h>
 #include <zephyr/net_buf.h>
 #include <zephyr/sys/__assert.h>
@@ -67,9 +68,6 @@ static sys_slist_t scan_cbs = SYS_SLIST_STATIC_INIT(&scan_cbs);
 static struct scanner_state scan_state;
 
 #if defined(CONFIG_BT_EXT_ADV)
-/* A buffer used to reassemble advertisement data from the controller. */
-NET_BUF_SIMPLE_DEFINE(ext_scan_buf, CONFIG_BT_EXT_SCAN_BUF_SIZE);
-
 struct fragmented_advertiser {
 	bt_addr_le_t addr;
 	uint8_t sid;
@@ -78,9 +76,31 @@ struct fragmented_advertiser {
 		FRAG_ADV_REASSEMBLING,
 		FRAG_ADV_DISCARDING,
 	} state;
+	/* Value of reassembly_seq when a report was last added, used for LRU eviction */
+	uint32_t last_used;
+	/* A buffer used to reassemble advertisement data from the controller. */
+	struct net_buf_simple buf;
+	uint8_t data[CONFIG_BT_EXT_SCAN_BUF_SIZE];
 };
 
-static struct fragmented_advertiser reassembling_advertiser;
+static struct fragmented_advertiser
+	reassembling_advertisers[CONFIG_BT_EXT_SCAN_REASSEMBLY_COUNT];
+
+/* Advertiser whose reassembly context was evicted. Its remaining reports are discarded
+ * until the last report of the chain, so that they are not mistaken for a new
+ * advertisement.
+ */
+struct evicted_advertiser {
+	bt_addr_le_t addr;
+	uint8_t sid;
+	bool active;
+	/* Value of reassembly_seq when the context was evicted */
+	uint32_t evicted_at;
+};
+
+static struct evicted_advertiser evicted_advertisers[CONFIG_BT_EXT_SCAN_REASSEMBLY_COUNT];
+static uint32_t reassembly_seq;
+static struct bt_le_scan_reassembly_stats reassembly_stats;
 
 static bool fragmented_advertisers_equal(const struct fragmented_advertiser *a,
 					 const bt_addr_le_t *addr, uint8_t sid)
@@ -89,18 +109,141 @@ static bool fragmented_advertisers_equal(const struct fragmented_advertiser *a,
 	return a->sid == sid && bt_addr_le_eq(&a->addr, addr);
 }
 
-/* Sets the address and sid of the advertiser to be reassembled. */
-static void init_reassembling_advertiser(const bt_addr_le_t *addr, uint8_t sid)
+static struct fragmented_advertiser *find_reassembling_advertiser(const bt_addr_le_t *addr,
+								  uint8_t sid)
 {
-	bt_addr_le_copy(&reassembling_advertiser.addr, addr);
-	reassembling_advertiser.sid = sid;
-	reassembling_advertiser.state = FRAG_ADV_REASSEMBLING;
+	for (size_t i = 0; i < ARRAY_SIZE(reassembling_advertisers); i++) {
+		struct fragmented_advertiser *adv = &reassembling_advertisers[i];
+
+		if (adv->state != FRAG_ADV_INACTIVE && fragmented_advertisers_equal(adv, addr, sid)) {
+			return adv;
+		}
+	}
+
+	return NULL;
 }
 
-static void reset_reassembling_advertiser(void)
+/* Returns true if a is a better candidate for eviction than b */
+static bool fragmented_advertiser_evict_before(const struct fragmented_advertiser *a,
+					       const struct fragmented_advertiser *b)
 {
-	net_buf_simple_reset(&ext_scan_buf);
-	reassembling_advertiser.state = FRAG_ADV_INACTIVE;
+	if (a->state != b->state) {
+		/* Advertisers that are only discarding reports hold no data */
+		return a->state == FRAG_ADV_DISCARDING;
+	}
+
+	return (int32_t)(a->last_used - b->last_used) < 0;
+}
+
+/* Remembers that the remaining reports of an advertiser are to be discarded.
+ *
+ * If all entries are in use, the oldest one is replaced. The remaining reports of that
+ * advertiser may then be reported as truncated advertisements.
+ */
+static void evicted_advertiser_add(const bt_addr_le_t *addr, uint8_t sid)
+{
+	struct evicted_advertiser *evicted = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(evicted_advertisers); i++) {
+		struct evicted_advertiser *candidate = &evicted_advertisers[i];
+
+		if (!candidate->active) {
+			evicted = candidate;
+			break;
+		}
+
+		if (evicted == NULL ||
+		    (int32_t)(candidate->evicted_at - evicted->evicted_at) < 0) {
+			evicted = candidate;
+		}
+	}
+
+	bt_addr_le_copy(&evicted->addr, addr);
+	evicted->sid = sid;
+	evicted->active = true;
+	evicted->evicted_at = reassembly_seq;
+}
+
+/* Returns true if the report continues the chain of an evicted advertiser, and is to be
+ * discarded. The advertiser is forgotten with the last report of the chain.
+ */
+static bool evicted_advertiser_report(const bt_addr_le_t *addr, uint8_t sid, bool more_to_come)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(evicted_advertisers); i++) {
+		struct evicted_advertiser *evicted = &evicted_advertisers[i];
+
+		if (evicted->active && evicted->sid == sid && bt_addr_le_eq(&evicted->addr, addr)) {
+			evicted->active = more_to_come;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Sets the address and sid of the advertiser to be reassembled.
+ *
+ * If all reassembly contexts are in use, the least recently used one is evicted. The
+ * remaining reports of the evicted advertiser are then discarded up to the end of its
+ * chain.
+ */
+static struct fragmented_advertiser *init_reassembling_advertiser(const bt_addr_le_t *addr,
+								  uint8_t sid)
+{
+	struct fragmented_advertiser *adv = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(reassembling_advertisers); i++) {
+		struct fragmented_advertiser *candidate = &reassembling_advertisers[i];
+
+		if (candidate->state == FRAG_ADV_INACTIVE) {
+			adv = candidate;
+			break;
+		}
+
+		if (adv == NULL || fragmented_advertiser_evict_before(candidate, adv)) {
+			adv = candidate;
+		}
+	}
+
+	if (adv->state == FRAG_ADV_REASSEMBLING) {
+		LOG_DBG("Evicting reassembly of %s (SID %u)", bt_addr_le_str(&adv->addr),
+			adv->sid);
+		reassembly_stats.discarded++;
+	}
+
+	if (adv->state != FRAG_ADV_INACTIVE) {
+		evicted_advertiser_add(&adv->addr, adv->sid);
+	}
+
+	net_buf_simple_init_with_data(&adv->buf, adv->data, sizeof(adv->data));
+	net_buf_simple_reset(&adv->buf);
+	bt_addr_le_copy(&adv->addr, addr);
+	adv->sid = sid;
+	adv->state = FRAG_ADV_REASSEMBLING;
+	adv->last_used = reassembly_seq++;
+
+	return adv;
+}
+
+static void reset_reassembling_advertiser(struct fragmented_advertiser *adv)
+{
+	if (adv->state == FRAG_ADV_REASSEMBLING) {
+		/* The data reassembled so far will never be reported */
+		reassembly_stats.discarded++;
+	}
+
+	adv->state = FRAG_ADV_INACTIVE;
+}
+
+static void reset_reassembling_advertisers(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(reassembling_advertisers); i++) {
+		reset_reassembling_advertiser(&reassembling_advertisers[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(evicted_advertisers); i++) {
+		evicted_advertisers[i].active = false;
+	}
 }
 
 #if defined(CONFIG_BT_PER_ADV_SYNC)
@@ -114,7 +257,7 @@ void bt_scan_softreset(void)
 {
 	scan_dev_found_cb = NULL;
 #if defined(CONFIG_BT_EXT_ADV)
-	reset_reassembling_advertiser();
+	reset_reassembling_advertisers();
 #endif
 }
 
@@ -123,6 +266,9 @@ void bt_scan_reset(void)
 	memset(&scan_state, 0x0, sizeof(scan_state));
 	k_mutex_init(&scan_state.scan_update_mutex);
 	k_mutex_init(&scan_state.scan_explicit_params_mutex);
+#if defined(CONFIG_BT_EXT_ADV)
+	memset(&reassembly_stats, 0, sizeof(reassembly_stats));
+#endif
 	bt_scan_softreset();
 }
 
@@ -624,6 +770,167 @@ static uint8_t get_adv_props_legacy(uint8_t evt_type)
 	}
 }
 
+#if defined(CONFIG_BT_SCAN_FILTER)
+static struct bt_le_scan_filter scan_filters[CONFIG_BT_SCAN_FILTER_MAX];
+static size_t scan_filter_cnt;
+
+static bool scan_filter_uuid_match(const struct bt_uuid *uuid, const uint8_t *data,
+				   uint8_t data_len, size_t uuid_len)
+{
+	for (size_t i = 0; i + uuid_len <= data_len; i += uuid_len) {
+		union {
+			struct bt_uuid uuid;
+			struct bt_uuid_16 u16;
+			struct bt_uuid_32 u32;
+			struct bt_uuid_128 u128;
+		} ad_uuid;
+
+		if (bt_uuid_create(&ad_uuid.uuid, &data[i], uuid_len) &&
+		    bt_uuid_cmp(&ad_uuid.uuid, uuid) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Checks a single AD structure against the filters that depend on the advertising data */
+static bool scan_filter_ad_match(const struct bt_le_scan_filter *filter, uint8_t type,
+				 const uint8_t *data, uint8_t data_len)
+{
+	size_t prefix_len;
+
+	switch (filter->type) {
+	case BT_LE_SCAN_FILTER_AD_TYPE:
+		return type == filter->ad_type;
+	case BT_LE_SCAN_FILTER_NAME_PREFIX:
+		if (type != BT_DATA_NAME_SHORTENED && type != BT_DATA_NAME_COMPLETE) {
+			return false;
+		}
+
+		prefix_len = strlen(filter->name_prefix);
+
+		return data_len >= prefix_len && memcmp(data, filter->name_prefix, prefix_len) == 0;
+	case BT_LE_SCAN_FILTER_UUID:
+		switch (filter->uuid->type) {
+		case BT_UUID_TYPE_16:
+			return (type == BT_DATA_UUID16_SOME || type == BT_DATA_UUID16_ALL) &&
+			       scan_filter_uuid_match(filter->uuid, data, data_len, BT_UUID_SIZE_16);
+		case BT_UUID_TYPE_32:
+			return (type == BT_DATA_UUID32_SOME || type == BT_DATA_UUID32_ALL) &&
+			       scan_filter_uuid_match(filter->uuid, data, data_len, BT_UUID_SIZE_32);
+		case BT_UUID_TYPE_128:
+			return (type == BT_DATA_UUID128_SOME || type == BT_DATA_UUID128_ALL) &&
+			       scan_filter_uuid_match(filter->uuid, data, data_len,
+						      BT_UUID_SIZE_128);
+		default:
+			return false;
+		}
+	case BT_LE_SCAN_FILTER_MANUFACTURER_ID:
+		return type == BT_DATA_MANUFACTURER_DATA && data_len >= sizeof(uint16_t) &&
+		       sys_get_le16(data) == filter->company_id;
+	default:
+		return false;
+	}
+}
+
+/* Returns true if the report shall be passed to the filtered scan callbacks.
+ *
+ * The address filters are checked first, then the advertising data is walked once and every
+ * AD structure is checked against the remaining filters, stopping at the first match.
+ */
+static bool scan_filter_match(const bt_addr_le_t *addr, const uint8_t *ad, uint16_t len)
+{
+	bool check_ad = false;
+
+	if (scan_filter_cnt == 0U) {
+		return true;
+	}
+
+	for (size_t i = 0; i < scan_filter_cnt; i++) {
+		if (scan_filters[i].type != BT_LE_SCAN_FILTER_ADDR) {
+			check_ad = true;
+		} else if (bt_addr_le_eq(&scan_filters[i].addr, addr)) {
+			return true;
+		}
+	}
+
+	while (check_ad && len > 1) {
+		uint8_t ad_len = ad[0];
+
+		if (ad_len == 0U || ad_len > len - 1) {
+			/* Early termination or malformed advertising data */
+			break;
+		}
+
+		for (size_t i = 0; i < scan_filter_cnt; i++) {
+			if (scan_filter_ad_match(&scan_filters[i], ad[1], &ad[2], ad_len - 1)) {
+				return true;
+			}
+		}
+
+		ad += ad_len + 1;
+		len -= ad_len + 1;
+	}
+
+	return false;
+}
+
+int bt_le_scan_filter_add(const struct bt_le_scan_filter *filter)
+{
+	CHECKIF(filter == NULL) {
+		LOG_DBG("filter is NULL");
+		return -EINVAL;
+	}
+
+	switch (filter->type) {
+	case BT_LE_SCAN_FILTER_ADDR:
+	case BT_LE_SCAN_FILTER_AD_TYPE:
+	case BT_LE_SCAN_FILTER_MANUFACTURER_ID:
+		break;
+	case BT_LE_SCAN_FILTER_NAME_PREFIX:
+		CHECKIF(filter->name_prefix == NULL) {
+			LOG_DBG("name_prefix is NULL");
+			return -EINVAL;
+		}
+		break;
+	case BT_LE_SCAN_FILTER_UUID:
+		CHECKIF(filter->uuid == NULL) {
+			LOG_DBG("uuid is NULL");
+			return -EINVAL;
+		}
+		break;
+	default:
+		LOG_DBG("Invalid filter type %d", filter->type);
+		return -EINVAL;
+	}
+
+	/* The filters are read from the RX context without locking */
+	if (atomic_get(scan_state.scan_flags) != 0) {
+		return -EBUSY;
+	}
+
+	if (scan_filter_cnt == ARRAY_SIZE(scan_filters)) {
+		return -ENOMEM;
+	}
+
+	scan_filters[scan_filter_cnt++] = *filter;
+
+	return 0;
+}
+
+int bt_le_scan_filter_clear(void)
+{
+	if (atomic_get(scan_state.scan_flags) != 0) {
+		return -EBUSY;
+	}
+
+	scan_filter_cnt = 0U;
+
+	return 0;
+}
+#endif /* defined(CONFIG_BT_SCAN_FILTER) */
+
 static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 			struct net_buf_simple *buf, uint16_t len)
 {
@@ -632,6 +939,10 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 	bt_addr_le_t id_addr;
 	bool explicit_scan = atomic_test_bit(scan_state.scan_flags, BT_LE_SCAN_USER_EXPLICIT_SCAN);
 	bool conn_scan     = atomic_test_bit(scan_state.scan_flags, BT_LE_SCAN_USER_CONN);
+#if defined(CONFIG_BT_SCAN_FILTER)
+	/* Evaluated for the first filtered listener, negative until then */
+	int filter_match = -1;
+#endif /* defined(CONFIG_BT_SCAN_FILTER) */
 
 	LOG_DBG("%s event %u, len %u, rssi %d dBm", bt_addr_le_str(addr), info->adv_type, len,
 		info->rssi);
@@ -670,6 +981,18 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 	info->addr = &id_addr;
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&scan_cbs, listener, next, node) {
+#if defined(CONFIG_BT_SCAN_FILTER)
+		if (listener->filtered) {
+			if (filter_match < 0) {
+				filter_match = scan_filter_match(&id_addr, buf->data, len);
+			}
+
+			if (!filter_match) {
+				continue;
+			}
+		}
+#endif /* defined(CONFIG_BT_SCAN_FILTER) */
+
 		if (listener->recv) {
 			net_buf_simple_save(buf, &state);
 
@@ -824,7 +1147,7 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 		uint16_t evt_type;
 		bool is_report_complete;
 		bool more_to_come;
-		bool is_new_advertiser;
+		struct fragmented_advertiser *adv;
 
 		if (!explicit_scan) {
 			/* The application has not requested explicit scan, so it is not expecting
@@ -836,9 +1159,7 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			 * However, if scanning is running for connection purposes,
 			 * the report shall still be processed to allow pending connections.
 			 */
-			if (reassembling_advertiser.state != FRAG_ADV_INACTIVE) {
-				reset_reassembling_advertiser();
-			}
+			reset_reassembling_advertisers();
 
 			if (!conn_scan) {
 				break;
@@ -867,9 +1188,16 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 
 			/* Start discarding irrespective of the `more_to_come` flag. We
 			 * assume we may have lost a partial adv report in the truncated
-			 * data.
+			 * data, from any of the advertisers being reassembled.
 			 */
-			reassembling_advertiser.state = FRAG_ADV_DISCARDING;
+			for (size_t i = 0; i < ARRAY_SIZE(reassembling_advertisers); i++) {
+				adv = &reassembling_advertisers[i];
+
+				if (adv->state == FRAG_ADV_REASSEMBLING) {
+					reassembly_stats.discarded++;
+					adv->state = FRAG_ADV_DISCARDING;
+				}
+			}
 
 			return;
 		}
@@ -883,11 +1211,14 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			goto cont;
 		}
 
-		is_new_advertiser = reassembling_advertiser.state == FRAG_ADV_INACTIVE ||
-				    !fragmented_advertisers_equal(&reassembling_advertiser,
-								  &evt->addr, evt->sid);
+		adv = find_reassembling_advertiser(&evt->addr, evt->sid);
+
+		if (adv == NULL && evicted_advertiser_report(&evt->addr, evt->sid, more_to_come)) {
+			/* The start of this chain was evicted */
+			goto cont;
+		}
 
-		if (is_new_advertiser && is_report_complete) {
+		if (adv == NULL && is_report_complete) {
 			/* Only advertising report from this advertiser.
 			 * Create event immediately.
 			 */
@@ -896,15 +1227,6 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			goto cont;
 		}
 
-		if (is_new_advertiser && reassembling_advertiser.state == FRAG_ADV_REASSEMBLING) {
-			LOG_WRN("Received an incomplete advertising report while reassembling "
-				"advertising reports from a different advertiser. The advertising "
-				"report is discarded and future scan results may be incomplete. "
-				"Interleaving of fragmented advertising reports from different "
-				"advertisers is not yet supported.");
-			goto cont;
-		}
-
 		if (data_status == BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_INCOMPLETE) {
 			/* Got HCI_LE_Extended_Advertising_Report: Incomplete, data truncated, no
 			 * more to come. This means the Controller is aborting the reassembly. We
@@ -915,51 +1237,57 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			 * Hint: CONFIG_BT_CTLR_SCAN_DATA_LEN_MAX.
 			 */
 			LOG_DBG("Discarding incomplete advertisement.");
-			reset_reassembling_advertiser();
+			if (adv != NULL) {
+				reset_reassembling_advertiser(adv);
+			}
 			goto cont;
 		}
 
-		if (is_new_advertiser) {
-			/* We are not reassembling reports from an advertiser and
-			 * this is the first report from the new advertiser.
+		if (adv == NULL) {
+			/* This is the first report from a new advertiser.
 			 * Initialize the new advertiser.
 			 */
-			__ASSERT_NO_MSG(reassembling_advertiser.state == FRAG_ADV_INACTIVE);
-			init_reassembling_advertiser(&evt->addr, evt->sid);
+			adv = init_reassembling_advertiser(&evt->addr, evt->sid);
 		}
 
-		if (evt->length + ext_scan_buf.len > ext_scan_buf.size) {
+		if (adv->state == FRAG_ADV_REASSEMBLING &&
+		    evt->length + adv->buf.len > adv->buf.size) {
 			/* The report does not fit in the reassembly buffer
 			 * Discard this and future reports from the advertiser.
 			 */
-			reassembling_advertiser.state = FRAG_ADV_DISCARDING;
+			reassembly_stats.discarded++;
+			adv->state = FRAG_ADV_DISCARDING;
 		}
 
-		if (reassembling_advertiser.state == FRAG_ADV_DISCARDING) {
+		if (adv->state == FRAG_ADV_DISCARDING) {
 			if (!more_to_come) {
 				/* We do no longer need to keep track of this advertiser as
 				 * all the expected data is received.
 				 */
-				reset_reassembling_advertiser();
+				reset_reassembling_advertiser(adv);
 			}
 			goto cont;
 		}
 
-		net_buf_simple_add_mem(&ext_scan_buf, buf->data, evt->length);
+		net_buf_simple_add_mem(&adv->buf, buf->data, evt->length);
+		adv->last_used = reassembly_seq++;
 		if (more_to_come) {
 			/* The controller will send additional reports to be reassembled */
-			continue;
+			goto cont;
 		}
 
 		/* No more data coming from the controller.
 		 * Create event.
+		 *
+		 * We do no longer need to keep track of this advertiser. The context is released
+		 * before the callback, which may stop the scanner, but its buffer is not reused
+		 * until the next report is processed.
 		 */
 		__ASSERT_NO_MSG(is_report_complete);
+		adv->state = FRAG_ADV_INACTIVE;
+		reassembly_stats.completed++;
 		create_ext_adv_info(evt, &scan_info);
-		le_adv_recv(&evt->addr, &scan_info, &ext_scan_buf, ext_scan_buf.len);
-
-		/* We do no longer need to keep track of this advertiser. */
-		reset_reassembling_advertiser();
+		le_adv_recv(&evt->addr, &scan_info, &adv->buf, adv->buf.len);
 
 cont:
 		net_buf_pull(buf, evt->length);
@@ -1856,6 +2184,21 @@ void bt_le_scan_cb_unregister(struct bt_le_scan_cb *cb)
 	sys_slist_find_and_remove(&scan_cbs, &cb->node);
 }
 
+int bt_le_scan_reassembly_stats_get(struct bt_le_scan_reassembly_stats *stats)
+{
+	if (stats == NULL) {
+		return -EINVAL;
+	}
+
+#if defined(CONFIG_BT_EXT_ADV)
+	*stats = reassembly_stats;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 #if defined(CONFIG_BT_PER_ADV_SYNC)
 uint8_t bt_le_per_adv_sync_get_index(struct bt_le_per_adv_sync *per_adv_sync)
 {
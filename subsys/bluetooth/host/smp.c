@@ -207,6 +207,11 @@ struct bt_smp {
 	/* Remote key distribution */
 	uint8_t				remote_dist;
 
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	/* Local Public Key taken from the ECC key pool for this pairing */
+	const uint8_t			*pool_pkey;
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
 	/* The channel this context is associated with.
 	 * This marks the beginning of the part of the structure that will not
 	 * be memset to zero in init.
@@ -297,6 +302,40 @@ static bool legacy_oobd_present;
 static bool sc_supported;
 static const uint8_t *sc_public_key;
 
+/* Local Public Key used by the LE SC pairing on this context */
+static const uint8_t *sc_local_pkey(struct bt_smp *smp)
+{
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	if (smp->pool_pkey) {
+		return smp->pool_pkey;
+	}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+
+	return sc_public_key;
+}
+
+static void sc_pool_pkey_take(struct bt_smp *smp)
+{
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	/* Local OOB data is bound to the device Public Key, so OOB pairing
+	 * keeps using that one. Fall back to it as well if the pool is empty.
+	 */
+	if (!smp->pool_pkey && smp->method != LE_SC_OOB) {
+		smp->pool_pkey = bt_pub_key_pool_take();
+	}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+}
+
+static void sc_pool_pkey_release(struct bt_smp *smp)
+{
+#if CONFIG_BT_ECC_KEY_POOL_SIZE > 0
+	if (smp->pool_pkey) {
+		bt_pub_key_pool_release(smp->pool_pkey);
+		smp->pool_pkey = NULL;
+	}
+#endif /* CONFIG_BT_ECC_KEY_POOL_SIZE > 0 */
+}
+
 static void bt_smp_pkey_ready(const uint8_t *pkey);
 static struct {
 	struct k_mutex lock;
@@ -1907,6 +1946,8 @@ static void smp_reset(struct bt_smp *smp)
 	 */
 	(void)k_work_cancel_delayable(&smp->work);
 
+	sc_pool_pkey_release(smp);
+
 	smp->method = JUST_WORKS;
 	atomic_set(smp->allowed_cmds, 0);
 
@@ -2220,7 +2261,7 @@ static uint8_t smp_send_pairing_confirm(struct bt_smp *smp)
 
 	req = net_buf_add(buf, sizeof(*req));
 
-	if (bt_crypto_f4(sc_public_key, smp->pkey, smp->prnd, r, req->val)) {
+	if (bt_crypto_f4(sc_local_pkey(smp), smp->pkey, smp->prnd, r, req->val)) {
 		net_buf_unref(buf);
 		return BT_SMP_ERR_UNSPECIFIED;
 	}
@@ -2884,6 +2925,8 @@ static uint8_t smp_central_ident(struct bt_smp *smp, struct net_buf *buf)
 
 static int smp_init(struct bt_smp *smp)
 {
+	sc_pool_pkey_release(smp);
+
 	/* Initialize SMP context excluding L2CAP channel context and anything
 	 * else declared after.
 	 */
@@ -3335,6 +3378,7 @@ static uint8_t sc_send_public_key(struct bt_smp *smp)
 {
 	struct bt_smp_public_key *req;
 	struct net_buf *req_buf;
+	const uint8_t *pkey;
 
 	req_buf = smp_create_pdu(smp, BT_SMP_CMD_PUBLIC_KEY, sizeof(*req));
 	if (!req_buf) {
@@ -3343,8 +3387,11 @@ static uint8_t sc_send_public_key(struct bt_smp *smp)
 
 	req = net_buf_add(req_buf, sizeof(*req));
 
-	memcpy(req->x, sc_public_key, sizeof(req->x));
-	memcpy(req->y, &sc_public_key[32], sizeof(req->y));
+	sc_pool_pkey_take(smp);
+	pkey = sc_local_pkey(smp);
+
+	memcpy(req->x, pkey, sizeof(req->x));
+	memcpy(req->y, &pkey[32], sizeof(req->y));
 
 	smp_send(smp, req_buf, NULL, NULL);
 
@@ -3764,7 +3811,7 @@ static uint8_t smp_dhkey_generate(struct bt_smp *smp)
 	int err;
 
 	atomic_set_bit(smp->flags, SMP_FLAG_DHKEY_GEN);
-	err = bt_dh_key_gen(smp->pkey, bt_smp_dhkey_ready);
+	err = bt_dh_key_gen(sc_local_pkey(smp), smp->pkey, bt_smp_dhkey_ready);
 	if (err) {
 		atomic_clear_bit(smp->flags, SMP_FLAG_DHKEY_GEN);
 
@@ -3878,7 +3925,7 @@ static uint8_t sc_smp_check_confirm(struct bt_smp *smp)
 		return BT_SMP_ERR_UNSPECIFIED;
 	}
 
-	if (bt_crypto_f4(smp->pkey, sc_public_key, smp->rrnd, r, cfm)) {
+	if (bt_crypto_f4(smp->pkey, sc_local_pkey(smp), smp->rrnd, r, cfm)) {
 		LOG_ERR("Calculate confirm failed");
 		return BT_SMP_ERR_UNSPECIFIED;
 	}
@@ -3965,7 +4012,7 @@ static uint8_t smp_pairing_random(struct bt_smp *smp, struct net_buf *buf)
 		switch (smp->method) {
 		case PASSKEY_CONFIRM:
 			/* compare passkey before calculating LTK */
-			if (bt_crypto_g2(sc_public_key, smp->pkey, smp->prnd, smp->rrnd,
+			if (bt_crypto_g2(sc_local_pkey(smp), smp->pkey, smp->prnd, smp->rrnd,
 					 &passkey)) {
 				return BT_SMP_ERR_UNSPECIFIED;
 			}
@@ -4010,7 +4057,7 @@ static uint8_t smp_pairing_random(struct bt_smp *smp, struct net_buf *buf)
 #if defined(CONFIG_BT_PERIPHERAL)
 	switch (smp->method) {
 	case PASSKEY_CONFIRM:
-		if (bt_crypto_g2(smp->pkey, sc_public_key, smp->rrnd, smp->prnd, &passkey)) {
+		if (bt_crypto_g2(smp->pkey, sc_local_pkey(smp), smp->rrnd, smp->prnd, &passkey)) {
 			return BT_SMP_ERR_UNSPECIFIED;
 		}
 
@@ -4181,7 +4228,7 @@ static void convert_to_id_on_match(struct bt_conn *conn, void *data)
 		bt_addr_le_copy(&conn->le.dst, addr_match->id_addr);
 
 		if (conn->le.keys && conn->le.keys != addr_match->keys) {
-			bt_addr_le_copy(&conn->le.keys->addr, addr_match->id_addr);
+			bt_keys_set_addr(conn->le.keys, addr_match->id_addr);
 		}
 	}
 }
@@ -4256,7 +4303,7 @@ static uint8_t smp_ident_addr_info(struct bt_smp *smp, struct net_buf *buf)
 				bt_conn_foreach(BT_CONN_TYPE_LE,
 						convert_to_id_on_match,
 						&addr_match);
-				bt_addr_le_copy(&keys->addr, &req->addr);
+				bt_keys_set_addr(keys, &req->addr);
 
 				bt_conn_identity_resolved(conn);
 			}
@@ -4505,8 +4552,10 @@ static uint8_t smp_public_key_periph(struct bt_smp *smp)
 	const struct bt_conn_auth_cb *smp_auth_cb = latch_auth_cb(smp);
 	uint8_t err;
 
+	sc_pool_pkey_take(smp);
+
 	if (!atomic_test_bit(smp->flags, SMP_FLAG_SC_DEBUG_KEY) &&
-	    memcmp(smp->pkey, sc_public_key, BT_PUB_KEY_COORD_LEN) == 0) {
+	    memcmp(smp->pkey, sc_local_pkey(smp), BT_PUB_KEY_COORD_LEN) == 0) {
 		/* Deny public key with identical X coordinate unless it is the
 		 * debug public key.
 		 */
@@ -4592,7 +4641,7 @@ static uint8_t smp_public_key(struct bt_smp *smp, struct net_buf *buf)
 	if (IS_ENABLED(CONFIG_BT_CENTRAL) &&
 	    smp->chan.chan.conn->role == BT_HCI_ROLE_CENTRAL) {
 		if (!atomic_test_bit(smp->flags, SMP_FLAG_SC_DEBUG_KEY) &&
-		    memcmp(smp->pkey, sc_public_key, BT_PUB_KEY_COORD_LEN) == 0) {
+		    memcmp(smp->pkey, sc_local_pkey(smp), BT_PUB_KEY_COORD_LEN) == 0) {
 			/* Deny public key with identical X coordinate unless
 			 * it is the debug public key.
 			 */
@@ -5010,6 +5059,8 @@ static void bt_smp_disconnected(struct bt_l2cap_chan *chan)
 		}
 	}
 
+	sc_pool_pkey_release(smp);
+
 	(void)memset(smp, 0, sizeof(*smp));
 }
 
@@ -106,6 +106,26 @@ static struct mod_relation mod_rel_list[MOD_REL_LIST_SIZE];
 
 #define RELATION_TYPE_EXT 0xFF
 
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+/* OpCode handlers of all elements, sorted by element index and OpCode */
+struct op_table_entry {
+	uint32_t key;
+	const struct bt_mesh_model *mod;
+	const struct bt_mesh_model_op *op;
+};
+
+/* Element index in the top byte, OpCodes are at most 3 octets long */
+#define OP_TABLE_KEY(elem_idx, opcode) (((uint32_t)(elem_idx) << 24) | (opcode))
+
+static struct op_table_entry op_table[CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE];
+/* Number of entries in use, 0 if the linear lookup is used */
+static size_t op_table_cnt;
+#endif
+
+#if defined(CONFIG_BT_MESH_ACCESS_SUB_FILTER)
+#define SUB_FILTER_BIT(addr) BIT64(((uint32_t)(addr) * 0x9e3779b1U) >> 26)
+#endif
+
 static const struct {
 	uint8_t *path;
 	uint8_t page;
@@ -1014,6 +1034,139 @@ static int bt_mesh_vnd_mod_msg_cid_check(const struct bt_mesh_model *mod)
 }
 #endif
 
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+/* Index of the first entry with a key equal to or greater than the given key */
+static size_t op_table_lower_bound(uint32_t key)
+{
+	size_t lo = 0;
+	size_t hi = op_table_cnt;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi) / 2;
+
+		if (op_table[mid].key < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static int op_table_add(const struct bt_mesh_model *mod, const struct bt_mesh_model_op *op)
+{
+	uint32_t key = OP_TABLE_KEY(mod->rt->elem_idx, op->opcode);
+	size_t i = op_table_lower_bound(key);
+
+	/* The linear lookup picks the first model with a matching OpCode, so
+	 * later models with the same OpCode in the element are never reached.
+	 */
+	if (i < op_table_cnt && op_table[i].key == key) {
+		return 0;
+	}
+
+	if (op_table_cnt == ARRAY_SIZE(op_table)) {
+		return -ENOMEM;
+	}
+
+	memmove(&op_table[i + 1], &op_table[i], (op_table_cnt - i) * sizeof(op_table[0]));
+	op_table[i].key = key;
+	op_table[i].mod = mod;
+	op_table[i].op = op;
+	op_table_cnt++;
+
+	return 0;
+}
+
+static int op_table_add_models(const struct bt_mesh_model *models, uint8_t count, bool vnd)
+{
+	int err;
+
+	for (int i = 0; i < count; i++) {
+		for (const struct bt_mesh_model_op *op = models[i].op; op->func; op++) {
+			/* SIG models are only looked up for SIG (1- or 2-octet)
+			 * OpCodes, and vendor models for 3-octet OpCodes.
+			 */
+			if ((BT_MESH_MODEL_OP_LEN(op->opcode) == 3) != vnd) {
+				continue;
+			}
+
+			err = op_table_add(&models[i], op);
+			if (err) {
+				return err;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static void op_table_build(void)
+{
+	int err = 0;
+
+	op_table_cnt = 0;
+
+	for (int i = 0; i < dev_comp->elem_count && !err; i++) {
+		const struct bt_mesh_elem *elem = &dev_comp->elem[i];
+
+		err = op_table_add_models(elem->models, elem->model_count, false);
+		if (!err) {
+			err = op_table_add_models(elem->vnd_models, elem->vnd_model_count, true);
+		}
+	}
+
+	if (err) {
+		LOG_WRN("OpCode table too small, using linear lookup");
+		op_table_cnt = 0;
+		return;
+	}
+
+	LOG_DBG("%zu OpCodes in lookup table", op_table_cnt);
+}
+#endif /* CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0 */
+
+#if defined(CONFIG_BT_MESH_ACCESS_SUB_FILTER)
+static uint64_t models_sub_filter(const struct bt_mesh_model *models, uint8_t count)
+{
+	uint64_t filter = 0;
+
+	for (int i = 0; i < count; i++) {
+		for (int j = 0; j < models[i].groups_cnt; j++) {
+			if (models[i].groups[j] != BT_MESH_ADDR_UNASSIGNED) {
+				filter |= SUB_FILTER_BIT(models[i].groups[j]);
+			}
+		}
+	}
+
+	return filter;
+}
+
+static void elem_sub_filter_update(const struct bt_mesh_elem *elem)
+{
+	elem->rt->sub_filter = models_sub_filter(elem->models, elem->model_count) |
+			       models_sub_filter(elem->vnd_models, elem->vnd_model_count);
+}
+#endif
+
+/* Whether any model on the element may be subscribed to the address */
+static bool elem_sub_filter_match(const struct bt_mesh_elem *elem, uint16_t addr)
+{
+#if defined(CONFIG_BT_MESH_ACCESS_SUB_FILTER)
+	return !!(elem->rt->sub_filter & SUB_FILTER_BIT(addr));
+#else
+	return true;
+#endif
+}
+
+void bt_mesh_model_sub_changed(const struct bt_mesh_model *mod)
+{
+#if defined(CONFIG_BT_MESH_ACCESS_SUB_FILTER)
+	elem_sub_filter_update(&dev_comp->elem[mod->rt->elem_idx]);
+#endif
+}
+
 static void mod_init(const struct bt_mesh_model *mod, const struct bt_mesh_elem *elem,
 		     bool vnd, bool primary, void *user_data)
 {
@@ -1072,6 +1225,19 @@ int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 
 	bt_mesh_model_foreach(mod_init, &err);
 
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+	op_table_cnt = 0;
+	if (!err) {
+		op_table_build();
+	}
+#endif
+
+#if defined(CONFIG_BT_MESH_ACCESS_SUB_FILTER)
+	for (int i = 0; i < comp->elem_count; i++) {
+		elem_sub_filter_update(&comp->elem[i]);
+	}
+#endif
+
 	if (MOD_REL_LIST_SIZE > 0) {
 		int i;
 
@@ -1262,6 +1428,10 @@ static const struct bt_mesh_model *bt_mesh_elem_find_group(const struct bt_mesh_
 	uint16_t *match;
 	int i;
 
+	if (!elem_sub_filter_match(elem, group_addr)) {
+		return NULL;
+	}
+
 	for (i = 0; i < elem->model_count; i++) {
 		model = &elem->models[i];
 
@@ -1378,6 +1548,9 @@ static bool model_has_dst(const struct bt_mesh_model *mod, uint16_t dst, const u
 		return !!bt_mesh_model_find_uuid(&mod, uuid);
 	} else if (BT_MESH_ADDR_IS_GROUP(dst) ||
 		  (BT_MESH_ADDR_IS_FIXED_GROUP(dst) &&  mod->rt->elem_idx != 0)) {
+		/* Subscriptions are shared across the extension tree, which
+		 * the element filter doesn't follow, so walk the model lists.
+		 */
 		return !!bt_mesh_model_find_group(&mod, dst);
 	}
 
@@ -1397,6 +1570,24 @@ static const struct bt_mesh_model_op *find_op(const struct bt_mesh_elem *elem,
 	uint32_t cid = UINT32_MAX;
 	const struct bt_mesh_model *models;
 
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+	/* When the CID is enforced, registration fails if a vendor model
+	 * has OpCodes with a foreign CID, so the table needs no CID check.
+	 */
+	if (op_table_cnt) {
+		uint32_t key = OP_TABLE_KEY(elem - dev_comp->elem, opcode);
+		size_t idx = op_table_lower_bound(key);
+
+		if (idx < op_table_cnt && op_table[idx].key == key) {
+			*model = op_table[idx].mod;
+			return op_table[idx].op;
+		}
+
+		*model = NULL;
+		return NULL;
+	}
+#endif
+
 	/* SIG models cannot contain 3-byte (vendor) OpCodes, and
 	 * vendor models cannot contain SIG (1- or 2-byte) OpCodes, so
 	 * we only need to do the lookup in one of the model lists.
@@ -1907,6 +2098,8 @@ static int mod_set_sub(const struct bt_mesh_model *mod, size_t len_rd,
 
 	LOG_DBG("Decoded %zu subscribed group addresses for model", len / sizeof(mod->groups[0]));
 
+	bt_mesh_model_sub_changed(mod);
+
 	return 0;
 }
 
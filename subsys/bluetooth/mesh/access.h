@@ -40,6 +40,8 @@ void bt_mesh_model_extensions_walk(const struct bt_mesh_model *root,
 				   void *user_data);
 
 uint16_t *bt_mesh_model_find_group(const struct bt_mesh_model **mod, uint16_t addr);
+/* Must be called whenever the subscription list of a model has been modified */
+void bt_mesh_model_sub_changed(const struct bt_mesh_model *mod);
 const uint8_t **bt_mesh_model_find_uuid(const struct bt_mesh_model **mod, const uint8_t *uuid);
 
 void bt_mesh_model_foreach(void (*func)(const struct bt_mesh_model *mod,
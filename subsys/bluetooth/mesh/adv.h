@@ -55,6 +55,11 @@ struct bt_mesh_adv_ctx {
 		  tag:4;
 
 	uint8_t      xmit;
+
+#if defined(CONFIG_BT_MESH_STATISTIC)
+	/* Uptime when the advertisement was queued for sending */
+	uint32_t     timestamp;
+#endif
 };
 
 struct bt_mesh_adv {
@@ -21,6 +21,7 @@
 #include "net.h"
 #include "proxy.h"
 #include "solicitation.h"
+#include "statistic.h"
 
 #define LOG_LEVEL CONFIG_BT_MESH_ADV_LOG_LEVEL
 #include <zephyr/logging/log.h>
@@ -68,6 +69,9 @@ struct bt_mesh_ext_adv {
 	uint32_t timestamp;
 	struct k_work work;
 	struct bt_le_adv_param adv_param;
+#if defined(CONFIG_BT_MESH_STATISTIC)
+	struct bt_mesh_adv_set_statistic stat;
+#endif
 };
 
 static void send_pending_adv(struct k_work *work);
@@ -216,6 +220,24 @@ static int bt_data_send(struct bt_mesh_ext_adv *ext_adv, uint8_t num_events, uin
 	return adv_start(ext_adv, &ext_adv->adv_param, &start, ad, ad_len, NULL, 0);
 }
 
+static void adv_stat_start(struct bt_mesh_ext_adv *ext_adv, const struct bt_mesh_adv_ctx *ctx)
+{
+#if defined(CONFIG_BT_MESH_STATISTIC)
+	uint32_t latency = ext_adv->timestamp - ctx->timestamp;
+
+	ext_adv->stat.queue_latency += latency;
+	ext_adv->stat.queue_latency_max = MAX(ext_adv->stat.queue_latency_max, latency);
+#endif
+}
+
+static void adv_stat_end(struct bt_mesh_ext_adv *ext_adv)
+{
+#if defined(CONFIG_BT_MESH_STATISTIC)
+	ext_adv->stat.tx_count++;
+	ext_adv->stat.tx_time += k_uptime_get_32() - ext_adv->timestamp;
+#endif
+}
+
 static int adv_send(struct bt_mesh_ext_adv *ext_adv, struct bt_mesh_adv *adv)
 {
 	uint8_t num_events = BT_MESH_TRANSMIT_COUNT(adv->ctx.xmit) + 1;
@@ -239,6 +261,7 @@ static int adv_send(struct bt_mesh_ext_adv *ext_adv, struct bt_mesh_adv *adv)
 	err = bt_data_send(ext_adv, num_events, adv_int, &ad, 1);
 	if (!err) {
 		ext_adv->adv = bt_mesh_adv_ref(adv);
+		adv_stat_start(ext_adv, &adv->ctx);
 	}
 
 	bt_mesh_adv_send_start(duration, err, &adv->ctx);
@@ -362,6 +385,7 @@ static void send_pending_adv(struct k_work *work)
 		if (ext_adv->adv) {
 			struct bt_mesh_adv_ctx ctx = ext_adv->adv->ctx;
 
+			adv_stat_end(ext_adv);
 			ext_adv->adv->ctx.started = 0;
 			bt_mesh_adv_unref(ext_adv->adv);
 			bt_mesh_adv_send_end(0, &ctx);
@@ -623,3 +647,23 @@ int bt_mesh_wq_submit(struct k_work *work)
 {
 	return k_work_submit_to_queue(MESH_WORKQ, work);
 }
+
+#if defined(CONFIG_BT_MESH_STATISTIC)
+int bt_mesh_adv_stat_get(uint8_t idx, struct bt_mesh_adv_set_statistic *st)
+{
+	if (idx >= ARRAY_SIZE(advs)) {
+		return -EINVAL;
+	}
+
+	*st = advs[idx].stat;
+
+	return 0;
+}
+
+void bt_mesh_adv_stat_reset(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(advs); i++) {
+		(void)memset(&advs[i].stat, 0, sizeof(advs[i].stat));
+	}
+}
+#endif /* CONFIG_BT_MESH_STATISTIC */
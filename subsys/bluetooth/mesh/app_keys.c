@@ -176,8 +176,38 @@ static void update_app_key_settings(uint16_t app_idx, bool store)
 	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_APP_KEYS_PENDING);
 }
 
+/* Application key credentials indexed by their AID, so that incoming access
+ * messages are only decrypted with the keys that can possibly match. Each
+ * AID holds a chain of credential slots, where slot n is keys[n % 2] of
+ * apps[n / 2]. Slots are stored as n + 1, with 0 terminating the chain.
+ */
+#define AID_SLOT_COUNT (CONFIG_BT_MESH_APP_KEY_COUNT * 2)
+
+static uint16_t aid_head[BIT(6)];
+static uint16_t aid_next[AID_SLOT_COUNT];
+
+static void aid_index_update(void)
+{
+	(void)memset(aid_head, 0, sizeof(aid_head));
+
+	/* Walk backwards so that each chain keeps the key order. */
+	for (int i = AID_SLOT_COUNT - 1; i >= 0; i--) {
+		const struct app_key *app = &apps[i / 2];
+		uint8_t aid = app->keys[i % 2].id & BIT_MASK(6);
+
+		if (app->app_idx == BT_MESH_KEY_UNUSED || (i % 2 && !app->updated)) {
+			continue;
+		}
+
+		aid_next[i] = aid_head[aid];
+		aid_head[aid] = i + 1;
+	}
+}
+
 static void app_key_evt(struct app_key *app, enum bt_mesh_key_evt evt)
 {
+	aid_index_update();
+
 	STRUCT_SECTION_FOREACH(bt_mesh_app_key_cb, cb) {
 		cb->evt_handler(app->app_idx, app->net_idx, evt);
 	}
@@ -216,6 +246,8 @@ static void app_key_del(struct app_key *app)
 	bt_mesh_key_destroy(&app->keys[0].val);
 	bt_mesh_key_destroy(&app->keys[1].val);
 	memset(app->keys, 0, sizeof(app->keys));
+
+	aid_index_update();
 }
 
 static void app_key_revoke(struct app_key *app)
@@ -424,6 +456,8 @@ int bt_mesh_app_key_set(uint16_t app_idx, uint16_t net_idx,
 	app->app_idx = app_idx;
 	app->updated = !!new_key;
 
+	aid_index_update();
+
 	return 0;
 }
 
@@ -583,22 +617,18 @@ uint16_t bt_mesh_app_key_find(bool dev_key, uint8_t aid,
 		return BT_MESH_KEY_UNUSED;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(apps); i++) {
-		const struct app_key *app = &apps[i];
-		const struct bt_mesh_app_cred *cred;
-
-		if (app->app_idx == BT_MESH_KEY_UNUSED) {
-			continue;
-		}
+	/* Only the credentials with a matching AID are tried */
+	for (i = aid_head[aid & BIT_MASK(6)]; i; i = aid_next[i - 1]) {
+		const struct app_key *app = &apps[(i - 1) / 2];
+		const struct bt_mesh_app_cred *cred = &app->keys[(i - 1) % 2];
 
 		if (app->net_idx != rx->sub->net_idx) {
 			continue;
 		}
 
-		if (rx->new_key && app->updated) {
-			cred = &app->keys[1];
-		} else {
-			cred = &app->keys[0];
+		/* The new key is only used on the new network key */
+		if (((i - 1) % 2) != (rx->new_key && app->updated)) {
+			continue;
 		}
 
 		if (cred->id != aid) {
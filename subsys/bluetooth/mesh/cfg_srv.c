@@ -1004,6 +1004,7 @@ static int mod_sub_add(const struct bt_mesh_model *model,
 	}
 
 	*entry = sub_addr;
+	bt_mesh_model_sub_changed(mod);
 	status = STATUS_SUCCESS;
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
@@ -1080,6 +1081,7 @@ static int mod_sub_del(const struct bt_mesh_model *model,
 	match = bt_mesh_model_find_group(&mod, sub_addr);
 	if (match) {
 		*match = BT_MESH_ADDR_UNASSIGNED;
+		bt_mesh_model_sub_changed(mod);
 
 		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 			bt_mesh_model_sub_store(mod);
@@ -1154,6 +1156,7 @@ static int mod_sub_overwrite(const struct bt_mesh_model *model,
 		bt_mesh_model_extensions_walk(mod, mod_sub_clear_visitor, NULL);
 
 		mod->groups[0] = sub_addr;
+		bt_mesh_model_sub_changed(mod);
 		status = STATUS_SUCCESS;
 
 		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
@@ -1214,6 +1217,7 @@ static int mod_sub_del_all(const struct bt_mesh_model *model,
 	}
 
 	bt_mesh_model_extensions_walk(mod, mod_sub_clear_visitor, NULL);
+	bt_mesh_model_sub_changed(mod);
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_model_sub_store(mod);
@@ -1460,6 +1464,7 @@ static int mod_sub_va_add(const struct bt_mesh_model *model,
 
 	*group_entry = va->addr;
 	*label_entry = va->uuid;
+	bt_mesh_model_sub_changed(mod);
 
 	if (IS_ENABLED(CONFIG_BT_MESH_LOW_POWER) && va->ref == 1 &&
 	    !bt_mesh_va_collision_check(va->addr)) {
@@ -1548,6 +1553,7 @@ static int mod_sub_va_del(const struct bt_mesh_model *model,
 	}
 
 	*label_match = NULL;
+	bt_mesh_model_sub_changed(mod);
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_model_sub_store(mod);
@@ -1621,6 +1627,7 @@ static int mod_sub_va_overwrite(const struct bt_mesh_model *model,
 	bt_mesh_model_extensions_walk(mod, mod_sub_clear_visitor, NULL);
 	mod->groups[0] = va->addr;
 	mod->uuids[0] = va->uuid;
+	bt_mesh_model_sub_changed(mod);
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_model_sub_store(mod);
@@ -2541,6 +2548,9 @@ static void mod_reset(const struct bt_mesh_model *mod, const struct bt_mesh_elem
 	 */
 
 	clear_count = mod_sub_list_clear(mod);
+	if (clear_count) {
+		bt_mesh_model_sub_changed(mod);
+	}
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		if (clear_count) {
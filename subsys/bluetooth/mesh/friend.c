@@ -39,9 +39,12 @@ LOG_MODULE_REGISTER(bt_mesh_friend);
 
 /* We reserve one extra buffer for each friendship, since we need to be able
  * to resend the last sent PDU, which sits separately outside of the queue.
+ * The shared buffers come on top, and are used by the Friend Queues that
+ * have run out of their reserved buffers.
  */
 #define FRIEND_BUF_COUNT    ((CONFIG_BT_MESH_FRIEND_QUEUE_SIZE + 1) * \
-			     CONFIG_BT_MESH_FRIEND_LPN_COUNT)
+			     CONFIG_BT_MESH_FRIEND_LPN_COUNT + \
+			     CONFIG_BT_MESH_FRIEND_QUEUE_SHARED_SIZE)
 
 /* PDUs from Friend to the LPN should only be transmitted once with the
  * smallest possible interval (20ms).
@@ -61,6 +64,7 @@ struct friend_pdu_info {
 };
 
 BUILD_ASSERT(CONFIG_BT_MESH_LABEL_COUNT <= 0xFFFU, "Friend doesn't support more than 4096 labels.");
+BUILD_ASSERT(FRIEND_BUF_COUNT <= UINT16_MAX, "Too many Friend Queue buffers.");
 
 struct friend_adv {
 	uint16_t app_idx;
@@ -1576,13 +1580,68 @@ bool bt_mesh_friend_match(uint16_t net_idx, uint16_t addr)
 	return false;
 }
 
+/* Number of buffers taken by the Friend Queue, including the ones held for
+ * the segmented messages being received, except for the given message.
+ */
+static uint32_t friend_queue_usage(struct bt_mesh_friend *frnd, uint16_t addr,
+				   const uint64_t *seq_auth)
+{
+	uint32_t used = frnd->queue_size;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(frnd->seg); i++) {
+		struct bt_mesh_friend_seg *seg = &frnd->seg[i];
+
+		if (seq_auth && is_seg(seg, addr, *seq_auth & TRANS_SEQ_ZERO_MASK)) {
+			continue;
+		}
+
+		used += seg->seg_count;
+	}
+
+	return used;
+}
+
+/* Maximum number of buffers in the Friend Queue: the reserved buffers of the
+ * LPN and the shared buffers not already taken by the other Friend Queues.
+ */
+static uint32_t friend_queue_limit(struct bt_mesh_friend *frnd)
+{
+#if CONFIG_BT_MESH_FRIEND_QUEUE_SHARED_SIZE > 0
+	uint32_t shared_used = 0;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(bt_mesh.frnd); i++) {
+		struct bt_mesh_friend *other = &bt_mesh.frnd[i];
+		uint32_t used;
+
+		if (other == frnd) {
+			continue;
+		}
+
+		used = friend_queue_usage(other, BT_MESH_ADDR_UNASSIGNED, NULL);
+		if (used > CONFIG_BT_MESH_FRIEND_QUEUE_SIZE) {
+			shared_used += used - CONFIG_BT_MESH_FRIEND_QUEUE_SIZE;
+		}
+	}
+
+	if (shared_used < CONFIG_BT_MESH_FRIEND_QUEUE_SHARED_SIZE) {
+		return CONFIG_BT_MESH_FRIEND_QUEUE_SIZE +
+		       CONFIG_BT_MESH_FRIEND_QUEUE_SHARED_SIZE - shared_used;
+	}
+#endif
+
+	return CONFIG_BT_MESH_FRIEND_QUEUE_SIZE;
+}
+
 static bool friend_queue_has_space(struct bt_mesh_friend *frnd, uint16_t addr,
 				   const uint64_t *seq_auth, uint8_t seg_count)
 {
+	uint32_t limit = friend_queue_limit(frnd);
 	uint32_t total = 0;
 	int i;
 
-	if (seg_count > CONFIG_BT_MESH_FRIEND_QUEUE_SIZE) {
+	if (seg_count > limit) {
 		return false;
 	}
 
@@ -1600,11 +1659,12 @@ static bool friend_queue_has_space(struct bt_mesh_friend *frnd, uint16_t addr,
 	}
 
 	/* If currently pending segments combined with this segmented message
-	 * are more than the Friend Queue Size, then there's no space. This
-	 * is because we don't have a mechanism of aborting already pending
-	 * segmented messages to free up buffers.
+	 * are more than the Friend Queue limit, including the free shared
+	 * buffers, then there's no space. This is because we don't have a
+	 * mechanism of aborting already pending segmented messages to free up
+	 * buffers.
 	 */
-	return (CONFIG_BT_MESH_FRIEND_QUEUE_SIZE - total) > seg_count;
+	return total + seg_count < limit;
 }
 
 bool bt_mesh_friend_queue_has_space(uint16_t net_idx, uint16_t src, uint16_t dst,
@@ -1666,13 +1726,17 @@ static bool friend_queue_prepare_space(struct bt_mesh_friend *frnd, uint16_t add
 				       const uint64_t *seq_auth, uint8_t seg_count)
 {
 	bool pending_segments;
-	uint8_t avail_space;
+	uint32_t avail_space;
+	uint32_t limit;
+	uint32_t used;
 
 	if (!friend_queue_has_space(frnd, addr, seq_auth, seg_count)) {
 		return false;
 	}
 
-	avail_space = CONFIG_BT_MESH_FRIEND_QUEUE_SIZE - frnd->queue_size;
+	limit = friend_queue_limit(frnd);
+	used = friend_queue_usage(frnd, addr, seq_auth);
+	avail_space = limit > used ? limit - used : 0;
 	pending_segments = false;
 
 	while (pending_segments || avail_space < seg_count) {
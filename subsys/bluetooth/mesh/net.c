@@ -80,12 +80,26 @@ struct iv_val {
 	      iv_duration:7;
 } __packed;
 
+/* The network message cache and the duplicate filter are FIFO rings. Each
+ * ring has an open addressing (linear probing) index of ring slot + 1 values,
+ * sized to keep the load factor at or below one half, so that a lookup does
+ * not have to scan the whole ring for every received PDU.
+ */
+#define MSG_CACHE_BUCKETS     NHPOT(2 * CONFIG_BT_MESH_MSG_CACHE_SIZE)
+#define MSG_CACHE_BUCKET_MASK (MSG_CACHE_BUCKETS - 1)
+
+struct msg_cache_ring {
+	uint16_t next;
+	uint16_t count;
+	uint16_t index[MSG_CACHE_BUCKETS];
+};
+
 static struct {
 	uint32_t src : 15, /* MSb of source is always 0 */
 		 seq : 17;
 	uint16_t net_idx;
 } msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static uint16_t msg_cache_next;
+static struct msg_cache_ring msg_cache_ring;
 
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
@@ -118,50 +132,134 @@ K_MEM_SLAB_DEFINE(loopback_buf_pool,
 		  CONFIG_BT_MESH_LOOPBACK_BUFS, __alignof__(struct loopback_buf));
 
 static uint32_t dup_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static int   dup_cache_next;
+static struct msg_cache_ring dup_cache_ring;
+
+static inline uint32_t cache_bucket(uint32_t key)
+{
+	/* Fibonacci hashing, spreads sequential SEQ and SRC values. */
+	return (key * 0x9e3779b1U) >> (32 - LOG2CEIL(MSG_CACHE_BUCKETS));
+}
+
+static inline uint32_t cache_bucket_next(uint32_t bucket)
+{
+	return (bucket + 1) & MSG_CACHE_BUCKET_MASK;
+}
+
+static void cache_index_add(struct msg_cache_ring *ring, uint16_t slot, uint32_t key)
+{
+	uint32_t i;
+
+	for (i = cache_bucket(key); ring->index[i]; i = cache_bucket_next(i)) {
+	}
+
+	ring->index[i] = slot + 1;
+}
+
+static void cache_index_del(struct msg_cache_ring *ring, uint16_t slot,
+			    uint32_t (*key_of)(uint16_t slot))
+{
+	uint32_t i, j;
+
+	for (i = cache_bucket(key_of(slot)); ring->index[i] != slot + 1;
+	     i = cache_bucket_next(i)) {
+	}
+
+	/* Backward shift deletion: move every following entry of the probe
+	 * sequence that may legally live in the hole, so no tombstones are
+	 * needed.
+	 */
+	for (j = cache_bucket_next(i); ring->index[j]; j = cache_bucket_next(j)) {
+		uint32_t home = cache_bucket(key_of(ring->index[j] - 1));
+
+		if (((j - home) & MSG_CACHE_BUCKET_MASK) >= ((j - i) & MSG_CACHE_BUCKET_MASK)) {
+			ring->index[i] = ring->index[j];
+			i = j;
+		}
+	}
+
+	ring->index[i] = 0U;
+}
+
+/* Claim the next ring slot, evicting the oldest entry if the ring is full. */
+static uint16_t cache_ring_push(struct msg_cache_ring *ring,
+				uint32_t (*key_of)(uint16_t slot))
+{
+	uint16_t slot = ring->next;
+
+	if (ring->count == CONFIG_BT_MESH_MSG_CACHE_SIZE) {
+		cache_index_del(ring, slot, key_of);
+	} else {
+		ring->count++;
+	}
+
+	ring->next = (slot + 1) % CONFIG_BT_MESH_MSG_CACHE_SIZE;
+
+	return slot;
+}
+
+/* Drop the most recently added entry. */
+static void cache_ring_pop(struct msg_cache_ring *ring, uint32_t (*key_of)(uint16_t slot))
+{
+	if (!ring->count) {
+		return;
+	}
+
+	ring->next = (ring->next + CONFIG_BT_MESH_MSG_CACHE_SIZE - 1) %
+		     CONFIG_BT_MESH_MSG_CACHE_SIZE;
+	ring->count--;
+	cache_index_del(ring, ring->next, key_of);
+}
+
+static uint32_t dup_cache_key(uint16_t slot)
+{
+	return dup_cache[slot];
+}
 
 static bool check_dup(struct net_buf_simple *data)
 {
 	const uint8_t *tail = net_buf_simple_tail(data);
+	uint16_t slot;
 	uint32_t val;
-	int i;
+	uint32_t i;
 
 	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
 
-	for (i = dup_cache_next; i > 0;) {
-		if (dup_cache[--i] == val) {
+	for (i = cache_bucket(val); dup_cache_ring.index[i]; i = cache_bucket_next(i)) {
+		if (dup_cache[dup_cache_ring.index[i] - 1] == val) {
 			return true;
 		}
 	}
 
-	for (i = ARRAY_SIZE(dup_cache); i > dup_cache_next;) {
-		if (dup_cache[--i] == val) {
-			return true;
-		}
-	}
-
-	dup_cache_next %= ARRAY_SIZE(dup_cache);
-	dup_cache[dup_cache_next++] = val;
+	slot = cache_ring_push(&dup_cache_ring, dup_cache_key);
+	dup_cache[slot] = val;
+	cache_index_add(&dup_cache_ring, slot, val);
 
 	return false;
 }
 
+static inline uint32_t msg_cache_key_make(uint16_t src, uint32_t seq, uint16_t net_idx)
+{
+	return ((seq & BIT_MASK(17)) << 15 | (src & BIT_MASK(15))) ^ ((uint32_t)net_idx << 20);
+}
+
+static uint32_t msg_cache_key(uint16_t slot)
+{
+	return msg_cache_key_make(msg_cache[slot].src, msg_cache[slot].seq,
+				  msg_cache[slot].net_idx);
+}
+
 static bool msg_cache_match(struct net_buf_simple *pdu, uint16_t net_idx)
 {
-	uint16_t i;
+	uint16_t src = SRC(pdu->data);
+	uint32_t seq = SEQ(pdu->data) & BIT_MASK(17);
+	uint32_t i;
 
-	for (i = msg_cache_next; i > 0U;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17)) &&
-		    msg_cache[i].net_idx == net_idx) {
-			return true;
-		}
-	}
+	for (i = cache_bucket(msg_cache_key_make(src, seq, net_idx)); msg_cache_ring.index[i];
+	     i = cache_bucket_next(i)) {
+		uint16_t slot = msg_cache_ring.index[i] - 1;
 
-	for (i = ARRAY_SIZE(msg_cache); i > msg_cache_next;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17)) &&
-		    msg_cache[i].net_idx == net_idx) {
+		if (msg_cache[slot].src == src && msg_cache[slot].seq == seq &&
+		    msg_cache[slot].net_idx == net_idx) {
 			return true;
 		}
 	}
@@ -171,11 +269,12 @@ static bool msg_cache_match(struct net_buf_simple *pdu, uint16_t net_idx)
 
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
-	msg_cache[msg_cache_next].src = rx->ctx.addr;
-	msg_cache[msg_cache_next].seq = rx->seq;
-	msg_cache[msg_cache_next].net_idx = rx->sub->net_idx;
-	msg_cache_next++;
+	uint16_t slot = cache_ring_push(&msg_cache_ring, msg_cache_key);
+
+	msg_cache[slot].src = rx->ctx.addr;
+	msg_cache[slot].seq = rx->seq;
+	msg_cache[slot].net_idx = rx->sub->net_idx;
+	cache_index_add(&msg_cache_ring, slot, msg_cache_key(slot));
 }
 
 static void store_iv(bool only_duration)
@@ -220,7 +319,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const struct bt_mesh_key *ke
 	}
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	(void)memset(&msg_cache_ring, 0, sizeof(msg_cache_ring));
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -914,9 +1013,11 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 		 * it again in the future.
 		 */
 		LOG_WRN("Removing rejected message from Network Message Cache");
-		/* Rewind the next index now that we're not using this entry */
-		msg_cache[--msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
-		dup_cache[--dup_cache_next] = 0;
+		/* Drop the entries added for this message */
+		cache_ring_pop(&msg_cache_ring, msg_cache_key);
+		if (net_if == BT_MESH_NET_IF_ADV) {
+			cache_ring_pop(&dup_cache_ring, dup_cache_key);
+		}
 		return;
 	} else if (err == -EBADMSG) {
 		LOG_DBG("Not relaying message rejected by the Transport layer");
@@ -13,6 +13,7 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 
 #include <zephyr/net_buf.h>
 #include <zephyr/bluetooth/bluetooth.h>
@@ -34,12 +35,47 @@ struct rpl_val {
 	      old_iv:1;
 };
 
+#if defined(CONFIG_BT_MESH_RPL_STORE_PAGED)
+#define RPL_PAGE_SIZE    CONFIG_BT_MESH_RPL_STORE_PAGE_SIZE
+#define RPL_PAGE_COUNT   DIV_ROUND_UP(CONFIG_BT_MESH_CRPL, RPL_PAGE_SIZE)
+#define RPL_PAGE_VERSION 1
+
+/* Page of Replay Protection List entries for persistent storage. A page is
+ * written as a single settings entry, and is only accepted on load if the
+ * CRC over the whole page matches, so an interrupted write never restores
+ * part of a page.
+ */
+struct rpl_page {
+	uint8_t version;
+	uint8_t count;
+	uint16_t crc;
+	struct {
+		uint16_t src_old_iv; /* Source address, old_iv in the MSb */
+		uint8_t seq[3];
+	} __packed entry[RPL_PAGE_SIZE];
+} __packed;
+
+static struct rpl_page page_buf;
+static ATOMIC_DEFINE(page_dirty, RPL_PAGE_COUNT);
+#endif
+
+/* Open addressing (linear probing) index of the replay list by source
+ * address, holding replay list index + 1 in each occupied bucket.
+ */
+#define RPL_BUCKETS     NHPOT(2 * CONFIG_BT_MESH_CRPL)
+#define RPL_BUCKET_MASK (RPL_BUCKETS - 1)
+
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
+static uint16_t replay_index[RPL_BUCKETS];
 static ATOMIC_DEFINE(store, CONFIG_BT_MESH_CRPL);
 
 enum {
 	PENDING_CLEAR,
 	PENDING_RESET,
+	/* Entries are being moved, lookups must not use the index. */
+	INDEX_STALE,
+	/* Entries were loaded from per-address settings entries. */
+	PENDING_MIGRATE,
 	RPL_FLAGS_COUNT,
 };
 static ATOMIC_DEFINE(rpl_flags, RPL_FLAGS_COUNT);
@@ -49,6 +85,159 @@ static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 	return rpl - &replay_list[0];
 }
 
+static inline uint32_t rpl_bucket(uint16_t src)
+{
+	/* Fibonacci hashing, spreads consecutive unicast addresses. */
+	return ((uint32_t)src * 0x9e3779b1U) >> (32 - LOG2CEIL(RPL_BUCKETS));
+}
+
+static inline uint32_t rpl_bucket_next(uint32_t bucket)
+{
+	return (bucket + 1) & RPL_BUCKET_MASK;
+}
+
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
+{
+	uint32_t i;
+
+	if (atomic_test_bit(rpl_flags, INDEX_STALE)) {
+		return;
+	}
+
+	for (i = rpl_bucket(rpl->src); replay_index[i]; i = rpl_bucket_next(i)) {
+	}
+
+	replay_index[i] = rpl_idx(rpl) + 1;
+}
+
+static void rpl_index_del(struct bt_mesh_rpl *rpl)
+{
+	uint32_t i, j;
+
+	if (atomic_test_bit(rpl_flags, INDEX_STALE)) {
+		return;
+	}
+
+	for (i = rpl_bucket(rpl->src); replay_index[i] != rpl_idx(rpl) + 1;
+	     i = rpl_bucket_next(i)) {
+		if (!replay_index[i]) {
+			return;
+		}
+	}
+
+	/* Backward shift deletion, keeps the probe sequences intact without
+	 * tombstones.
+	 */
+	for (j = rpl_bucket_next(i); replay_index[j]; j = rpl_bucket_next(j)) {
+		uint32_t home = rpl_bucket(replay_list[replay_index[j] - 1].src);
+
+		if (((j - home) & RPL_BUCKET_MASK) >= ((j - i) & RPL_BUCKET_MASK)) {
+			replay_index[i] = replay_index[j];
+			i = j;
+		}
+	}
+
+	replay_index[i] = 0U;
+}
+
+static void rpl_index_rebuild(void)
+{
+	(void)memset(replay_index, 0, sizeof(replay_index));
+	atomic_clear_bit(rpl_flags, INDEX_STALE);
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (replay_list[i].src) {
+			rpl_index_add(&replay_list[i]);
+		}
+	}
+}
+
+static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
+{
+	uint32_t i;
+
+	if (atomic_test_bit(rpl_flags, INDEX_STALE)) {
+		for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+			if (replay_list[i].src == src) {
+				return &replay_list[i];
+			}
+		}
+
+		return NULL;
+	}
+
+	for (i = rpl_bucket(src); replay_index[i]; i = rpl_bucket_next(i)) {
+		struct bt_mesh_rpl *rpl = &replay_list[replay_index[i] - 1];
+
+		if (rpl->src == src) {
+			return rpl;
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			replay_list[i].src = src;
+			rpl_index_add(&replay_list[i]);
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the entry for the given source address, or the first empty entry. */
+static struct bt_mesh_rpl *rpl_lookup(uint16_t src)
+{
+	struct bt_mesh_rpl *rpl;
+
+	if (atomic_test_bit(rpl_flags, INDEX_STALE)) {
+		/* While entries are being moved, the first entry that is either
+		 * empty or has the given address is the valid one.
+		 */
+		for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+			rpl = &replay_list[i];
+
+			if (!rpl->src || rpl->src == src) {
+				return rpl;
+			}
+		}
+
+		return NULL;
+	}
+
+	rpl = bt_mesh_rpl_find(src);
+	if (rpl) {
+		return rpl;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
+static bool rpl_is_newer(const struct bt_mesh_rpl *entry, uint32_t seq, bool old_iv)
+{
+	return (entry->old_iv && !old_iv) || (entry->old_iv == old_iv && entry->seq < seq);
+}
+
+static void rpl_page_mark(int idx)
+{
+#if defined(CONFIG_BT_MESH_RPL_STORE_PAGED)
+	atomic_set_bit(page_dirty, idx / RPL_PAGE_SIZE);
+#endif
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -60,6 +249,11 @@ static void clear_rpl(struct bt_mesh_rpl *rpl)
 
 	atomic_clear_bit(store, rpl_idx(rpl));
 
+	if (IS_ENABLED(CONFIG_BT_MESH_RPL_STORE_PAGED)) {
+		rpl_page_mark(rpl_idx(rpl));
+		return;
+	}
+
 	snprintk(path, sizeof(path), "bt/mesh/RPL/%x", rpl->src);
 	err = settings_delete(path);
 	if (err) {
@@ -92,7 +286,15 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	if (rpl->src != rx->ctx.addr) {
+		if (rpl->src) {
+			rpl_index_del(rpl);
+		}
+
+		rpl->src = rx->ctx.addr;
+		rpl_index_add(rpl);
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -110,7 +312,6 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match, bool bridge)
 {
 	struct bt_mesh_rpl *rpl;
-	int i;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -122,41 +323,38 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match, bo
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		rpl = &replay_list[i];
+	rpl = rpl_lookup(rx->ctx.addr);
+	if (!rpl) {
+		LOG_ERR("RPL is full!");
+		return true;
+	}
 
-		/* Empty slot */
-		if (!rpl->src) {
-			goto match;
-		}
+	/* Empty slot */
+	if (!rpl->src) {
+		goto match;
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (!rpl->old_iv &&
-			    atomic_test_bit(rpl_flags, PENDING_RESET) &&
-			    !atomic_test_bit(store, i)) {
-				/* Until rpl reset is finished, entry with old_iv == false and
-				 * without "store" bit set will be removed, therefore it can be
-				 * reused. If such entry is reused, "store" bit will be set and
-				 * the entry won't be removed.
-				 */
-				goto match;
-			}
+	/* Existing slot for given address */
+	if (!rpl->old_iv &&
+	    atomic_test_bit(rpl_flags, PENDING_RESET) &&
+	    !atomic_test_bit(store, rpl_idx(rpl))) {
+		/* Until rpl reset is finished, entry with old_iv == false and
+		 * without "store" bit set will be removed, therefore it can be
+		 * reused. If such entry is reused, "store" bit will be set and
+		 * the entry won't be removed.
+		 */
+		goto match;
+	}
 
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				goto match;
-			} else {
-				return true;
-			}
-		}
+	if ((!rx->old_iv && rpl->old_iv) ||
+	    rpl->seq < rx->seq) {
+		goto match;
 	}
 
-	LOG_ERR("RPL is full!");
 	return true;
 
 match:
@@ -175,6 +373,7 @@ void bt_mesh_rpl_clear(void)
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		(void)memset(replay_index, 0, sizeof(replay_index));
 		return;
 	}
 
@@ -183,33 +382,6 @@ void bt_mesh_rpl_clear(void)
 	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_RPL_PENDING);
 }
 
-static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
-static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
 void bt_mesh_rpl_reset(void)
 {
 	/* Discard "old old" IV Index entries from RPL and flag
@@ -261,14 +433,206 @@ void bt_mesh_rpl_reset(void)
 		}
 
 		(void)memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+		rpl_index_rebuild();
+	}
+}
+
+#if defined(CONFIG_BT_MESH_RPL_STORE_PAGED)
+#define RPL_PAGE_LEN(count) (offsetof(struct rpl_page, entry) + (count) * sizeof(page_buf.entry[0]))
+
+static bool rpl_page_valid(struct rpl_page *page, ssize_t len)
+{
+	uint16_t crc = sys_le16_to_cpu(page->crc);
+
+	if (len < RPL_PAGE_LEN(0) || page->version != RPL_PAGE_VERSION ||
+	    page->count > RPL_PAGE_SIZE || len != RPL_PAGE_LEN(page->count)) {
+		return false;
+	}
+
+	page->crc = 0U;
+
+	return crc16_ccitt(0xffff, (const uint8_t *)page, len) == crc;
+}
+
+static void rpl_page_load_entry(int idx, uint16_t src, uint32_t seq, bool old_iv)
+{
+	struct bt_mesh_rpl *entry = bt_mesh_rpl_find(src);
+
+	if (entry) {
+		/* An interrupted store may leave the same address in two pages.
+		 * Keep the most recent state, as seen by bt_mesh_rpl_check().
+		 */
+		if (rpl_is_newer(entry, seq, old_iv)) {
+			entry->seq = seq;
+			entry->old_iv = old_iv;
+		}
+	} else if (!replay_list[idx].src) {
+		entry = &replay_list[idx];
+		entry->src = src;
+		entry->seq = seq;
+		entry->old_iv = old_iv;
+		rpl_index_add(entry);
+		return;
+	} else {
+		entry = bt_mesh_rpl_alloc(src);
+		if (!entry) {
+			LOG_ERR("Unable to allocate RPL entry for 0x%04x", src);
+			return;
+		}
+
+		entry->seq = seq;
+		entry->old_iv = old_iv;
+	}
+
+	if (entry == &replay_list[idx]) {
+		return;
+	}
+
+	/* The entry isn't at the position its page says, rewrite both pages. */
+	atomic_set_bit(store, rpl_idx(entry));
+	atomic_set_bit(page_dirty, idx / RPL_PAGE_SIZE);
+	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_RPL_PENDING);
+}
+
+static int rpl_page_set(const char *name, size_t len_rd, settings_read_cb read_cb, void *cb_arg)
+{
+	unsigned long page;
+	ssize_t len;
+
+	if (!name || len_rd == 0) {
+		return 0;
+	}
+
+	page = strtoul(name, NULL, 16);
+	if (page >= RPL_PAGE_COUNT) {
+		LOG_WRN("Ignoring RPL page %lu beyond RPL capacity", page);
+		return 0;
+	}
+
+	len = read_cb(cb_arg, &page_buf, sizeof(page_buf));
+	if (len < 0) {
+		LOG_ERR("Failed to read value (err %zd)", len);
+		return len;
+	}
+
+	if (!rpl_page_valid(&page_buf, len)) {
+		LOG_ERR("Invalid RPL page %lu", page);
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < page_buf.count; i++) {
+		uint16_t val = sys_le16_to_cpu(page_buf.entry[i].src_old_iv);
+
+		rpl_page_load_entry(page * RPL_PAGE_SIZE + i, val & BIT_MASK(15),
+				    sys_get_le24(page_buf.entry[i].seq), val >> 15);
+	}
+
+	LOG_DBG("RPL page %lu: %u entries", page, page_buf.count);
+
+	return 0;
+}
+
+static int rpl_page_store(int page)
+{
+	int first = page * RPL_PAGE_SIZE;
+	int end = MIN(first + RPL_PAGE_SIZE, CONFIG_BT_MESH_CRPL);
+	uint8_t count = 0U;
+	char path[20];
+	int err;
+
+	for (int i = first; i < end; i++) {
+		struct bt_mesh_rpl *rpl = &replay_list[i];
+
+		if (!rpl->src) {
+			continue;
+		}
+
+		page_buf.entry[count].src_old_iv = sys_cpu_to_le16(rpl->src | (rpl->old_iv << 15));
+		sys_put_le24(rpl->seq, page_buf.entry[count].seq);
+		count++;
+	}
+
+	snprintk(path, sizeof(path), "bt/mesh/RPL/p/%x", page);
+
+	if (!count) {
+		err = settings_delete(path);
+	} else {
+		page_buf.version = RPL_PAGE_VERSION;
+		page_buf.count = count;
+		page_buf.crc = 0U;
+		page_buf.crc = sys_cpu_to_le16(crc16_ccitt(0xffff, (const uint8_t *)&page_buf,
+							   RPL_PAGE_LEN(count)));
+
+		err = settings_save_one(path, &page_buf, RPL_PAGE_LEN(count));
+	}
+
+	if (err) {
+		LOG_ERR("Failed to store RPL page %s", path);
+	} else {
+		LOG_DBG("Stored RPL page %s with %u entries", path, count);
+	}
+
+	return err;
+}
+
+static int rpl_pages_store(void)
+{
+	int ret = 0;
+
+	for (int page = 0; page < RPL_PAGE_COUNT; page++) {
+		if (atomic_test_and_clear_bit(page_dirty, page)) {
+			int err = rpl_page_store(page);
+
+			if (err) {
+				/* Keep the page dirty to retry on the next store. */
+				atomic_set_bit(page_dirty, page);
+				ret = err;
+			}
+		}
+	}
+
+	return ret;
+}
+
+/* Move the entries loaded from per-address settings entries to pages. The
+ * per-address entries are only removed once every page is written, so the
+ * list is always fully stored in one form or the other.
+ */
+static void rpl_migrate(void)
+{
+	char path[18];
+	int err;
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (replay_list[i].src) {
+			rpl_page_mark(i);
+		}
+	}
+
+	err = rpl_pages_store();
+	if (err) {
+		LOG_ERR("Failed to migrate RPL to pages (err %d)", err);
+		atomic_set_bit(rpl_flags, PENDING_MIGRATE);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			continue;
+		}
+
+		snprintk(path, sizeof(path), "bt/mesh/RPL/%x", replay_list[i].src);
+		(void)settings_delete(path);
 	}
 }
+#endif /* CONFIG_BT_MESH_RPL_STORE_PAGED */
 
 static int rpl_set(const char *name, size_t len_rd,
 		   settings_read_cb read_cb, void *cb_arg)
 {
 	struct bt_mesh_rpl *entry;
 	struct rpl_val rpl;
+	bool loaded;
 	int err;
 	uint16_t src;
 
@@ -281,12 +645,21 @@ static int rpl_set(const char *name, size_t len_rd,
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_BT_MESH_RPL_STORE_PAGED)
+	const char *next;
+
+	if (settings_name_steq(name, "p", &next)) {
+		return rpl_page_set(next, len_rd, read_cb, cb_arg);
+	}
+#endif
+
 	src = strtol(name, NULL, 16);
 	entry = bt_mesh_rpl_find(src);
 
 	if (len_rd == 0) {
 		LOG_DBG("val (null)");
 		if (entry) {
+			rpl_index_del(entry);
 			(void)memset(entry, 0, sizeof(*entry));
 		} else {
 			LOG_WRN("Unable to find RPL entry for 0x%04x", src);
@@ -295,6 +668,7 @@ static int rpl_set(const char *name, size_t len_rd,
 		return 0;
 	}
 
+	loaded = entry != NULL;
 	if (!entry) {
 		entry = bt_mesh_rpl_alloc(src);
 		if (!entry) {
@@ -309,12 +683,28 @@ static int rpl_set(const char *name, size_t len_rd,
 		return err;
 	}
 
+	/* An interrupted migration leaves the entry in a page as well, which
+	 * may be more recent than the per-address entry.
+	 */
+	if (IS_ENABLED(CONFIG_BT_MESH_RPL_STORE_PAGED) && loaded &&
+	    !rpl_is_newer(entry, rpl.seq, rpl.old_iv)) {
+		atomic_set_bit(rpl_flags, PENDING_MIGRATE);
+		bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_RPL_PENDING);
+		return 0;
+	}
+
 	entry->seq = rpl.seq;
 	entry->old_iv = rpl.old_iv;
 
 	LOG_DBG("RPL entry for 0x%04x: Seq 0x%06x old_iv %u", entry->src, entry->seq,
 		entry->old_iv);
 
+	if (IS_ENABLED(CONFIG_BT_MESH_RPL_STORE_PAGED)) {
+		/* Move the entries stored before paging was enabled to pages. */
+		atomic_set_bit(rpl_flags, PENDING_MIGRATE);
+		bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_RPL_PENDING);
+	}
+
 	return 0;
 }
 
@@ -330,6 +720,11 @@ static void store_rpl(struct bt_mesh_rpl *entry)
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_MESH_RPL_STORE_PAGED)) {
+		rpl_page_mark(rpl_idx(entry));
+		return;
+	}
+
 	LOG_DBG("src 0x%04x seq 0x%06x old_iv %u", entry->src, entry->seq, entry->old_iv);
 
 	rpl.seq = entry->seq;
@@ -349,6 +744,7 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 {
 	int shift = 0;
 	int last = 0;
+	bool compact;
 	bool clr;
 	bool rst;
 
@@ -365,6 +761,20 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 	clr = atomic_test_and_clear_bit(rpl_flags, PENDING_CLEAR);
 	rst = atomic_test_bit(rpl_flags, PENDING_RESET);
 
+	/* Entries are moved below. Until the index is rebuilt, lookups (also
+	 * from the settings backend calls) scan the list instead.
+	 */
+	compact = addr == BT_MESH_ADDR_ALL_NODES && (clr || rst);
+	if (compact) {
+		atomic_set_bit(rpl_flags, INDEX_STALE);
+	}
+
+#if defined(CONFIG_BT_MESH_RPL_STORE_PAGED)
+	if (atomic_test_and_clear_bit(rpl_flags, PENDING_MIGRATE)) {
+		rpl_migrate();
+	}
+#endif
+
 	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		struct bt_mesh_rpl *rpl = &replay_list[i];
 
@@ -395,6 +805,12 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 			}
 		}
 
+		if (shift > 0 && rpl->src) {
+			/* Entries after the first removed one are moved. */
+			rpl_page_mark(i - shift);
+			rpl_page_mark(i);
+		}
+
 		last = i;
 
 		if (addr != BT_MESH_ADDR_ALL_NODES) {
@@ -407,6 +823,14 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 	if (addr == BT_MESH_ADDR_ALL_NODES) {
 		(void)memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
 	}
+
+	if (compact) {
+		rpl_index_rebuild();
+	}
+
+#if defined(CONFIG_BT_MESH_RPL_STORE_PAGED)
+	rpl_pages_store();
+#endif
 }
 
 void bt_mesh_rpl_pending_store_all_nodes(void)
@@ -1682,6 +1682,7 @@ static int cmd_appidx(const struct shell *sh, size_t argc, char *argv[])
 #if defined(CONFIG_BT_MESH_STATISTIC)
 static int cmd_stat_get(const struct shell *sh, size_t argc, char *argv[])
 {
+	struct bt_mesh_adv_set_statistic set_st;
 	struct bt_mesh_statistic st;
 
 	bt_mesh_stat_get(&st);
@@ -1697,6 +1698,22 @@ static int cmd_stat_get(const struct shell *sh, size_t argc, char *argv[])
 	shell_print(sh, "local adv:   %d - %d", st.tx_local_planned, st.tx_local_succeeded);
 	shell_print(sh, "friend:      %d - %d", st.tx_friend_planned, st.tx_friend_succeeded);
 
+	shell_print(sh, "Segmented messages: <planned> - <succeeded>");
+	shell_print(sh, "messages:    %d - %d", st.tx_seg_msg_planned, st.tx_seg_msg_succeeded);
+	shell_print(sh, "Segments: <planned> - <transmitted>");
+	shell_print(sh, "segments:    %d - %d", st.tx_seg_planned, st.tx_seg_sent);
+	shell_print(sh, "Delivered octets: %d", st.tx_seg_octets);
+
+	for (uint8_t i = 0; !bt_mesh_stat_adv_set_get(i, &set_st); i++) {
+		if (i == 0) {
+			shell_print(sh, "Advertising sets: <sent> <busy ms> <queue ms avg/max>");
+		}
+
+		shell_print(sh, "set %u:       %d %d %d/%d", i, set_st.tx_count, set_st.tx_time,
+			    set_st.tx_count ? set_st.queue_latency / set_st.tx_count : 0,
+			    set_st.queue_latency_max);
+	}
+
 	return 0;
 }
 
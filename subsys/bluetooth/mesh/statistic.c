@@ -19,10 +19,25 @@ void bt_mesh_stat_get(struct bt_mesh_statistic *st)
 void bt_mesh_stat_reset(void)
 {
 	memset(&stat, 0, sizeof(struct bt_mesh_statistic));
+
+	if (IS_ENABLED(CONFIG_BT_MESH_ADV_EXT)) {
+		bt_mesh_adv_stat_reset();
+	}
+}
+
+int bt_mesh_stat_adv_set_get(uint8_t idx, struct bt_mesh_adv_set_statistic *st)
+{
+	if (!IS_ENABLED(CONFIG_BT_MESH_ADV_EXT)) {
+		return -ENOTSUP;
+	}
+
+	return bt_mesh_adv_stat_get(idx, st);
 }
 
 void bt_mesh_stat_planned_count(struct bt_mesh_adv_ctx *ctx)
 {
+	ctx->timestamp = k_uptime_get_32();
+
 	if (ctx->tag == BT_MESH_ADV_TAG_LOCAL) {
 		stat.tx_local_planned++;
 	} else if (ctx->tag == BT_MESH_ADV_TAG_RELAY) {
@@ -61,3 +76,22 @@ void bt_mesh_stat_rx(enum bt_mesh_net_if net_if)
 		break;
 	}
 }
+
+void bt_mesh_stat_seg_tx_start(uint8_t seg_count)
+{
+	stat.tx_seg_msg_planned++;
+	stat.tx_seg_planned += seg_count;
+}
+
+void bt_mesh_stat_seg_tx_segment(void)
+{
+	stat.tx_seg_sent++;
+}
+
+void bt_mesh_stat_seg_tx_end(int err, uint16_t len)
+{
+	if (!err) {
+		stat.tx_seg_msg_succeeded++;
+		stat.tx_seg_octets += len;
+	}
+}
@@ -10,5 +10,11 @@
 void bt_mesh_stat_planned_count(struct bt_mesh_adv_ctx *ctx);
 void bt_mesh_stat_succeeded_count(struct bt_mesh_adv_ctx *ctx);
 void bt_mesh_stat_rx(enum bt_mesh_net_if net_if);
+void bt_mesh_stat_seg_tx_start(uint8_t seg_count);
+void bt_mesh_stat_seg_tx_segment(void);
+void bt_mesh_stat_seg_tx_end(int err, uint16_t len);
+
+int bt_mesh_adv_stat_get(uint8_t idx, struct bt_mesh_adv_set_statistic *st);
+void bt_mesh_adv_stat_reset(void);
 
 #endif /* ZEPHYR_SUBSYS_BLUETOOTH_MESH_STATISTIC_H_ */
@@ -65,8 +65,38 @@ static struct bt_mesh_subnet subnets[CONFIG_BT_MESH_SUBNET_COUNT] = {
 	},
 };
 
+/* Network credentials indexed by their NID, so that incoming network PDUs
+ * are only matched against the keys that can possibly decrypt them. Each
+ * NID holds a chain of credential slots, where slot n is keys[n % 2] of
+ * subnets[n / 2]. Slots are stored as n + 1, with 0 terminating the chain.
+ */
+#define NID_SLOT_COUNT (CONFIG_BT_MESH_SUBNET_COUNT * 2)
+
+static uint16_t nid_head[BIT(7)];
+static uint16_t nid_next[NID_SLOT_COUNT];
+
+static void nid_index_update(void)
+{
+	(void)memset(nid_head, 0, sizeof(nid_head));
+
+	/* Walk backwards so that each chain keeps the subnet and key order. */
+	for (int i = NID_SLOT_COUNT - 1; i >= 0; i--) {
+		struct bt_mesh_subnet *sub = &subnets[i / 2];
+		struct bt_mesh_subnet_keys *keys = &sub->keys[i % 2];
+
+		if (sub->net_idx == BT_MESH_KEY_UNUSED || !keys->valid) {
+			continue;
+		}
+
+		nid_next[i] = nid_head[keys->msg.nid];
+		nid_head[keys->msg.nid] = i + 1;
+	}
+}
+
 static void subnet_evt(struct bt_mesh_subnet *sub, enum bt_mesh_key_evt evt)
 {
+	nid_index_update();
+
 	STRUCT_SECTION_FOREACH(bt_mesh_subnet_cb, cb) {
 		cb->evt_handler(sub, evt);
 	}
@@ -296,6 +326,8 @@ static void subnet_del(struct bt_mesh_subnet *sub)
 	subnet_evt(sub, BT_MESH_KEY_DELETED);
 	(void)memset(sub, 0, sizeof(*sub));
 	sub->net_idx = BT_MESH_KEY_UNUSED;
+
+	nid_index_update();
 }
 
 static int msg_cred_create(struct bt_mesh_net_cred *cred, const uint8_t *p,
@@ -803,6 +835,8 @@ int bt_mesh_subnet_set(uint16_t net_idx, uint8_t kr_phase, const struct bt_mesh_
 		sub->node_id = BT_MESH_NODE_IDENTITY_NOT_SUPPORTED;
 	}
 
+	nid_index_update();
+
 	/* Make sure we have valid beacon data to be sent */
 	bt_mesh_beacon_update(sub);
 
@@ -940,23 +974,16 @@ bool bt_mesh_net_cred_find(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 	}
 #endif
 
-	for (i = 0; i < ARRAY_SIZE(subnets); i++) {
-		rx->sub = &subnets[i];
-		if (rx->sub->net_idx == BT_MESH_KEY_UNUSED) {
-			continue;
-		}
+	/* Only the credentials with a matching NID are tried */
+	for (i = nid_head[in->data[0] & 0x7f]; i; i = nid_next[i - 1]) {
+		j = (i - 1) % 2;
+		rx->sub = &subnets[(i - 1) / 2];
 
-		for (j = 0; j < ARRAY_SIZE(rx->sub->keys); j++) {
-			if (!rx->sub->keys[j].valid) {
-				continue;
-			}
-
-			if (cb(rx, in, out, &rx->sub->keys[j].msg)) {
-				rx->new_key = (j > 0);
-				rx->friend_cred = 0U;
-				rx->ctx.net_idx = rx->sub->net_idx;
-				return true;
-			}
+		if (cb(rx, in, out, &rx->sub->keys[j].msg)) {
+			rx->new_key = (j > 0);
+			rx->friend_cred = 0U;
+			rx->ctx.net_idx = rx->sub->net_idx;
+			return true;
 		}
 	}
 
@@ -34,6 +34,7 @@
 #include "testing.h"
 #include "transport.h"
 #include "va.h"
+#include "statistic.h"
 
 #define LOG_LEVEL CONFIG_BT_MESH_TRANS_LOG_LEVEL
 #include <zephyr/logging/log.h>
@@ -79,6 +80,7 @@ static struct seg_tx {
 	uint8_t               seg_n;         /* Last segment index */
 	uint8_t               seg_o;         /* Segment being sent */
 	uint8_t               nack_count;    /* Number of unacked segs */
+	uint8_t               in_flight;     /* Segs queued for advertising */
 	uint8_t               attempts_left;
 	uint8_t               attempts_left_without_progress;
 	uint8_t               ttl;           /* Transmitted TTL value */
@@ -251,6 +253,9 @@ static void seg_tx_reset(struct seg_tx *tx)
 		seg_tx_done(tx, i);
 	}
 
+	/* Segments still queued for advertising keep in_flight up until their
+	 * callbacks have been called, so that the context isn't reused before.
+	 */
 	tx->nack_count = 0;
 	tx->seg_send_started = 0;
 	tx->ack_received = 0;
@@ -269,6 +274,10 @@ static inline void seg_tx_complete(struct seg_tx *tx, int err)
 	const struct bt_mesh_send_cb *cb = tx->cb;
 	void *cb_data = tx->cb_data;
 
+	if (IS_ENABLED(CONFIG_BT_MESH_STATISTIC)) {
+		bt_mesh_stat_seg_tx_end(err, tx->len);
+	}
+
 	seg_tx_unblock_check(tx);
 
 	seg_tx_reset(tx);
@@ -306,6 +315,18 @@ static void seg_send_start(uint16_t duration, int err, void *user_data)
 {
 	struct seg_tx *tx = user_data;
 
+	/* If there's an error in transmitting the 'sent' callback will never
+	 * be called, so the segment is no longer in flight.
+	 */
+	if (err && tx->in_flight) {
+		tx->in_flight--;
+	}
+
+	/* Segment of a transmission that has already ended */
+	if (!tx->nack_count) {
+		return;
+	}
+
 	if (!tx->started && tx->cb && tx->cb->start) {
 		tx->cb->start(duration, err, tx->cb_data);
 		tx->started = 1U;
@@ -314,11 +335,10 @@ static void seg_send_start(uint16_t duration, int err, void *user_data)
 	tx->seg_send_started = 1U;
 	tx->adv_start_timestamp = k_uptime_get();
 
-	/* If there's an error in transmitting the 'sent' callback will never
-	 * be called. Make sure that we kick the retransmit timer also in this
-	 * case since otherwise we risk the transmission of becoming stale.
+	/* Make sure that we kick the retransmit timer also in case of an error
+	 * since otherwise we risk the transmission of becoming stale.
 	 */
-	if (err) {
+	if (err && !tx->in_flight) {
 		schedule_transmit_continue(tx, 0);
 	}
 }
@@ -328,10 +348,19 @@ static void seg_sent(int err, void *user_data)
 	struct seg_tx *tx = user_data;
 	uint32_t delta_ms = (uint32_t)(k_uptime_get() - tx->adv_start_timestamp);
 
+	if (tx->in_flight) {
+		tx->in_flight--;
+	}
+
 	if (!tx->seg_send_started) {
 		return;
 	}
 
+	/* Continue once the whole window of segments has been sent */
+	if (tx->in_flight) {
+		return;
+	}
+
 	schedule_transmit_continue(tx, delta_ms);
 }
 
@@ -402,7 +431,7 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 	LOG_DBG("SeqZero: 0x%04x Attempts: %u",
 		(uint16_t)(tx->seq_auth & TRANS_SEQ_ZERO_MASK), tx->attempts_left);
 
-	while (tx->seg_o <= tx->seg_n) {
+	while (tx->seg_o <= tx->seg_n && tx->in_flight < CONFIG_BT_MESH_SAR_TX_WINDOW) {
 		struct bt_mesh_adv *seg;
 		int err;
 
@@ -416,7 +445,7 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 					 tx->xmit, BUF_TIMEOUT);
 		if (!seg) {
 			LOG_DBG("Allocating segment failed");
-			goto end;
+			break;
 		}
 
 		net_buf_simple_reserve(&seg->b, BT_MESH_NET_HDR_LEN);
@@ -424,10 +453,20 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 
 		LOG_DBG("Sending %u/%u", tx->seg_o, tx->seg_n);
 
+		/* The callbacks may be called before bt_mesh_net_send()
+		 * returns, e.g. for loopback.
+		 */
+		tx->in_flight++;
+
 		err = bt_mesh_net_send(&net_tx, seg, &seg_sent_cb, tx);
 		if (err) {
 			LOG_DBG("Sending segment failed");
-			goto end;
+			tx->in_flight--;
+			break;
+		}
+
+		if (IS_ENABLED(CONFIG_BT_MESH_STATISTIC)) {
+			bt_mesh_stat_seg_tx_segment();
 		}
 
 		/* Move on to the next segment */
@@ -435,12 +474,27 @@ static void seg_tx_send_unacked(struct seg_tx *tx)
 
 		tx->ack_received = 0U;
 
-		/* Return here to let the advertising layer process the message.
-		 * This function will be called again after Segment Interval.
+		/* The segment has already been sent, and the transmission
+		 * continues after Segment Interval.
 		 */
+		if (!tx->in_flight) {
+			return;
+		}
+	}
+
+	/* Return here to let the advertising layer process the queued
+	 * segments. This function will be called again after Segment
+	 * Interval once the last of them has been sent.
+	 */
+	if (tx->in_flight) {
 		return;
 	}
 
+	if (tx->seg_o <= tx->seg_n) {
+		/* Allocating or sending the segment failed */
+		goto end;
+	}
+
 
 	/* All segments have been sent */
 	tx->seg_o = 0U;
@@ -498,7 +552,7 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 		if (seg_tx[i].nack_count) {
 			blocked |= seg_tx_blocks(&seg_tx[i], net_tx->src,
 						 net_tx->ctx->addr);
-		} else if (!tx) {
+		} else if (!tx && !seg_tx[i].in_flight) {
 			tx = &seg_tx[i];
 		}
 	}
@@ -608,6 +662,10 @@ static int send_seg(struct bt_mesh_net_tx *net_tx, struct net_buf_simple *sdu,
 		return 0;
 	}
 
+	if (IS_ENABLED(CONFIG_BT_MESH_STATISTIC)) {
+		bt_mesh_stat_seg_tx_start(tx->seg_n + 1);
+	}
+
 	if (blocked) {
 		/* Move the sequence number, so we don't end up creating
 		 * another segmented transmission with the same SeqZero while
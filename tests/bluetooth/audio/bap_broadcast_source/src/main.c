@@ -1481,3 +1481,82 @@ static ZTEST_F(bap_broadcast_source_test_suite,
 	zassert_equal(err, -EINVAL, "Unexpected return value: %d", err);
 	zassert_equal(cnt, 0U, "Got %zu, expected %u", cnt, 0U);
 }
+
+static ZTEST_F(bap_broadcast_source_test_suite, test_broadcast_source_send)
+{
+	struct net_buf *bufs[CONFIG_BT_BAP_BROADCAST_SRC_STREAM_COUNT] = {NULL};
+	int results[CONFIG_BT_BAP_BROADCAST_SRC_STREAM_COUNT];
+	struct bt_le_ext_adv ext_adv = {0};
+	int err;
+
+	err = bt_bap_broadcast_source_create(fixture->param, &fixture->source);
+	zassert_equal(err, 0, "Unexpected return value: %d", err);
+
+	err = bt_bap_broadcast_source_start(fixture->source, &ext_adv);
+	zassert_equal(err, 0, "Unexpected return value: %d", err);
+
+	/* Since BAP doesn't care about the `buf` we can just provide NULL */
+	err = bt_bap_broadcast_source_send(fixture->source, bufs, fixture->stream_cnt, 1U,
+					   results);
+	zassert_equal(err, 0, "Unexpected return value: %d", err);
+
+	for (size_t i = 0U; i < fixture->stream_cnt; i++) {
+		zassert_equal(results[i], 0, "Unexpected result %d for stream %zu", results[i], i);
+	}
+
+	zexpect_call_count("bt_bap_stream_ops.sent", fixture->stream_cnt,
+			   mock_bap_stream_sent_cb_fake.call_count);
+
+	err = bt_bap_broadcast_source_send_ts(fixture->source, bufs, fixture->stream_cnt, 2U,
+					      1000U, results);
+	zassert_equal(err, 0, "Unexpected return value: %d", err);
+
+	zexpect_call_count("bt_bap_stream_ops.sent", fixture->stream_cnt * 2U,
+			   mock_bap_stream_sent_cb_fake.call_count);
+}
+
+static ZTEST_F(bap_broadcast_source_test_suite, test_broadcast_source_send_inval_not_started)
+{
+	struct net_buf *bufs[CONFIG_BT_BAP_BROADCAST_SRC_STREAM_COUNT] = {NULL};
+	int results[CONFIG_BT_BAP_BROADCAST_SRC_STREAM_COUNT];
+	int err;
+
+	err = bt_bap_broadcast_source_create(fixture->param, &fixture->source);
+	zassert_equal(err, 0, "Unexpected return value: %d", err);
+
+	err = bt_bap_broadcast_source_send(fixture->source, bufs, fixture->stream_cnt, 1U,
+					   results);
+	zassert_equal(err, -EBADMSG, "Unexpected return value: %d", err);
+
+	zexpect_call_count("bt_bap_stream_ops.sent", 0U, mock_bap_stream_sent_cb_fake.call_count);
+}
+
+static ZTEST_F(bap_broadcast_source_test_suite, test_broadcast_source_send_inval_param)
+{
+	struct net_buf *bufs[CONFIG_BT_BAP_BROADCAST_SRC_STREAM_COUNT] = {NULL};
+	int results[CONFIG_BT_BAP_BROADCAST_SRC_STREAM_COUNT];
+	struct bt_le_ext_adv ext_adv = {0};
+	int err;
+
+	err = bt_bap_broadcast_source_create(fixture->param, &fixture->source);
+	zassert_equal(err, 0, "Unexpected return value: %d", err);
+
+	err = bt_bap_broadcast_source_start(fixture->source, &ext_adv);
+	zassert_equal(err, 0, "Unexpected return value: %d", err);
+
+	err = bt_bap_broadcast_source_send(NULL, bufs, fixture->stream_cnt, 1U, results);
+	zassert_equal(err, -EINVAL, "Unexpected return value: %d", err);
+
+	err = bt_bap_broadcast_source_send(fixture->source, NULL, fixture->stream_cnt, 1U,
+					   results);
+	zassert_equal(err, -EINVAL, "Unexpected return value: %d", err);
+
+	err = bt_bap_broadcast_source_send(fixture->source, bufs, fixture->stream_cnt, 1U, NULL);
+	zassert_equal(err, -EINVAL, "Unexpected return value: %d", err);
+
+	err = bt_bap_broadcast_source_send(fixture->source, bufs, fixture->stream_cnt - 1U, 1U,
+					   results);
+	zassert_equal(err, -EINVAL, "Unexpected return value: %d", err);
+
+	zexpect_call_count("bt_bap_stream_ops.sent", 0U, mock_bap_stream_sent_cb_fake.call_count);
+}
@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <zephyr/bluetooth/audio/audio.h>
 #include <zephyr/bluetooth/audio/bap_lc3_preset.h>
@@ -405,6 +406,92 @@ ZTEST(audio_codec_test_suite, test_bt_audio_codec_cfg_set_frame_blocks_per_sdu)
 	zassert_equal(ret, 2, "Unexpected return value %d", ret);
 }
 
+ZTEST(audio_codec_test_suite, test_bt_audio_codec_cfg_get_params)
+{
+	const struct bt_bap_lc3_preset preset = BT_BAP_LC3_UNICAST_PRESET_48_5_1(
+		BT_AUDIO_LOCATION_FRONT_LEFT, BT_AUDIO_CONTEXT_TYPE_UNSPECIFIED);
+	struct bt_audio_codec_cfg_params params;
+	enum bt_audio_location chan_allocation;
+	int err;
+
+	err = bt_audio_codec_cfg_get_params(&preset.codec_cfg, &params, true);
+	zassert_equal(err, 0, "Unexpected return value %d", err);
+
+	err = bt_audio_codec_cfg_get_chan_allocation(&preset.codec_cfg, &chan_allocation, true);
+	zassert_equal(params.chan_allocation_err, err, "Unexpected error %d",
+		      params.chan_allocation_err);
+	zassert_equal(params.chan_allocation, chan_allocation, "Unexpected value 0x%08X",
+		      params.chan_allocation);
+	zassert_equal(params.freq, bt_audio_codec_cfg_get_freq(&preset.codec_cfg),
+		      "Unexpected value %d", params.freq);
+	zassert_equal(params.frame_dur, bt_audio_codec_cfg_get_frame_dur(&preset.codec_cfg),
+		      "Unexpected value %d", params.frame_dur);
+	zassert_equal(params.octets_per_frame,
+		      bt_audio_codec_cfg_get_octets_per_frame(&preset.codec_cfg),
+		      "Unexpected value %d", params.octets_per_frame);
+	zassert_equal(params.frame_blocks_per_sdu, 1, "Unexpected value %d",
+		      params.frame_blocks_per_sdu);
+}
+
+ZTEST(audio_codec_test_suite, test_bt_audio_codec_cfg_get_params_lc3_fallback_true)
+{
+	struct bt_audio_codec_cfg codec_cfg = {.id = BT_HCI_CODING_FORMAT_LC3};
+	struct bt_audio_codec_cfg_params params;
+	int err;
+
+	err = bt_audio_codec_cfg_get_params(&codec_cfg, &params, true);
+	zassert_equal(err, 0, "Unexpected return value %d", err);
+	zassert_equal(params.freq, -ENODATA, "Unexpected value %d", params.freq);
+	zassert_equal(params.frame_dur, -ENODATA, "Unexpected value %d", params.frame_dur);
+	zassert_equal(params.chan_allocation_err, 0, "Unexpected error %d",
+		      params.chan_allocation_err);
+	zassert_equal(params.chan_allocation, BT_AUDIO_LOCATION_MONO_AUDIO,
+		      "Unexpected value 0x%08X", params.chan_allocation);
+	zassert_equal(params.octets_per_frame, -ENODATA, "Unexpected value %d",
+		      params.octets_per_frame);
+	zassert_equal(params.frame_blocks_per_sdu, 1, "Unexpected value %d",
+		      params.frame_blocks_per_sdu);
+}
+
+ZTEST(audio_codec_test_suite, test_bt_audio_codec_cfg_get_params_fallback_false)
+{
+	struct bt_audio_codec_cfg codec_cfg = {.id = BT_HCI_CODING_FORMAT_LC3};
+	struct bt_audio_codec_cfg_params params;
+	int err;
+
+	err = bt_audio_codec_cfg_get_params(&codec_cfg, &params, false);
+	zassert_equal(err, 0, "Unexpected return value %d", err);
+	zassert_equal(params.chan_allocation_err, -ENODATA, "Unexpected error %d",
+		      params.chan_allocation_err);
+	zassert_equal(params.frame_blocks_per_sdu, -ENODATA, "Unexpected value %d",
+		      params.frame_blocks_per_sdu);
+}
+
+ZTEST(audio_codec_test_suite, test_bt_audio_codec_cfg_get_params_invalid)
+{
+	const uint8_t data[] = {
+		BT_AUDIO_CODEC_DATA(BT_AUDIO_CODEC_CFG_FREQ, 0xFF),
+		BT_AUDIO_CODEC_DATA(BT_AUDIO_CODEC_CFG_FRAME_LEN, 0x28),
+		BT_AUDIO_CODEC_DATA(BT_AUDIO_CODEC_CFG_DURATION, BT_AUDIO_CODEC_CFG_DURATION_10),
+		BT_AUDIO_CODEC_DATA(BT_AUDIO_CODEC_CFG_DURATION, BT_AUDIO_CODEC_CFG_DURATION_7_5),
+	};
+	struct bt_audio_codec_cfg codec_cfg = {.id = BT_HCI_CODING_FORMAT_LC3};
+	struct bt_audio_codec_cfg_params params;
+	int err;
+
+	memcpy(codec_cfg.data, data, sizeof(data));
+	codec_cfg.data_len = sizeof(data);
+
+	err = bt_audio_codec_cfg_get_params(&codec_cfg, &params, false);
+	zassert_equal(err, 0, "Unexpected return value %d", err);
+	zassert_equal(params.freq, -EBADMSG, "Unexpected value %d", params.freq);
+	zassert_equal(params.octets_per_frame, -EBADMSG, "Unexpected value %d",
+		      params.octets_per_frame);
+	/* Only the first occurrence is used, like bt_audio_codec_cfg_get_frame_dur() */
+	zassert_equal(params.frame_dur, BT_AUDIO_CODEC_CFG_DURATION_10, "Unexpected value %d",
+		      params.frame_dur);
+}
+
 ZTEST(audio_codec_test_suite, test_bt_audio_codec_cfg_meta_get_val)
 {
 	struct bt_audio_codec_cfg codec_cfg =
@@ -0,0 +1,121 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/bluetooth/addr.h>
+#include <zephyr/bluetooth/crypto.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#if defined(CONFIG_BT_HOST_CRYPTO) && !defined(CONFIG_BT_CTLR_CRYPTO)
+#include <psa/crypto.h>
+#endif /* CONFIG_BT_HOST_CRYPTO && !CONFIG_BT_CTLR_CRYPTO */
+
+#include "common/rpa.h"
+
+#define MAX_IRKS    32
+#define ITERATIONS  16
+
+static uint8_t irk_vals[MAX_IRKS][16];
+static const uint8_t *irks[MAX_IRKS];
+
+static void *rpa_batch_setup(void)
+{
+#if defined(CONFIG_BT_HOST_CRYPTO) && !defined(CONFIG_BT_CTLR_CRYPTO)
+	/* bt_encrypt_le() failing in the tests catches a failed initialization */
+	(void)psa_crypto_init();
+#endif /* CONFIG_BT_HOST_CRYPTO && !CONFIG_BT_CTLR_CRYPTO */
+
+	for (size_t i = 0; i < MAX_IRKS; i++) {
+		for (size_t j = 0; j < sizeof(irk_vals[i]); j++) {
+			irk_vals[i][j] = (uint8_t)(i * 16 + j);
+		}
+
+		irks[i] = irk_vals[i];
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(bt_rpa_batch, NULL, rpa_batch_setup, NULL, NULL, NULL);
+
+/* Create an RPA resolving with the given IRK, as done by ah() */
+static void rpa_create(const uint8_t irk[16], bt_addr_t *rpa)
+{
+	uint8_t res[16] = { 0x12, 0x34, 0x56 };
+
+	memcpy(rpa->val + 3, res, 3);
+	BT_ADDR_SET_RPA(rpa);
+	memcpy(res, rpa->val + 3, 3);
+
+	zassert_ok(bt_encrypt_le(irk, res, res));
+	memcpy(rpa->val, res, 3);
+}
+
+ZTEST(bt_rpa_batch, test_batch_matches_single)
+{
+	bt_addr_t rpa;
+
+	for (size_t i = 0; i < MAX_IRKS; i += 7) {
+		rpa_create(irks[i], &rpa);
+
+		zassert_true(bt_rpa_irk_matches(irks[i], &rpa));
+		zassert_equal(bt_rpa_irk_matches_batch(irks, MAX_IRKS, &rpa), i);
+	}
+
+	/* An RPA not resolving with any of the IRKs */
+	rpa_create((const uint8_t [16]){ 0xff }, &rpa);
+	zassert_equal(bt_rpa_irk_matches_batch(irks, MAX_IRKS, &rpa), -ENOENT);
+	zassert_equal(bt_rpa_irk_matches_batch(irks, 0, &rpa), -ENOENT);
+}
+
+static uint64_t resolutions_per_sec(uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	return ns ? (ITERATIONS * NSEC_PER_SEC) / ns : 0;
+}
+
+/* Resolve an RPA matching none of the IRKs, which is the worst case for every
+ * advertising report from an unbonded device, one IRK at a time and batched.
+ */
+ZTEST(bt_rpa_batch, test_benchmark_irk_count)
+{
+	static const size_t irk_counts[] = { 1, 4, 8, 16, 32 };
+	bt_addr_t rpa;
+
+	BUILD_ASSERT(MAX_IRKS >= 32);
+
+	rpa_create((const uint8_t [16]){ 0xff }, &rpa);
+
+	TC_PRINT("%5s %18s %18s\n", "IRKs", "single [res/s]", "batch [res/s]");
+
+	for (size_t c = 0; c < ARRAY_SIZE(irk_counts); c++) {
+		size_t count = irk_counts[c];
+		uint32_t start, single, batch;
+
+		start = k_cycle_get_32();
+		for (size_t n = 0; n < ITERATIONS; n++) {
+			for (size_t i = 0; i < count; i++) {
+				zassert_false(bt_rpa_irk_matches(irks[i], &rpa));
+			}
+		}
+		single = k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (size_t n = 0; n < ITERATIONS; n++) {
+			zassert_equal(bt_rpa_irk_matches_batch(irks, count, &rpa), -ENOENT);
+		}
+		batch = k_cycle_get_32() - start;
+
+		TC_PRINT("%5zu %18llu %18llu\n", count, resolutions_per_sec(single),
+			 resolutions_per_sec(batch));
+	}
+}
@@ -70,3 +70,82 @@ ZTEST(bt_crypto_ccm, test_result_rfc_test_vectors)
 		free(decrypted_data);
 	}
 }
+
+static const uint8_t test_key[16] = {0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7,
+				     0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF};
+static uint8_t test_nonce[13] = {0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00,
+				 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5};
+static const uint8_t test_aad[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+
+#define BENCH_MSG_LEN_MAX 1650
+#define BENCH_MSG_CNT     200
+
+static uint8_t msg[BENCH_MSG_LEN_MAX];
+static uint8_t enc[BENCH_MSG_LEN_MAX + 16];
+static uint8_t dec[BENCH_MSG_LEN_MAX];
+
+ZTEST(bt_crypto_ccm, test_mic_sizes)
+{
+	/* Odd MIC sizes are not supported by every AES-CCM implementation */
+	const size_t mic_sizes[] = {4, 5, 6, 8, 10, 12, 14, 16};
+	const size_t len = 100;
+
+	for (size_t i = 0; i < len; i++) {
+		msg[i] = i;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(mic_sizes); i++) {
+		size_t mic_size = mic_sizes[i];
+		int err;
+
+		err = bt_ccm_encrypt(test_key, test_nonce, msg, len, test_aad, sizeof(test_aad),
+				     enc, mic_size);
+		zassert_equal(err, 0, "Encrypt failed for MIC size %zu (err %d)", mic_size, err);
+
+		err = bt_ccm_decrypt(test_key, test_nonce, enc, len, test_aad, sizeof(test_aad),
+				     dec, mic_size);
+		zassert_equal(err, 0, "Decrypt failed for MIC size %zu (err %d)", mic_size, err);
+		zassert_mem_equal(dec, msg, len, "Wrong plaintext for MIC size %zu", mic_size);
+
+		enc[len + mic_size - 1] ^= 0x01;
+		err = bt_ccm_decrypt(test_key, test_nonce, enc, len, test_aad, sizeof(test_aad),
+				     dec, mic_size);
+		zassert_equal(err, -EBADMSG, "Wrong MIC accepted for MIC size %zu", mic_size);
+	}
+}
+
+/** Measure the cost of encrypting and decrypting messages of increasing size. */
+ZTEST(bt_crypto_ccm, test_throughput)
+{
+	const size_t lens[] = {16, 31, 251, BENCH_MSG_LEN_MAX};
+	const size_t mic_size = 4;
+
+	for (size_t i = 0; i < ARRAY_SIZE(lens); i++) {
+		size_t len = lens[i];
+		uint32_t encrypt;
+		uint32_t decrypt;
+		uint32_t start;
+		int err = 0;
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < BENCH_MSG_CNT; j++) {
+			err |= bt_ccm_encrypt(test_key, test_nonce, msg, len, test_aad,
+					      sizeof(test_aad), enc, mic_size);
+		}
+		encrypt = k_cycle_get_32() - start;
+
+		start = k_cycle_get_32();
+		for (int j = 0; j < BENCH_MSG_CNT; j++) {
+			err |= bt_ccm_decrypt(test_key, test_nonce, enc, len, test_aad,
+					      sizeof(test_aad), dec, mic_size);
+		}
+		decrypt = k_cycle_get_32() - start;
+
+		zassert_equal(err, 0);
+		zassert_mem_equal(dec, msg, len);
+
+		TC_PRINT("%4zu octets: encrypt %llu ns, decrypt %llu ns\n", len,
+			 k_cyc_to_ns_floor64(encrypt) / BENCH_MSG_CNT,
+			 k_cyc_to_ns_floor64(decrypt) / BENCH_MSG_CNT);
+	}
+}
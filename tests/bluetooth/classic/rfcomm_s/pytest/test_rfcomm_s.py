@@ -4,6 +4,7 @@
 
 import asyncio
 import logging
+import re
 import sys
 
 import bumble
@@ -707,6 +708,114 @@ async def tc_rfcomm_s_6(hci_port, shell, dut, address, snoop_file) -> None:
         await send_cmd_to_iut(shell, dut, "rfcomm_s send 7 1", "Unable to send", shell_ret=True)
 
 
+async def tc_rfcomm_s_7(hci_port, shell, dut, address, snoop_file) -> None:
+    case_name = 'Bulk Data Transfer Throughput with Credit Based Flow Control'
+    logger.info(f'<<< Start {case_name} ...')
+    dut_address = address.split(" ")[0]
+    bulk_size = 64 * 1024
+    bulk_frames = 64
+
+    async with await open_transport_or_link(hci_port) as hci_transport:
+        # Init Dongle State
+        device = Device.with_hci(
+            'Bumble',
+            Address('F0:F1:F2:F3:F4:F5'),
+            hci_transport.source,
+            hci_transport.sink,
+        )
+        device.classic_enabled = True
+        device.le_enabled = False
+        device.listener = DiscoveryListener()
+
+        device.host.snooper = BtSnooper(snoop_file)
+        await device_power_on(device)
+        await device.set_discoverable(True)
+        await device.set_connectable(True)
+        await device.send_command(HCI_Write_Page_Timeout_Command(page_timeout=0xFFFF))
+
+        # Initial Condition
+        logger.info('Initial Condition: Set DUT state...')
+        await send_cmd_to_iut(shell, dut, "br pscan on")  # set to connectable
+        await send_cmd_to_iut(shell, dut, "br iscan on")  # set to general discoverable
+        await send_cmd_to_iut(shell, dut, "rfcomm_s register 5")  # create RFCOMM server
+
+        # Connecting
+        logger.info(f'Initial Condition: establish be connection to {dut_address}...')
+        connection = await device.connect(dut_address, transport=BT_BR_EDR_TRANSPORT)
+        found, _ = await _wait_for_shell_response(dut, "Connected")
+        assert found is True, "DUT did not report connection established"
+
+        # Request authentication
+        logger.info('Initial Condition: Authenticating...')
+        await connection.authenticate()
+
+        # Enable encryption
+        logger.info('Initial Condition: Enabling encryption...')
+        await connection.encrypt()
+
+        # Create RFCOMM client
+        logger.info('Initial Condition: Create RFCOMM client...')
+        rfcomm_client = Client(connection)
+
+        channel_5 = 5
+
+        # Test Start
+        logger.info('Step 1: Initialize RFCOMM Session')
+        rfcomm_mux = await rfcomm_client.start()
+
+        logger.info('Step 2: Establish DLC with a large frame size')
+        dlc_5 = await rfcomm_mux.open_dlc(channel_5, max_frame_size=1000)
+        assert dlc_5, "Failed to establish DLC"
+
+        rx_bytes = 0
+
+        def count_rx(data):
+            nonlocal rx_bytes
+            rx_bytes += len(data)
+
+        dlc_5.sink = count_rx
+
+        logger.info(f'Step 3: Tester sends {bulk_size} bytes')
+        start = asyncio.get_running_loop().time()
+        dlc_5.write(bytes(i & 0xFF for i in range(bulk_size)))
+        await dlc_5.drain()
+        elapsed = asyncio.get_running_loop().time() - start
+        logger.info(f'Tester sent {bulk_size} bytes in {elapsed:.3f} s')
+        # Let the DUT process the last frames
+        await asyncio.sleep(1)
+
+        lines = await send_cmd_to_iut(
+            shell, dut, "rfcomm_s bulk_stats", f"Bulk received {bulk_size} bytes", shell_ret=True
+        )
+        logger.info(f'DUT RX throughput: {lines}')
+
+        logger.info(f'Step 4: DUT sends {bulk_frames} full frames')
+        shell.exec_command(f"rfcomm_s bulk_send {bulk_frames}")
+        found, lines = await _wait_for_shell_response(dut, "Bulk sent", max_wait_sec=30)
+        assert found, "DUT did not complete the bulk send"
+
+        sent = None
+        for line in lines:
+            match = re.search(r'Bulk sent (\d+) bytes', line)
+            if match:
+                sent = int(match.group(1))
+                logger.info(f'DUT TX throughput: {line}')
+                break
+        assert sent is not None, "DUT did not report the bulk send"
+
+        for _ in range(10):
+            if rx_bytes >= sent:
+                break
+            await asyncio.sleep(1)
+        assert rx_bytes == sent, f"Tester received {rx_bytes} of {sent} bytes"
+
+        logger.info('Step 5: DUT shutdown RFCOMM Session')
+        await send_cmd_to_iut(shell, dut, "rfcomm_s disconnect 5")
+        assert await wait_mux_response(rfcomm_utility.logger_capture, 'DISC received on dlc=0'), (
+            "DUT failed to disconnect DLC"
+        )
+
+
 class TestRFCOMM:
     def test_rfcomm_s_1(self, shell: Shell, dut: DeviceAdapter, device_under_test):
         """Reject RFCOMM Session."""
@@ -749,3 +858,10 @@ class TestRFCOMM:
         hci, iut_address = device_under_test
         with open(f"bumble_hci_{sys._getframe().f_code.co_name}.log", "wb") as snoop_file:
             asyncio.run(tc_rfcomm_s_6(hci, shell, dut, iut_address, snoop_file))
+
+    def test_rfcomm_s_7(self, shell: Shell, dut: DeviceAdapter, device_under_test):
+        """Bulk Data Transfer Throughput with Credit Based Flow Control."""
+        logger.info(f'RFCOMM-S-7 {device_under_test}')
+        hci, iut_address = device_under_test
+        with open(f"bumble_hci_{sys._getframe().f_code.co_name}.log", "wb") as snoop_file:
+            asyncio.run(tc_rfcomm_s_7(hci, shell, dut, iut_address, snoop_file))
@@ -26,8 +26,25 @@
 #include "common/bt_shell_private.h"
 
 #define DATA_MTU 48
+#define BULK_MTU 1000
 
 NET_BUF_POOL_FIXED_DEFINE(pool, 1, DATA_MTU, CONFIG_BT_CONN_TX_USER_DATA_SIZE, NULL);
+NET_BUF_POOL_FIXED_DEFINE(bulk_pool, CONFIG_BT_RFCOMM_TX_MAX, BT_RFCOMM_BUF_SIZE(BULK_MTU),
+			  CONFIG_BT_CONN_TX_USER_DATA_SIZE, NULL);
+
+/* Bulk transfer statistics of channel 5 */
+static struct {
+	uint32_t rx_bytes;
+	int64_t rx_start;
+	int64_t rx_last;
+	uint32_t tx_pending;
+	uint32_t tx_bytes;
+	int64_t tx_start;
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+	/* Last received frame, kept until the next one arrives */
+	struct net_buf *rx_held;
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
+} bulk;
 
 static struct bt_sdp_attribute spp_attrs[] = {
 	BT_SDP_NEW_SERVICE,
@@ -94,11 +111,51 @@ static struct bt_sdp_attribute spp_attrs[] = {
 static struct bt_sdp_record spp_rec = BT_SDP_RECORD(spp_attrs);
 
 /* DLC entity */
+static struct bt_rfcomm_dlc rfcomm_dlc_5;
+
 static void rfcomm_recv(struct bt_rfcomm_dlc *dlci, struct net_buf *buf)
 {
+	if (dlci == &rfcomm_dlc_5) {
+		bulk.rx_last = k_uptime_get();
+		if (bulk.rx_bytes == 0U) {
+			bulk.rx_start = bulk.rx_last;
+		}
+		bulk.rx_bytes += buf->len;
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+		if (bulk.rx_held != NULL) {
+			net_buf_unref(bulk.rx_held);
+		}
+		bulk.rx_held = net_buf_ref(buf);
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
+		return;
+	}
+
 	bt_shell_print("Incoming data dlc %p len %u", dlci, buf->len);
 }
 
+static void rfcomm_sent(struct bt_rfcomm_dlc *dlci, int err)
+{
+	int64_t delta;
+
+	if ((dlci != &rfcomm_dlc_5) || (bulk.tx_pending == 0U)) {
+		return;
+	}
+
+	if (err) {
+		bt_shell_error("Bulk send failed (err %d)", err);
+		bulk.tx_pending = 0U;
+		return;
+	}
+
+	if (--bulk.tx_pending) {
+		return;
+	}
+
+	delta = MAX(k_uptime_delta(&bulk.tx_start), 1);
+	bt_shell_print("Bulk sent %u bytes in %lld ms (%lld kbps)", bulk.tx_bytes, delta,
+		       (bulk.tx_bytes * 8LL) / delta);
+}
+
 static void rfcomm_connected(struct bt_rfcomm_dlc *dlci)
 {
 	bt_shell_print("Dlc %p connected", dlci);
@@ -106,11 +163,19 @@ static void rfcomm_connected(struct bt_rfcomm_dlc *dlci)
 
 static void rfcomm_disconnected(struct bt_rfcomm_dlc *dlci)
 {
+#if defined(CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS)
+	if ((dlci == &rfcomm_dlc_5) && (bulk.rx_held != NULL)) {
+		net_buf_unref(bulk.rx_held);
+		bulk.rx_held = NULL;
+	}
+#endif /* CONFIG_BT_RFCOMM_ADAPTIVE_CREDITS */
+
 	bt_shell_print("Dlc %p disconnected", dlci);
 }
 
 static struct bt_rfcomm_dlc_ops rfcomm_ops = {
 	.recv		= rfcomm_recv,
+	.sent		= rfcomm_sent,
 	.connected	= rfcomm_connected,
 	.disconnected	= rfcomm_disconnected,
 };
@@ -127,6 +192,11 @@ static struct bt_rfcomm_dlc rfcomm_dlc_7 = {
 	.mtu = 30,
 };
 
+static struct bt_rfcomm_dlc rfcomm_dlc_5 = {
+	.ops = &rfcomm_ops,
+	.mtu = BULK_MTU,
+};
+
 /* RFCOMM server entity */
 static int rfcomm_accept(struct bt_conn *conn, struct bt_rfcomm_server *server,
 			 struct bt_rfcomm_dlc **dlc)
@@ -137,6 +207,9 @@ static int rfcomm_accept(struct bt_conn *conn, struct bt_rfcomm_server *server,
 		rfcomm_dlc = &rfcomm_dlc_9;
 	} else if (server->channel == 7U) {
 		rfcomm_dlc = &rfcomm_dlc_7;
+	} else if (server->channel == 5U) {
+		rfcomm_dlc = &rfcomm_dlc_5;
+		memset(&bulk, 0, sizeof(bulk));
 	} else {
 		bt_shell_error("No channels available");
 		return -ENOMEM;
@@ -162,6 +235,10 @@ static struct bt_rfcomm_server rfcomm_server_7 = {
 	.accept = &rfcomm_accept,
 };
 
+static struct bt_rfcomm_server rfcomm_server_5 = {
+	.accept = &rfcomm_accept,
+};
+
 /* RFCOMM shell command */
 static int cmd_register(const struct shell *sh, size_t argc, char *argv[])
 {
@@ -173,8 +250,10 @@ static int cmd_register(const struct shell *sh, size_t argc, char *argv[])
 		rfcomm_server = &rfcomm_server_9;
 	} else if (channel == 7U) {
 		rfcomm_server = &rfcomm_server_7;
+	} else if (channel == 5U) {
+		rfcomm_server = &rfcomm_server_5;
 	} else {
-		shell_print(sh, "Channel %u isn't supported, just support channel 9 and 7",
+		shell_print(sh, "Channel %u isn't supported, just support channel 9, 7 and 5",
 			    channel);
 		return -ENOEXEC;
 	}
@@ -212,8 +291,10 @@ static int cmd_connect(const struct shell *sh, size_t argc, char *argv[])
 		rfcomm_dlc = &rfcomm_dlc_9;
 	} else if (channel == 7U) {
 		rfcomm_dlc = &rfcomm_dlc_7;
+	} else if (channel == 5U) {
+		rfcomm_dlc = &rfcomm_dlc_5;
 	} else {
-		shell_print(sh, "Channel %u isn't supported, just support channel 9 and 7",
+		shell_print(sh, "Channel %u isn't supported, just support channel 9, 7 and 5",
 			    channel);
 		return -ENOEXEC;
 	}
@@ -243,8 +324,10 @@ static int cmd_disconnect(const struct shell *sh, size_t argc, char *argv[])
 		rfcomm_dlc = &rfcomm_dlc_9;
 	} else if (channel == 7U) {
 		rfcomm_dlc = &rfcomm_dlc_7;
+	} else if (channel == 5U) {
+		rfcomm_dlc = &rfcomm_dlc_5;
 	} else {
-		shell_print(sh, "Channel %u isn't supported, just support channel 9 and 7",
+		shell_print(sh, "Channel %u isn't supported, just support channel 9, 7 and 5",
 			    channel);
 		return -ENOEXEC;
 	}
@@ -299,11 +382,68 @@ static int cmd_send(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+static int cmd_bulk_send(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct net_buf *buf;
+	uint32_t count;
+	int err, len;
+
+	if (!rfcomm_dlc_5.session) {
+		shell_error(sh, "Channel 5 is not connected");
+		return -ENOEXEC;
+	}
+
+	if (bulk.tx_pending) {
+		shell_error(sh, "Bulk send in progress");
+		return -EBUSY;
+	}
+
+	count = strtoul(argv[1], NULL, 10);
+	if (count == 0U) {
+		return -EINVAL;
+	}
+
+	bulk.tx_pending = count;
+	bulk.tx_bytes = 0U;
+	bulk.tx_start = k_uptime_get();
+
+	while (count--) {
+		buf = bt_rfcomm_create_pdu(&bulk_pool);
+		/* Should reserve one byte in tail for FCS */
+		len = MIN(rfcomm_dlc_5.mtu, net_buf_tailroom(buf) - 1);
+
+		(void)memset(net_buf_add(buf, len), (uint8_t)count, len);
+		err = bt_rfcomm_dlc_send(&rfcomm_dlc_5, buf);
+		if (err < 0) {
+			shell_error(sh, "Unable to send: %d", -err);
+			net_buf_unref(buf);
+			bulk.tx_pending = 0U;
+			return -ENOEXEC;
+		}
+
+		bulk.tx_bytes += len;
+	}
+
+	return 0;
+}
+
+static int cmd_bulk_stats(const struct shell *sh, size_t argc, char *argv[])
+{
+	int64_t delta = MAX(bulk.rx_last - bulk.rx_start, 1);
+
+	shell_print(sh, "Bulk received %u bytes in %lld ms (%lld kbps)", bulk.rx_bytes, delta,
+		    (bulk.rx_bytes * 8LL) / delta);
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(rfcomm_s_cmds,
 	SHELL_CMD_ARG(register, NULL, "<server channel>", cmd_register, 2, 0),
 	SHELL_CMD_ARG(connect, NULL, "<server channel>", cmd_connect, 2, 0),
 	SHELL_CMD_ARG(disconnect, NULL, "<server channel>", cmd_disconnect, 2, 0),
 	SHELL_CMD_ARG(send, NULL, "<server channel> <data>", cmd_send, 3, 0),
+	SHELL_CMD_ARG(bulk_send, NULL, "<frame count>", cmd_bulk_send, 2, 0),
+	SHELL_CMD_ARG(bulk_stats, NULL, NULL, cmd_bulk_stats, 1, 0),
 	SHELL_SUBCMD_SET_END
 );
 
@@ -0,0 +1,213 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <time.h>
+
+#include <zephyr/types.h>
+#include <zephyr/ztest.h>
+
+/* Unit under test, included to reach the static helpers */
+#include "ll_sw/lll_chan.c"
+
+#define BENCH_EVENT_COUNT    10000U
+#define BENCH_SUBEVENT_COUNT 8U
+
+static const uint16_t chan_id = 0x305F;
+
+static uint8_t chan_map_1[] = {0xFF, 0xFF, 0xFF, 0xFF, 0x1F};
+static const uint8_t chan_map_1_37_used = 37U;
+static uint8_t chan_map_2[] = {0x00, 0x06, 0xE0, 0x00, 0x1E};
+static const uint8_t chan_map_2_9_used = 9U;
+
+/* Reference implementations, walking the channel map bit by bit. The channel
+ * map walk of chan_sel_remap() is used as reference for chan_iso_remap().
+ */
+static uint8_t ref_chan_sel_remap_index(const uint8_t *chan_map, uint8_t chan_index)
+{
+	uint8_t remap_index = 0U;
+
+	if (chan_index >= CHAN_MAP_BITS) {
+		return 0U;
+	}
+
+	for (uint8_t chan = 0U; chan < chan_index; chan++) {
+		if (chan_map[chan >> 3] & BIT(chan & 0x07)) {
+			remap_index++;
+		}
+	}
+
+	return remap_index;
+}
+
+static uint16_t ref_chan_perm(uint16_t i)
+{
+	uint16_t rev = 0U;
+
+	for (uint8_t bit = 0U; bit < 8U; bit++) {
+		if (i & BIT(bit)) {
+			rev |= BIT(7U - bit);
+		}
+		if (i & BIT(8U + bit)) {
+			rev |= BIT(15U - bit);
+		}
+	}
+
+	return rev;
+}
+
+static uint8_t chan_count_get(const uint8_t *chan_map)
+{
+	uint8_t count = 0U;
+
+	for (uint8_t chan = 0U; chan < 37U; chan++) {
+		if (chan_map[chan >> 3] & BIT(chan & 0x07)) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/* Deterministic pseudo random channel maps with at least two used channels */
+static void chan_map_random(uint8_t *chan_map, uint32_t *seed)
+{
+	do {
+		for (uint8_t i = 0U; i < CHAN_MAP_OCTETS; i++) {
+			*seed = (*seed * 1103515245U) + 12345U;
+			chan_map[i] = *seed >> 16;
+		}
+		chan_map[4] &= 0x1F;
+	} while (chan_count_get(chan_map) < 2U);
+}
+
+static uint64_t bench_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * NSEC_PER_SEC) + ts.tv_nsec;
+}
+
+ZTEST(chan_sel, test_perm)
+{
+	for (uint32_t i = 0U; i <= UINT16_MAX; i++) {
+		zassert_equal(chan_perm(i), ref_chan_perm(i), "0x%04x", i);
+	}
+}
+
+ZTEST(chan_sel, test_remap)
+{
+	uint8_t chan_map[CHAN_MAP_OCTETS];
+	uint32_t seed = 1U;
+
+	for (uint16_t n = 0U; n < 1000U; n++) {
+		uint8_t count;
+
+		chan_map_random(chan_map, &seed);
+		count = chan_count_get(chan_map);
+
+		for (uint8_t i = 0U; i < CHAN_MAP_BITS; i++) {
+			zassert_equal(chan_iso_remap(chan_map, i),
+				      chan_sel_remap(chan_map, i));
+			zassert_equal(chan_sel_remap_index(chan_map, i),
+				      ref_chan_sel_remap_index(chan_map, i));
+		}
+
+		/* Alternate with another map to exercise rebuilding the tables */
+		zassert_equal(chan_iso_remap(chan_map_1, n % chan_map_1_37_used),
+			      n % chan_map_1_37_used);
+		zassert_equal(chan_iso_remap(chan_map, count - 1U),
+			      chan_sel_remap(chan_map, count - 1U));
+	}
+}
+
+/* Refer to Bluetooth Specification v5.2 Vol 6, Part C, Section 3 LE Channel
+ * Selection algorithm #2 sample data
+ */
+ZTEST(chan_sel, test_sample_data)
+{
+	uint16_t remap_idx;
+	uint16_t prn_s;
+	uint8_t m;
+
+	zassert_equal(lll_chan_sel_2(0U, chan_id, chan_map_1, chan_map_1_37_used), 25U);
+	zassert_equal(lll_chan_sel_2(1U, chan_id, chan_map_1, chan_map_1_37_used), 20U);
+	zassert_equal(lll_chan_sel_2(2U, chan_id, chan_map_1, chan_map_1_37_used), 6U);
+	zassert_equal(lll_chan_sel_2(3U, chan_id, chan_map_1, chan_map_1_37_used), 21U);
+
+	zassert_equal(lll_chan_sel_2(6U, chan_id, chan_map_2, chan_map_2_9_used), 23U);
+	zassert_equal(lll_chan_sel_2(7U, chan_id, chan_map_2, chan_map_2_9_used), 9U);
+	zassert_equal(lll_chan_sel_2(8U, chan_id, chan_map_2, chan_map_2_9_used), 34U);
+
+	m = lll_chan_iso_event(1U, chan_id, chan_map_1, chan_map_1_37_used, &prn_s, &remap_idx);
+	zassert_equal(prn_s ^ chan_id, 1685U);
+	zassert_equal(m, 20U);
+	zassert_equal(remap_idx, 20U);
+
+	m = lll_chan_iso_subevent(chan_id, chan_map_1, chan_map_1_37_used, &prn_s, &remap_idx);
+	zassert_equal(remap_idx, 36U);
+	zassert_equal(m, 36U);
+
+	m = lll_chan_iso_subevent(chan_id, chan_map_1, chan_map_1_37_used, &prn_s, &remap_idx);
+	zassert_equal(remap_idx, 12U);
+	zassert_equal(m, 12U);
+
+	m = lll_chan_iso_subevent(chan_id, chan_map_1, chan_map_1_37_used, &prn_s, &remap_idx);
+	zassert_equal(remap_idx, 34U);
+	zassert_equal(m, 34U);
+}
+
+/* Measure the channel selection of ISO events with several subevents, using the
+ * used channel tables and walking the channel map.
+ */
+ZTEST(chan_sel, test_iso_subevent_cost)
+{
+	uint64_t cached;
+	uint64_t walked;
+	uint64_t start;
+	uint32_t sum[2] = {0U};
+
+	start = bench_ns();
+	for (uint16_t counter = 0U; counter < BENCH_EVENT_COUNT; counter++) {
+		uint16_t remap_idx;
+		uint16_t prn_s;
+
+		sum[0] += lll_chan_iso_event(counter, chan_id, chan_map_2, chan_map_2_9_used,
+					     &prn_s, &remap_idx);
+		for (uint8_t se = 1U; se < BENCH_SUBEVENT_COUNT; se++) {
+			sum[0] += lll_chan_iso_subevent(chan_id, chan_map_2, chan_map_2_9_used,
+							&prn_s, &remap_idx);
+		}
+	}
+	cached = bench_ns() - start;
+
+	/* Same sequence, invalidating the tables before each selection so
+	 * that each one walks the channel map again.
+	 */
+	start = bench_ns();
+	for (uint16_t counter = 0U; counter < BENCH_EVENT_COUNT; counter++) {
+		uint16_t remap_idx;
+		uint16_t prn_s;
+
+		chan_remap.chan_map[0] = ~chan_map_2[0];
+		sum[1] += lll_chan_iso_event(counter, chan_id, chan_map_2, chan_map_2_9_used,
+					     &prn_s, &remap_idx);
+		for (uint8_t se = 1U; se < BENCH_SUBEVENT_COUNT; se++) {
+			chan_remap.chan_map[0] = ~chan_map_2[0];
+			sum[1] += lll_chan_iso_subevent(chan_id, chan_map_2, chan_map_2_9_used,
+							&prn_s, &remap_idx);
+		}
+	}
+	walked = bench_ns() - start;
+
+	zassert_equal(sum[0], sum[1]);
+
+	TC_PRINT("%u subevents: cached tables %llu ns, map walk %llu ns per event\n",
+		 BENCH_SUBEVENT_COUNT, cached / BENCH_EVENT_COUNT, walked / BENCH_EVENT_COUNT);
+}
+
+ZTEST_SUITE(chan_sel, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,471 @@
+/* main.c - HCI command pipelining test */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/buf.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/drivers/bluetooth.h>
+#include <zephyr/sys/byteorder.h>
+
+#define DT_DRV_COMPAT zephyr_bt_hci_test
+
+/* Vendor specific commands only known to this test */
+#define TEST_OP_A    BT_OP(BT_OGF_VS, 0x3f0)
+#define TEST_OP_B    BT_OP(BT_OGF_VS, 0x3f1)
+#define TEST_OP_FAIL BT_OP(BT_OGF_VS, 0x3f2)
+
+/* Number of commands the fake Controller reports it can accept */
+#define NCMD CONFIG_BT_HCI_CMD_PIPELINE_MAX
+
+#define HELD_MAX 8
+
+struct driver_data {
+	bt_hci_recv_t recv;
+};
+
+/* Return parameters of the test commands */
+struct test_rp {
+	uint8_t status;
+	uint8_t ocf;
+} __packed;
+
+/* Command handler structure for cmd_handle(). */
+struct cmd_handler {
+	uint16_t opcode; /* HCI command opcode */
+	uint8_t len;     /* HCI command response length */
+	void (*handler)(struct net_buf **evt, uint8_t len, uint16_t opcode);
+};
+
+/* Commands whose response is held back by the fake Controller */
+static struct {
+	uint16_t opcode[HELD_MAX];
+	size_t count;
+	/* Release automatically once this many are held, 0 for never */
+	size_t release_at;
+	/* Highest number of responses held back at the same time */
+	size_t count_max;
+} held;
+
+static K_SEM_DEFINE(held_sem, 0, HELD_MAX);
+
+/* Highest number of responses held back during bt_enable() */
+static size_t init_held_max;
+
+/* Add event to net_buf. */
+static void evt_create(struct net_buf *buf, uint8_t evt, uint8_t len)
+{
+	struct bt_hci_evt_hdr *hdr;
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->evt = evt;
+	hdr->len = len;
+}
+
+/* Create a command complete event. */
+static void *cmd_complete(struct net_buf **buf, uint8_t plen, uint16_t opcode)
+{
+	struct bt_hci_evt_cmd_complete *cc;
+
+	*buf = bt_buf_get_evt(BT_HCI_EVT_CMD_COMPLETE, false, K_FOREVER);
+	evt_create(*buf, BT_HCI_EVT_CMD_COMPLETE, sizeof(*cc) + plen);
+	cc = net_buf_add(*buf, sizeof(*cc));
+	cc->ncmd = NCMD;
+	cc->opcode = sys_cpu_to_le16(opcode);
+	return net_buf_add(*buf, plen);
+}
+
+/* Generic command complete with success status. */
+static void generic_success(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_evt_cc_status *ccst;
+
+	ccst = cmd_complete(evt, len, opcode);
+
+	/* Fill any event parameters with zero */
+	(void)memset(ccst, 0, len);
+
+	ccst->status = BT_HCI_ERR_SUCCESS;
+}
+
+/* Bogus handler for BT_HCI_OP_READ_LOCAL_FEATURES. */
+static void read_local_features(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_rp_read_local_features *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	rp->status = 0x00;
+	(void)memset(&rp->features[0], 0xFF, sizeof(rp->features));
+}
+
+/* Bogus handler for BT_HCI_OP_READ_SUPPORTED_COMMANDS. */
+static void read_supported_commands(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_rp_read_supported_commands *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	(void)memset(&rp->commands[0], 0xFF, sizeof(rp->commands));
+	rp->status = 0x00;
+}
+
+/* Bogus handler for BT_HCI_OP_LE_READ_LOCAL_FEATURES. */
+static void le_read_local_features(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_rp_le_read_local_features *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	rp->status = 0x00;
+	(void)memset(&rp->features[0], 0xFF, sizeof(rp->features));
+}
+
+/* Bogus handler for BT_HCI_OP_LE_READ_SUPP_STATES. */
+static void le_read_supp_states(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_rp_le_read_supp_states *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	rp->status = 0x00;
+	(void)memset(&rp->le_states, 0xFF, sizeof(rp->le_states));
+}
+
+/* Handler for the test commands, echoing the OCF. */
+static void test_cmd(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct test_rp *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	rp->status = opcode == TEST_OP_FAIL ? BT_HCI_ERR_CMD_DISALLOWED : BT_HCI_ERR_SUCCESS;
+	rp->ocf = BT_OCF(opcode);
+}
+
+/* Setup handlers needed for bt_enable to function. */
+static const struct cmd_handler cmds[] = {
+	{ BT_HCI_OP_READ_LOCAL_VERSION_INFO,
+	  sizeof(struct bt_hci_rp_read_local_version_info),
+	  generic_success },
+	{ BT_HCI_OP_READ_SUPPORTED_COMMANDS,
+	  sizeof(struct bt_hci_rp_read_supported_commands),
+	  read_supported_commands },
+	{ BT_HCI_OP_READ_LOCAL_FEATURES,
+	  sizeof(struct bt_hci_rp_read_local_features),
+	  read_local_features },
+	{ BT_HCI_OP_READ_BD_ADDR,
+	  sizeof(struct bt_hci_rp_read_bd_addr),
+	  generic_success },
+	{ BT_HCI_OP_SET_EVENT_MASK,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_EVENT_MASK,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+	{ BT_HCI_OP_LE_READ_LOCAL_FEATURES,
+	  sizeof(struct bt_hci_rp_le_read_local_features),
+	  le_read_local_features },
+	{ BT_HCI_OP_LE_READ_SUPP_STATES,
+	  sizeof(struct bt_hci_rp_le_read_supp_states),
+	  le_read_supp_states },
+	{ BT_HCI_OP_LE_RAND,
+	  sizeof(struct bt_hci_rp_le_rand),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_RANDOM_ADDRESS,
+	  sizeof(struct bt_hci_cp_le_set_random_address),
+	  generic_success },
+	{ BT_HCI_OP_LE_READ_MAX_ADV_DATA_LEN,
+	  sizeof(struct bt_hci_rp_le_read_max_adv_data_len),
+	  generic_success },
+	{ TEST_OP_A, sizeof(struct test_rp), test_cmd },
+	{ TEST_OP_B, sizeof(struct test_rp), test_cmd },
+	{ TEST_OP_FAIL, sizeof(struct test_rp), test_cmd },
+};
+
+/* Create the response to the command given by opcode. */
+static struct net_buf *cmd_response(uint16_t opcode)
+{
+	struct net_buf *evt = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		if (cmds[i].opcode == opcode) {
+			cmds[i].handler(&evt, cmds[i].len, opcode);
+			return evt;
+		}
+	}
+
+	struct bt_hci_evt_cc_status *ccst;
+
+	ccst = cmd_complete(&evt, sizeof(*ccst), opcode);
+	ccst->status = BT_HCI_ERR_UNKNOWN_CMD;
+
+	return evt;
+}
+
+/* Send the responses held back, in the order the commands were received. */
+static void held_release(struct k_work *work)
+{
+	const struct device *dev = DEVICE_DT_GET(DT_DRV_INST(0));
+	struct driver_data *drv = dev->data;
+	uint16_t opcode[HELD_MAX];
+	size_t count;
+
+	count = held.count;
+	memcpy(opcode, held.opcode, count * sizeof(opcode[0]));
+	held.count = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		drv->recv(dev, cmd_response(opcode[i]));
+	}
+}
+
+static K_WORK_DEFINE(held_release_work, held_release);
+
+/* Advertise NCMD commands with unsolicited Command Complete events. */
+static void nop_send(struct k_work *work)
+{
+	const struct device *dev = DEVICE_DT_GET(DT_DRV_INST(0));
+	struct driver_data *drv = dev->data;
+
+	for (size_t i = 0; i < NCMD; i++) {
+		struct net_buf *evt;
+
+		(void)cmd_complete(&evt, 0, BT_OP_NOP);
+		drv->recv(dev, evt);
+	}
+}
+
+static K_WORK_DEFINE(nop_work, nop_send);
+
+static bool is_held(uint16_t opcode)
+{
+	switch (opcode) {
+	case BT_HCI_OP_READ_LOCAL_FEATURES:
+	case BT_HCI_OP_READ_LOCAL_VERSION_INFO:
+	case BT_HCI_OP_READ_SUPPORTED_COMMANDS:
+	case TEST_OP_A:
+	case TEST_OP_B:
+	case TEST_OP_FAIL:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* HCI driver open. */
+static int driver_open(const struct device *dev, bt_hci_recv_t recv)
+{
+	struct driver_data *drv = dev->data;
+
+	drv->recv = recv;
+
+	k_work_submit(&nop_work);
+
+	return 0;
+}
+
+/*  HCI driver send.  */
+static int driver_send(const struct device *dev, struct net_buf *buf)
+{
+	struct driver_data *drv = dev->data;
+	struct bt_hci_cmd_hdr *chdr;
+	uint8_t type = net_buf_pull_u8(buf);
+	uint16_t opcode;
+
+	zassert_true(type == BT_HCI_H4_CMD, "Expected command buffer, got %u", type);
+
+	chdr = net_buf_pull_mem(buf, sizeof(*chdr));
+	opcode = sys_le16_to_cpu(chdr->opcode);
+	net_buf_unref(buf);
+
+	/* No response is expected to this one */
+	if (opcode == BT_HCI_OP_HOST_NUM_COMPLETED_PACKETS) {
+		return 0;
+	}
+
+	if (!is_held(opcode)) {
+		drv->recv(dev, cmd_response(opcode));
+		return 0;
+	}
+
+	for (size_t i = 0; i < held.count; i++) {
+		zassert_not_equal(held.opcode[i], opcode,
+				  "OpCode 0x%04x sent while outstanding", opcode);
+	}
+
+	zassert_true(held.count < HELD_MAX, "Too many commands outstanding");
+	held.opcode[held.count++] = opcode;
+	held.count_max = MAX(held.count_max, held.count);
+	k_sem_give(&held_sem);
+
+	if (held.count == held.release_at) {
+		k_work_submit(&held_release_work);
+	}
+
+	return 0;
+}
+
+static DEVICE_API(bt_hci, driver_api) = {
+	.open = driver_open,
+	.send = driver_send,
+};
+
+#define TEST_DEVICE_INIT(inst) \
+	static struct driver_data driver_data_##inst = { \
+	}; \
+	DEVICE_DT_INST_DEFINE(inst, NULL, NULL, &driver_data_##inst, NULL, \
+			      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &driver_api)
+
+DT_INST_FOREACH_STATUS_OKAY(TEST_DEVICE_INIT)
+
+/* Completions seen by cmd_cb(), in order */
+static struct {
+	uint16_t opcode;
+	uint8_t status;
+	bool rsp;
+	uint8_t rsp_status;
+	uint8_t rsp_ocf;
+} done[HELD_MAX];
+static size_t done_count;
+
+static K_SEM_DEFINE(done_sem, 0, HELD_MAX);
+
+static void cmd_cb(uint16_t opcode, uint8_t status, struct net_buf *rsp, void *user_data)
+{
+	zassert_true(done_count < ARRAY_SIZE(done), "Too many completions");
+	zassert_equal_ptr(user_data, &done_count, "Unexpected user data");
+
+	done[done_count].opcode = opcode;
+	done[done_count].status = status;
+	done[done_count].rsp = rsp != NULL;
+
+	if (rsp && rsp->len >= sizeof(struct test_rp)) {
+		struct test_rp *rp = (void *)rsp->data;
+
+		done[done_count].rsp_status = rp->status;
+		done[done_count].rsp_ocf = rp->ocf;
+	}
+
+	done_count++;
+	k_sem_give(&done_sem);
+}
+
+static void send_cb(uint16_t opcode)
+{
+	zassert_ok(bt_hci_cmd_send_cb(opcode, NULL, cmd_cb, &done_count));
+}
+
+/* Wait until the fake Controller has received count held commands. */
+static void held_wait(size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&held_sem, K_MSEC(100)), "Command not sent");
+	}
+
+	/* Nothing else may be sent while the responses are held */
+	zassert_equal(k_sem_take(&held_sem, K_MSEC(100)), -EAGAIN, "Unexpected command");
+}
+
+/* Wait for count completions. */
+static void done_wait(size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(100)), "Command not completed");
+	}
+}
+
+static void *setup(void)
+{
+	/* Complete the initial reads only once all of them are outstanding */
+	held.release_at = 3;
+
+	zassert_ok(bt_enable(NULL), "bt_enable failed");
+	init_held_max = held.count_max;
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	held.release_at = 0;
+	held.count_max = 0;
+	done_count = 0;
+	k_sem_reset(&held_sem);
+	k_sem_reset(&done_sem);
+}
+
+ZTEST_SUITE(test_hci_cmd_pipeline, NULL, setup, before, NULL, NULL);
+
+/* The independent reads of the initialization are pipelined. */
+ZTEST(test_hci_cmd_pipeline, test_init_reads)
+{
+	/* bt_enable() would have timed out had the reads been sent one by one */
+	zassert_true(bt_is_ready());
+	zassert_equal(init_held_max, 3, "Reads not outstanding together");
+}
+
+/* Commands are sent in order, a repeated OpCode waits for the first one. */
+ZTEST(test_hci_cmd_pipeline, test_same_opcode)
+{
+	send_cb(TEST_OP_A);
+	send_cb(TEST_OP_A);
+	send_cb(TEST_OP_B);
+
+	/* The second TEST_OP_A is held back by the host, not TEST_OP_B */
+	held_wait(2);
+	zassert_equal(held.opcode[0], TEST_OP_A);
+	zassert_equal(held.opcode[1], TEST_OP_B);
+
+	k_work_submit(&held_release_work);
+	held_wait(1);
+	zassert_equal(held.opcode[0], TEST_OP_A);
+
+	k_work_submit(&held_release_work);
+	done_wait(3);
+
+	zassert_equal(done[0].opcode, TEST_OP_A);
+	zassert_equal(done[1].opcode, TEST_OP_B);
+	zassert_equal(done[2].opcode, TEST_OP_A);
+	zassert_equal(held.count_max, 2);
+}
+
+/* The callback gets the status and the return parameters. */
+ZTEST(test_hci_cmd_pipeline, test_cb_status)
+{
+	send_cb(TEST_OP_B);
+	send_cb(TEST_OP_FAIL);
+
+	held_wait(2);
+	k_work_submit(&held_release_work);
+	done_wait(2);
+
+	zassert_equal(done[0].opcode, TEST_OP_B);
+	zassert_equal(done[0].status, BT_HCI_ERR_SUCCESS);
+	zassert_true(done[0].rsp);
+	zassert_equal(done[0].rsp_status, BT_HCI_ERR_SUCCESS);
+	zassert_equal(done[0].rsp_ocf, BT_OCF(TEST_OP_B));
+
+	zassert_equal(done[1].opcode, TEST_OP_FAIL);
+	zassert_equal(done[1].status, BT_HCI_ERR_CMD_DISALLOWED);
+	zassert_true(done[1].rsp);
+	zassert_equal(done[1].rsp_status, BT_HCI_ERR_CMD_DISALLOWED);
+	zassert_equal(done[1].rsp_ocf, BT_OCF(TEST_OP_FAIL));
+}
+
+/* Host Number Of Completed Packets has no response, the callback is still
+ * called once the command has been passed to the driver.
+ */
+ZTEST(test_hci_cmd_pipeline, test_host_num_completed_packets)
+{
+	send_cb(BT_HCI_OP_HOST_NUM_COMPLETED_PACKETS);
+
+	zassert_equal(done_count, 1);
+	zassert_equal(done[0].opcode, BT_HCI_OP_HOST_NUM_COMPLETED_PACKETS);
+	zassert_equal(done[0].status, BT_HCI_ERR_SUCCESS);
+	zassert_false(done[0].rsp);
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Minimal stand-in for the libsbc decoder header */
+
+#include <stdint.h>
+
+typedef struct {
+	uint32_t unused;
+} OI_CODEC_SBC_DECODER_CONTEXT;
+
+#define SBC_CODEC_FAST_FILTER_BUFFERS 1
+#define CODEC_DATA_WORDS(channels, buffers) (1)
@@ -0,0 +1,9 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Minimal stand-in for the libsbc status header */
+
+typedef int OI_STATUS;
@@ -0,0 +1,20 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Minimal stand-in for the libsbc encoder header */
+
+#include <stdint.h>
+
+typedef struct {
+	int16_t s16ChannelMode;
+	int16_t s16NumOfSubBands;
+	int16_t s16NumOfBlocks;
+	int16_t s16AllocationMethod;
+	int16_t s16NumOfChannels;
+	int16_t s16SamplingFreq;
+	int16_t s16BitPool;
+	uint16_t u16BitRate;
+} SBC_ENC_PARAMS;
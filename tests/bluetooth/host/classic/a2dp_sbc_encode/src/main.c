@@ -0,0 +1,242 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/bluetooth/classic/a2dp_codec_sbc.h>
+#include <zephyr/bluetooth/classic/a2dp.h>
+#include <zephyr/bluetooth/sbc.h>
+
+#include "host/classic/avdtp_internal.h"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(uint32_t, bt_a2dp_get_mtu, struct bt_a2dp_stream *);
+FAKE_VALUE_FUNC(int, sbc_frame_encoded_bytes, struct sbc_encoder *);
+FAKE_VALUE_FUNC(int, sbc_frame_bytes, struct sbc_encoder *);
+FAKE_VALUE_FUNC(uint32_t, sbc_encode, struct sbc_encoder *, const void *, void *);
+
+#define MEDIA_HDR_SIZE  sizeof(struct bt_avdtp_media_hdr)
+/* Offset of the SBC media payload header, after the AVDTP media header */
+#define SBC_HDR_OFFSET  MEDIA_HDR_SIZE
+#define SBC_FRAME_LEN   20
+#define PCM_FRAME_LEN   8
+#define PCM_FRAMES      20
+
+static struct bt_a2dp_ep ep = {
+	.codec_type = BT_A2DP_SBC,
+};
+static struct bt_a2dp_stream stream = {
+	.local_ep = &ep,
+};
+static struct sbc_encoder encoder;
+static uint8_t pcm[PCM_FRAMES * PCM_FRAME_LEN];
+static uint8_t buf_data[512];
+static struct net_buf buf;
+
+static uint32_t sbc_encode_custom_fake(struct sbc_encoder *enc, const void *in, void *out)
+{
+	/* Tag each frame with its PCM frame index to check the packing order */
+	memset(out, ((const uint8_t *)in - pcm) / PCM_FRAME_LEN, SBC_FRAME_LEN);
+
+	return SBC_FRAME_LEN;
+}
+
+static void buf_reset(uint16_t size)
+{
+	buf.__buf = buf_data;
+	buf.data = buf_data;
+	buf.size = size;
+	buf.len = 0U;
+
+	/* As left by bt_a2dp_stream_create_pdu() */
+	net_buf_add(&buf, MEDIA_HDR_SIZE);
+}
+
+static uint8_t sbc_hdr_frames(void)
+{
+	return BT_A2DP_SBC_MEDIA_HDR_NUM_FRAMES_GET(buf.data[SBC_HDR_OFFSET]);
+}
+
+static void fff_reset_rule_before(const struct ztest_unit_test *test, void *fixture)
+{
+	RESET_FAKE(bt_a2dp_get_mtu);
+	RESET_FAKE(sbc_frame_encoded_bytes);
+	RESET_FAKE(sbc_frame_bytes);
+	RESET_FAKE(sbc_encode);
+
+	sbc_frame_encoded_bytes_fake.return_val = SBC_FRAME_LEN;
+	sbc_frame_bytes_fake.return_val = PCM_FRAME_LEN;
+	sbc_encode_fake.custom_fake = sbc_encode_custom_fake;
+	ep.codec_type = BT_A2DP_SBC;
+	buf_reset(sizeof(buf_data));
+}
+
+ZTEST_RULE(fff_reset_rule, fff_reset_rule_before, NULL);
+
+ZTEST_SUITE(a2dp_sbc_encode, NULL, NULL, NULL, NULL, NULL);
+
+/*
+ *  Frames that fit in the MTU
+ *
+ *  Expected behaviour:
+ *   - Limited by the MTU minus the AVDTP and SBC media headers
+ *   - Limited to 15 by the SBC media header Number of Frames field
+ *   - -EMSGSIZE when not even one frame fits
+ */
+ZTEST(a2dp_sbc_encode, test_frames_max)
+{
+	bt_a2dp_get_mtu_fake.return_val = MEDIA_HDR_SIZE + 1 + 9 * SBC_FRAME_LEN + 1;
+	zassert_equal(bt_a2dp_stream_sbc_frames_max(&stream, &encoder), 9);
+
+	bt_a2dp_get_mtu_fake.return_val = MEDIA_HDR_SIZE + 1 + 20 * SBC_FRAME_LEN;
+	zassert_equal(bt_a2dp_stream_sbc_frames_max(&stream, &encoder), 15);
+
+	bt_a2dp_get_mtu_fake.return_val = MEDIA_HDR_SIZE + 1 + SBC_FRAME_LEN - 1;
+	zassert_equal(bt_a2dp_stream_sbc_frames_max(&stream, &encoder), -EMSGSIZE);
+}
+
+/*
+ *  Fill one packet over several calls
+ *
+ *  Expected behaviour:
+ *   - The SBC media header is added once, after the AVDTP media header
+ *   - Frames are appended in PCM order and the header count follows them
+ *   - Encoding stops at the MTU, with the unused PCM left to the caller
+ */
+ZTEST(a2dp_sbc_encode, test_packing)
+{
+	int ret;
+
+	bt_a2dp_get_mtu_fake.return_val = MEDIA_HDR_SIZE + 1 + 9 * SBC_FRAME_LEN + 1;
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, pcm, 3 * PCM_FRAME_LEN);
+	zassert_equal(ret, 3 * PCM_FRAME_LEN);
+	zassert_equal(buf.len, MEDIA_HDR_SIZE + 1 + 3 * SBC_FRAME_LEN);
+	zassert_equal(sbc_hdr_frames(), 3);
+
+	/* Half a frame of PCM left over is not encoded */
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, &pcm[3 * PCM_FRAME_LEN],
+					2 * PCM_FRAME_LEN + PCM_FRAME_LEN / 2);
+	zassert_equal(ret, 2 * PCM_FRAME_LEN);
+	zassert_equal(sbc_hdr_frames(), 5);
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, &pcm[5 * PCM_FRAME_LEN],
+					10 * PCM_FRAME_LEN);
+	zassert_equal(ret, 4 * PCM_FRAME_LEN);
+	zassert_equal(buf.len, MEDIA_HDR_SIZE + 1 + 9 * SBC_FRAME_LEN);
+	zassert_equal(sbc_hdr_frames(), 9);
+	zassert_true(buf.len <= bt_a2dp_get_mtu_fake.return_val);
+
+	for (int i = 0; i < 9; i++) {
+		zassert_equal(buf.data[SBC_HDR_OFFSET + 1 + i * SBC_FRAME_LEN], i);
+	}
+
+	/* Full packet */
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, &pcm[9 * PCM_FRAME_LEN],
+					PCM_FRAME_LEN);
+	zassert_equal(ret, 0);
+	zassert_equal(sbc_hdr_frames(), 9);
+	zassert_equal(sbc_encode_fake.call_count, 9);
+}
+
+/*
+ *  Frames per packet selected by the caller
+ *
+ *  Expected behaviour:
+ *   - The packet holds at most frames_max frames, across calls
+ */
+ZTEST(a2dp_sbc_encode, test_frames_per_packet)
+{
+	int ret;
+
+	bt_a2dp_get_mtu_fake.return_val = MEDIA_HDR_SIZE + 1 + 15 * SBC_FRAME_LEN;
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 4U, pcm, 3 * PCM_FRAME_LEN);
+	zassert_equal(ret, 3 * PCM_FRAME_LEN);
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 4U, pcm, 3 * PCM_FRAME_LEN);
+	zassert_equal(ret, PCM_FRAME_LEN);
+	zassert_equal(sbc_hdr_frames(), 4);
+	zassert_equal(buf.len, MEDIA_HDR_SIZE + 1 + 4 * SBC_FRAME_LEN);
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 4U, pcm, PCM_FRAME_LEN);
+	zassert_equal(ret, 0);
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 16U, pcm, PCM_FRAME_LEN);
+	zassert_equal(ret, -EINVAL);
+}
+
+/*
+ *  Number of Frames field limit
+ *
+ *  Expected behaviour:
+ *   - No more than 15 frames even if the MTU allows more
+ */
+ZTEST(a2dp_sbc_encode, test_frames_field_limit)
+{
+	int ret;
+
+	bt_a2dp_get_mtu_fake.return_val = sizeof(buf_data);
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, pcm, sizeof(pcm));
+	zassert_equal(ret, 15 * PCM_FRAME_LEN);
+	zassert_equal(sbc_hdr_frames(), 15);
+	zassert_equal(buf.len, MEDIA_HDR_SIZE + 1 + 15 * SBC_FRAME_LEN);
+}
+
+/*
+ *  Buffer smaller than the MTU
+ *
+ *  Expected behaviour:
+ *   - Frames never overflow the buffer tailroom
+ */
+ZTEST(a2dp_sbc_encode, test_tailroom_limit)
+{
+	int ret;
+
+	bt_a2dp_get_mtu_fake.return_val = sizeof(buf_data);
+	buf_reset(MEDIA_HDR_SIZE + 1 + 4 * SBC_FRAME_LEN + SBC_FRAME_LEN / 2);
+
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, pcm, sizeof(pcm));
+	zassert_equal(ret, 4 * PCM_FRAME_LEN);
+	zassert_equal(sbc_hdr_frames(), 4);
+	zassert_true(buf.len <= buf.size);
+}
+
+/*
+ *  Invalid use
+ *
+ *  Expected behaviour:
+ *   - -ENOTSUP on a non SBC stream
+ *   - -EINVAL without the AVDTP media header
+ *   - -EIO on an encoder failure, with the frames already encoded counted
+ */
+ZTEST(a2dp_sbc_encode, test_errors)
+{
+	uint32_t encode_ret[] = {SBC_FRAME_LEN, 0U};
+	int ret;
+
+	bt_a2dp_get_mtu_fake.return_val = sizeof(buf_data);
+
+	ep.codec_type = BT_A2DP_MPEG1;
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, pcm, sizeof(pcm));
+	zassert_equal(ret, -ENOTSUP);
+	ep.codec_type = BT_A2DP_SBC;
+
+	buf.len = MEDIA_HDR_SIZE - 1;
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, pcm, sizeof(pcm));
+	zassert_equal(ret, -EINVAL);
+	buf_reset(sizeof(buf_data));
+
+	sbc_encode_fake.custom_fake = NULL;
+	SET_RETURN_SEQ(sbc_encode, encode_ret, ARRAY_SIZE(encode_ret));
+	ret = bt_a2dp_stream_sbc_encode(&stream, &encoder, &buf, 0U, pcm, sizeof(pcm));
+	zassert_equal(ret, -EIO);
+	zassert_equal(sbc_hdr_frames(), 1);
+	zassert_equal(buf.len, MEDIA_HDR_SIZE + 1 + SBC_FRAME_LEN);
+}
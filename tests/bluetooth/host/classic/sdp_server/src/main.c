@@ -0,0 +1,772 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/bluetooth/l2cap.h>
+#include <zephyr/bluetooth/classic/sdp.h>
+
+#include "host/classic/sdp_internal.h"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, bt_l2cap_br_server_register, struct bt_l2cap_server *);
+FAKE_VALUE_FUNC(struct net_buf *, bt_l2cap_create_pdu_timeout, struct net_buf_pool *, size_t,
+		k_timeout_t);
+FAKE_VALUE_FUNC(int, bt_l2cap_chan_send, struct bt_l2cap_chan *, struct net_buf *);
+FAKE_VALUE_FUNC(int, bt_l2cap_chan_disconnect, struct bt_l2cap_chan *);
+FAKE_VALUE_FUNC(int, bt_l2cap_br_chan_connect, struct bt_conn *, struct bt_l2cap_chan *,
+		uint16_t);
+FAKE_VALUE_FUNC(uint8_t, bt_conn_index, const struct bt_conn *);
+FAKE_VALUE_FUNC(struct bt_conn *, bt_conn_lookup_index, uint8_t);
+FAKE_VOID_FUNC(bt_conn_unref, struct bt_conn *);
+FAKE_VALUE_FUNC(int, k_sem_init, struct k_sem *, unsigned int, unsigned int);
+FAKE_VALUE_FUNC(int, k_sem_take, struct k_sem *, k_timeout_t);
+FAKE_VOID_FUNC(k_sem_give, struct k_sem *);
+FAKE_VALUE_FUNC(struct net_buf *, net_buf_alloc_fixed, struct net_buf_pool *, k_timeout_t);
+FAKE_VOID_FUNC(net_buf_unref, struct net_buf *);
+FAKE_VOID_FUNC(net_buf_reset, struct net_buf *);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(bt_l2cap_br_server_register)                                                          \
+	FAKE(bt_l2cap_create_pdu_timeout)                                                          \
+	FAKE(bt_l2cap_chan_send)                                                                   \
+	FAKE(bt_l2cap_chan_disconnect)                                                             \
+	FAKE(bt_l2cap_br_chan_connect)                                                             \
+	FAKE(bt_conn_index)                                                                        \
+	FAKE(bt_conn_lookup_index)                                                                 \
+	FAKE(bt_conn_unref)                                                                        \
+	FAKE(k_sem_init)                                                                           \
+	FAKE(k_sem_take)                                                                           \
+	FAKE(k_sem_give)                                                                           \
+	FAKE(net_buf_alloc_fixed)                                                                  \
+	FAKE(net_buf_unref)                                                                        \
+	FAKE(net_buf_reset)
+
+const struct net_buf_data_cb net_buf_fixed_cb;
+
+#define HDR_SIZE        sizeof(struct bt_sdp_hdr)
+#define HANDLE_BASE     0x10000
+/* Usable MTU of the channel unless a test changes it */
+#define DEFAULT_MTU     0x0100
+/* Continuation state size of Service Attribute Responses */
+#define SA_CONT_STATE_SIZE 5
+/* Service records registered by the tests to flush the response cache */
+#define FLUSH_RECS_MAX  16
+
+/*
+ * UUIDs of the records below. The index has room for 8 (UUID, record) pairs:
+ *  - rec_a and rec_b take 6 entries, every record lists the Public Browse
+ *    Group UUID as well
+ *  - rec_c has a 128-bit UUID that is not based on the Bluetooth Base UUID
+ *  - rec_d doesn't fit in the 2 entries left
+ *  - rec_e takes the last 2 entries, after rec_d has been taken out again
+ *  - rec_name finds the index full
+ */
+#define UUID_A          0x1101
+#define UUID_B16        0x110a
+#define UUID_B32        0x110b
+#define UUID_B128       0x110e
+#define UUID_D1         0x1112
+#define UUID_D2         0x1203
+#define UUID_E          0x1115
+#define UUID_NAME       0x1131
+#define UUID_NONE       0x1102
+
+#define UUID_128_BASE(_uuid) BT_UUID_128_ENCODE(_uuid, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB)
+#define UUID_128_C           BT_UUID_128_ENCODE(0x6E400001, 0xB5A3, 0xF393, 0xE0A9, 0xE50E24DCCA9E)
+
+enum {
+	REC_A,
+	REC_B,
+	REC_C,
+	REC_D,
+	REC_E,
+	REC_NAME,
+	REC_COUNT,
+};
+
+static struct bt_sdp_attribute rec_a_attrs[] = {
+	BT_SDP_NEW_SERVICE,
+	BT_SDP_LIST(
+		BT_SDP_ATTR_SVCLASS_ID_LIST,
+		BT_SDP_TYPE_SIZE_VAR(BT_SDP_SEQ8, 3),
+		BT_SDP_DATA_ELEM_LIST(
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID16),
+			BT_SDP_ARRAY_16(UUID_A)
+		},
+		)
+	),
+};
+
+static struct bt_sdp_attribute rec_b_attrs[] = {
+	BT_SDP_NEW_SERVICE,
+	BT_SDP_LIST(
+		BT_SDP_ATTR_SVCLASS_ID_LIST,
+		BT_SDP_TYPE_SIZE_VAR(BT_SDP_SEQ8, 25),
+		BT_SDP_DATA_ELEM_LIST(
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID16),
+			BT_SDP_ARRAY_16(UUID_B16)
+		},
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID32),
+			BT_SDP_ARRAY_32(UUID_B32)
+		},
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID128),
+			BT_SDP_ARRAY_8(UUID_128_BASE(UUID_B128))
+		},
+		)
+	),
+};
+
+static struct bt_sdp_attribute rec_c_attrs[] = {
+	BT_SDP_NEW_SERVICE,
+	BT_SDP_LIST(
+		BT_SDP_ATTR_SVCLASS_ID_LIST,
+		BT_SDP_TYPE_SIZE_VAR(BT_SDP_SEQ8, 17),
+		BT_SDP_DATA_ELEM_LIST(
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID128),
+			BT_SDP_ARRAY_8(UUID_128_C)
+		},
+		)
+	),
+};
+
+static struct bt_sdp_attribute rec_d_attrs[] = {
+	BT_SDP_NEW_SERVICE,
+	BT_SDP_LIST(
+		BT_SDP_ATTR_SVCLASS_ID_LIST,
+		BT_SDP_TYPE_SIZE_VAR(BT_SDP_SEQ8, 6),
+		BT_SDP_DATA_ELEM_LIST(
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID16),
+			BT_SDP_ARRAY_16(UUID_D1)
+		},
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID16),
+			BT_SDP_ARRAY_16(UUID_D2)
+		},
+		)
+	),
+};
+
+static struct bt_sdp_attribute rec_e_attrs[] = {
+	BT_SDP_NEW_SERVICE,
+	BT_SDP_LIST(
+		BT_SDP_ATTR_SVCLASS_ID_LIST,
+		BT_SDP_TYPE_SIZE_VAR(BT_SDP_SEQ8, 3),
+		BT_SDP_DATA_ELEM_LIST(
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID16),
+			BT_SDP_ARRAY_16(UUID_E)
+		},
+		)
+	),
+};
+
+/* Changed by the response cache tests to tell cached responses from new ones */
+static char svc_name[] = "Cached service name";
+static const char svc_name_orig[] = "Cached service name";
+
+static struct bt_sdp_attribute rec_name_attrs[] = {
+	BT_SDP_NEW_SERVICE,
+	BT_SDP_LIST(
+		BT_SDP_ATTR_SVCLASS_ID_LIST,
+		BT_SDP_TYPE_SIZE_VAR(BT_SDP_SEQ8, 3),
+		BT_SDP_DATA_ELEM_LIST(
+		{
+			BT_SDP_TYPE_SIZE(BT_SDP_UUID16),
+			BT_SDP_ARRAY_16(UUID_NAME)
+		},
+		)
+	),
+	{
+		BT_SDP_ATTR_SVCNAME_PRIMARY,
+		{ BT_SDP_TYPE_SIZE_VAR(BT_SDP_TEXT_STR8, sizeof(svc_name) - 1), svc_name }
+	},
+};
+
+static struct bt_sdp_record records[REC_COUNT] = {
+	[REC_A] = BT_SDP_RECORD(rec_a_attrs),
+	[REC_B] = BT_SDP_RECORD(rec_b_attrs),
+	[REC_C] = BT_SDP_RECORD(rec_c_attrs),
+	[REC_D] = BT_SDP_RECORD(rec_d_attrs),
+	[REC_E] = BT_SDP_RECORD(rec_e_attrs),
+	[REC_NAME] = BT_SDP_RECORD(rec_name_attrs),
+};
+
+/* Records without any UUID, only registered for their side effects */
+static uint32_t flush_handles[FLUSH_RECS_MAX];
+static struct bt_sdp_attribute flush_attrs[FLUSH_RECS_MAX][1];
+static struct bt_sdp_record flush_recs[FLUSH_RECS_MAX];
+static size_t flush_count;
+
+static struct bt_l2cap_server *sdp_server;
+static struct bt_l2cap_chan *sdp_chan;
+
+static uint8_t pdu_data[512];
+static struct net_buf pdu;
+
+/* Last response sent by the server, SDP header included */
+static uint8_t rsp[512];
+static uint16_t rsp_len;
+
+static uint16_t next_tid;
+
+static int server_register_custom_fake(struct bt_l2cap_server *server)
+{
+	sdp_server = server;
+
+	return 0;
+}
+
+static struct net_buf *create_pdu_custom_fake(struct net_buf_pool *pool, size_t reserve,
+					      k_timeout_t timeout)
+{
+	pdu.__buf = pdu_data;
+	pdu.size = sizeof(pdu_data);
+	net_buf_simple_reset(&pdu.b);
+	net_buf_reserve(&pdu, reserve);
+
+	return &pdu;
+}
+
+static int chan_send_custom_fake(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	if (buf->len > sizeof(rsp)) {
+		return -EMSGSIZE;
+	}
+
+	memcpy(rsp, buf->data, buf->len);
+	rsp_len = buf->len;
+
+	return 0;
+}
+
+static void fakes_init(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+
+	bt_l2cap_br_server_register_fake.custom_fake = server_register_custom_fake;
+	bt_l2cap_create_pdu_timeout_fake.custom_fake = create_pdu_custom_fake;
+	bt_l2cap_chan_send_fake.custom_fake = chan_send_custom_fake;
+}
+
+static void set_mtu(uint16_t mtu)
+{
+	CONTAINER_OF(sdp_chan, struct bt_l2cap_br_chan, chan)->tx.mtu = mtu;
+}
+
+static uint32_t rec_handle(size_t rec)
+{
+	return HANDLE_BASE + rec;
+}
+
+/* Send a request with a new transaction ID and check a response has been sent */
+static void send_req(uint8_t op, const uint8_t *param, uint16_t param_len)
+{
+	static uint8_t req_data[128];
+	struct net_buf req = {
+		.__buf = req_data,
+		.size = sizeof(req_data),
+	};
+	struct bt_sdp_hdr *hdr;
+	uint32_t sent = bt_l2cap_chan_send_fake.call_count;
+
+	zassert_true(param_len <= sizeof(req_data) - HDR_SIZE);
+
+	net_buf_simple_reset(&req.b);
+	hdr = net_buf_add(&req, sizeof(*hdr));
+	hdr->op_code = op;
+	next_tid++;
+	hdr->tid = sys_cpu_to_be16(next_tid);
+	hdr->param_len = sys_cpu_to_be16(param_len);
+	net_buf_add_mem(&req, param, param_len);
+
+	rsp_len = 0U;
+	zassert_ok(sdp_chan->ops->recv(sdp_chan, &req));
+
+	zassert_equal(bt_l2cap_chan_send_fake.call_count, sent + 1, "No response sent");
+	zassert_true(rsp_len >= HDR_SIZE);
+	zassert_equal(sys_get_be16(&rsp[1]), next_tid, "Wrong transaction ID");
+	zassert_equal(sys_get_be16(&rsp[3]), rsp_len - HDR_SIZE, "Wrong parameter length");
+}
+
+/* Service Search Request for a single UUID, given as a data element */
+static void ss_req(const uint8_t *uuid, uint8_t uuid_len)
+{
+	uint8_t param[32];
+	uint16_t len = 0U;
+
+	param[len++] = BT_SDP_SEQ8;
+	param[len++] = uuid_len;
+	memcpy(&param[len], uuid, uuid_len);
+	len += uuid_len;
+	sys_put_be16(REC_COUNT + FLUSH_RECS_MAX, &param[len]);
+	len += sizeof(uint16_t);
+	/* No continuation state */
+	param[len++] = 0U;
+
+	send_req(BT_SDP_SVC_SEARCH_REQ, param, len);
+}
+
+static void ss_req_uuid16(uint16_t uuid)
+{
+	uint8_t elem[3] = { BT_SDP_UUID16 };
+
+	sys_put_be16(uuid, &elem[1]);
+	ss_req(elem, sizeof(elem));
+}
+
+static void ss_req_uuid32(uint32_t uuid)
+{
+	uint8_t elem[5] = { BT_SDP_UUID32 };
+
+	sys_put_be32(uuid, &elem[1]);
+	ss_req(elem, sizeof(elem));
+}
+
+static void ss_req_uuid128(const uint8_t uuid[BT_UUID_SIZE_128])
+{
+	uint8_t elem[17] = { BT_SDP_UUID128 };
+
+	/* Requests carry 128-bit UUIDs in big-endian */
+	sys_memcpy_swap(&elem[1], uuid, BT_UUID_SIZE_128);
+	ss_req(elem, sizeof(elem));
+}
+
+/* Check the last Service Search Response lists the given records, in order */
+static void ss_rsp_check(const size_t *recs, uint16_t count)
+{
+	zassert_equal(rsp[0], BT_SDP_SVC_SEARCH_RSP, "Unexpected response 0x%02x", rsp[0]);
+	zassert_equal(sys_get_be16(&rsp[HDR_SIZE]), count, "Wrong total record count");
+	zassert_equal(sys_get_be16(&rsp[HDR_SIZE + 2]), count, "Wrong current record count");
+	zassert_equal(rsp_len, HDR_SIZE + 4 + count * sizeof(uint32_t) + 1);
+
+	for (uint16_t i = 0U; i < count; i++) {
+		zassert_equal(sys_get_be32(&rsp[HDR_SIZE + 4 + i * sizeof(uint32_t)]),
+			      rec_handle(recs[i]), "Wrong handle at %u", i);
+	}
+
+	/* No continuation state */
+	zassert_equal(rsp[rsp_len - 1], 0U);
+}
+
+/* Service Attribute Request for the service name of rec_name */
+static void sa_req(uint16_t max_att_len, const uint8_t *cont, uint8_t cont_len)
+{
+	uint8_t param[32];
+	uint16_t len = 0U;
+
+	sys_put_be32(rec_handle(REC_NAME), &param[len]);
+	len += sizeof(uint32_t);
+	sys_put_be16(max_att_len, &param[len]);
+	len += sizeof(uint16_t);
+	param[len++] = BT_SDP_SEQ8;
+	param[len++] = 3U;
+	param[len++] = BT_SDP_UINT16;
+	sys_put_be16(BT_SDP_ATTR_SVCNAME_PRIMARY, &param[len]);
+	len += sizeof(uint16_t);
+	param[len++] = cont_len;
+	memcpy(&param[len], cont, cont_len);
+	len += cont_len;
+
+	send_req(BT_SDP_SVC_ATTR_REQ, param, len);
+}
+
+/* Last response with the transaction ID cleared, to compare responses */
+struct rsp_copy {
+	uint8_t data[sizeof(rsp)];
+	uint16_t len;
+};
+
+static void rsp_save(struct rsp_copy *copy)
+{
+	memcpy(copy->data, rsp, rsp_len);
+	sys_put_be16(0U, &copy->data[1]);
+	copy->len = rsp_len;
+}
+
+static bool rsp_equal(const struct rsp_copy *copy)
+{
+	struct rsp_copy last;
+
+	rsp_save(&last);
+
+	return last.len == copy->len && !memcmp(last.data, copy->data, copy->len);
+}
+
+static void svc_name_change(void)
+{
+	memset(svc_name, 'x', sizeof(svc_name) - 1);
+}
+
+static void flush_rec_register(void)
+{
+	struct bt_sdp_attribute *attr;
+
+	zassert_true(flush_count < FLUSH_RECS_MAX, "Out of flush records");
+
+	attr = &flush_attrs[flush_count][0];
+	attr->id = BT_SDP_ATTR_RECORD_HANDLE;
+	attr->val.type = BT_SDP_UINT32;
+	attr->val.data_size = sizeof(uint32_t);
+	attr->val.total_size = sizeof(uint32_t) + 1;
+	attr->val.data = &flush_handles[flush_count];
+
+	flush_recs[flush_count].attrs = flush_attrs[flush_count];
+	flush_recs[flush_count].attr_count = 1U;
+
+	zassert_ok(bt_sdp_register_service(&flush_recs[flush_count]));
+	flush_count++;
+}
+
+static void *sdp_server_setup(void)
+{
+	static bool initialized;
+	int err;
+
+	if (initialized) {
+		return NULL;
+	}
+
+	fakes_init();
+
+	bt_sdp_init();
+	zassert_not_null(sdp_server, "SDP server not registered");
+
+	err = sdp_server->accept(NULL, sdp_server, &sdp_chan);
+	zassert_ok(err);
+	zassert_not_null(sdp_chan);
+
+	for (size_t i = 0; i < ARRAY_SIZE(records); i++) {
+		zassert_ok(bt_sdp_register_service(&records[i]));
+		zassert_equal(records[i].handle, rec_handle(i));
+	}
+
+	initialized = true;
+
+	return NULL;
+}
+
+static void sdp_server_before(void *f)
+{
+	fakes_init();
+
+	set_mtu(DEFAULT_MTU);
+	memcpy(svc_name, svc_name_orig, sizeof(svc_name));
+}
+
+ZTEST_SUITE(sdp_uuid_index, NULL, sdp_server_setup, sdp_server_before, NULL, NULL);
+
+/*
+ *  Search for UUIDs of the records that fit in the index.
+ *
+ *  Expected behaviour:
+ *   - A record is found whatever the size of its UUID in the record and in
+ *     the request, as long as the UUID is based on the Bluetooth Base UUID
+ */
+ZTEST(sdp_uuid_index, test_indexed_records)
+{
+	static const uint8_t uuid_a[] = { UUID_128_BASE(UUID_A) };
+	const size_t rec_a[] = { REC_A };
+	const size_t rec_b[] = { REC_B };
+	const size_t rec_e[] = { REC_E };
+
+	ss_req_uuid16(UUID_A);
+	ss_rsp_check(rec_a, ARRAY_SIZE(rec_a));
+
+	ss_req_uuid128(uuid_a);
+	ss_rsp_check(rec_a, ARRAY_SIZE(rec_a));
+
+	ss_req_uuid16(UUID_B16);
+	ss_rsp_check(rec_b, ARRAY_SIZE(rec_b));
+
+	ss_req_uuid32(UUID_B16);
+	ss_rsp_check(rec_b, ARRAY_SIZE(rec_b));
+
+	/* Stored as 32-bit UUID */
+	ss_req_uuid16(UUID_B32);
+	ss_rsp_check(rec_b, ARRAY_SIZE(rec_b));
+
+	/* Stored as 128-bit UUID */
+	ss_req_uuid16(UUID_B128);
+	ss_rsp_check(rec_b, ARRAY_SIZE(rec_b));
+
+	/* Indexed after the record before it was taken out of the index */
+	ss_req_uuid16(UUID_E);
+	ss_rsp_check(rec_e, ARRAY_SIZE(rec_e));
+
+	ss_req_uuid16(UUID_NONE);
+	ss_rsp_check(NULL, 0U);
+}
+
+/*
+ *  Search for UUIDs of the records that are not in the index.
+ *
+ *  Expected behaviour:
+ *   - A record with a 128-bit UUID not based on the Bluetooth Base UUID is
+ *     found, and only that record
+ *   - A record that overflowed the index is found by any of its UUIDs,
+ *     including those that did fit before the overflow
+ *   - A record registered once the index is full is found
+ */
+ZTEST(sdp_uuid_index, test_unindexed_records)
+{
+	static const uint8_t uuid_c[] = { UUID_128_C };
+	const size_t rec_c[] = { REC_C };
+	const size_t rec_d[] = { REC_D };
+	const size_t rec_name[] = { REC_NAME };
+
+	ss_req_uuid128(uuid_c);
+	ss_rsp_check(rec_c, ARRAY_SIZE(rec_c));
+
+	ss_req_uuid16(UUID_D1);
+	ss_rsp_check(rec_d, ARRAY_SIZE(rec_d));
+
+	ss_req_uuid16(UUID_D2);
+	ss_rsp_check(rec_d, ARRAY_SIZE(rec_d));
+
+	ss_req_uuid32(UUID_D2);
+	ss_rsp_check(rec_d, ARRAY_SIZE(rec_d));
+
+	ss_req_uuid16(UUID_NAME);
+	ss_rsp_check(rec_name, ARRAY_SIZE(rec_name));
+}
+
+/*
+ *  Search for a UUID that indexed and unindexed records have in common.
+ *
+ *  Expected behaviour:
+ *   - Every record is found, in registration order
+ */
+ZTEST(sdp_uuid_index, test_mixed_records)
+{
+	const size_t all[] = { REC_A, REC_B, REC_C, REC_D, REC_E, REC_NAME };
+
+	ss_req_uuid16(BT_SDP_PUBLIC_BROWSE_GROUP);
+	ss_rsp_check(all, ARRAY_SIZE(all));
+}
+
+static void sdp_rsp_cache_before(void *f)
+{
+	if (CONFIG_BT_SDP_RSP_CACHE_SIZE == 0) {
+		ztest_test_skip();
+	}
+
+	sdp_server_before(f);
+
+	/* Start every test with an empty cache */
+	flush_rec_register();
+}
+
+ZTEST_SUITE(sdp_rsp_cache, NULL, sdp_server_setup, sdp_rsp_cache_before, NULL, NULL);
+
+/*
+ *  Repeat a request once the record data has changed.
+ *
+ *  Expected behaviour:
+ *   - The cached response is sent, with the transaction ID of the new request
+ */
+ZTEST(sdp_rsp_cache, test_hit)
+{
+	struct rsp_copy first;
+
+	sa_req(0x0100, NULL, 0U);
+	zassert_equal(rsp[0], BT_SDP_SVC_ATTR_RSP);
+	rsp_save(&first);
+
+	svc_name_change();
+
+	sa_req(0x0100, NULL, 0U);
+	zassert_true(rsp_equal(&first), "Response not from the cache");
+}
+
+/*
+ *  Send requests that differ from a cached one only in their parameters.
+ *
+ *  Expected behaviour:
+ *   - A new response is built
+ */
+ZTEST(sdp_rsp_cache, test_miss)
+{
+	struct rsp_copy first;
+
+	sa_req(0x0100, NULL, 0U);
+	rsp_save(&first);
+
+	svc_name_change();
+
+	sa_req(0x0101, NULL, 0U);
+	zassert_equal(rsp[0], BT_SDP_SVC_ATTR_RSP);
+	zassert_false(rsp_equal(&first), "Response from the cache");
+}
+
+/*
+ *  Send the same request over channels with a different MTU.
+ *
+ *  Expected behaviour:
+ *   - Responses are cached per MTU
+ */
+ZTEST(sdp_rsp_cache, test_mtu)
+{
+	struct rsp_copy first;
+
+	set_mtu(100);
+	sa_req(0x0100, NULL, 0U);
+	rsp_save(&first);
+
+	svc_name_change();
+
+	set_mtu(150);
+	sa_req(0x0100, NULL, 0U);
+	zassert_false(rsp_equal(&first), "Response from the cache for another MTU");
+
+	set_mtu(100);
+	sa_req(0x0100, NULL, 0U);
+	zassert_true(rsp_equal(&first), "Response not from the cache");
+}
+
+/*
+ *  Read an attribute split over two responses, then read it again.
+ *
+ *  Expected behaviour:
+ *   - The continuation state is part of the cache key, each part of the
+ *     attribute is answered from its own cache entry
+ */
+ZTEST(sdp_rsp_cache, test_continuation_state)
+{
+	struct rsp_copy part1, part2;
+	uint8_t cont[SA_CONT_STATE_SIZE];
+	uint16_t att_list_len;
+	uint8_t cont_len;
+
+	/* Too small for the whole service name */
+	sa_req(0x0010, NULL, 0U);
+	zassert_equal(rsp[0], BT_SDP_SVC_ATTR_RSP);
+	rsp_save(&part1);
+
+	att_list_len = sys_get_be16(&rsp[HDR_SIZE]);
+	cont_len = rsp[HDR_SIZE + 2 + att_list_len];
+	zassert_equal(cont_len, sizeof(cont), "No continuation state");
+	memcpy(cont, &rsp[HDR_SIZE + 2 + att_list_len + 1], sizeof(cont));
+
+	sa_req(0x0010, cont, sizeof(cont));
+	zassert_equal(rsp[0], BT_SDP_SVC_ATTR_RSP);
+	zassert_false(rsp_equal(&part1), "First part sent again");
+	rsp_save(&part2);
+
+	svc_name_change();
+
+	sa_req(0x0010, NULL, 0U);
+	zassert_true(rsp_equal(&part1), "First part not from the cache");
+
+	sa_req(0x0010, cont, sizeof(cont));
+	zassert_true(rsp_equal(&part2), "Second part not from the cache");
+}
+
+/*
+ *  Fill the cache and send one more request.
+ *
+ *  Expected behaviour:
+ *   - The least recently used response is replaced, a cache hit counts as a
+ *     use
+ */
+ZTEST(sdp_rsp_cache, test_lru_replacement)
+{
+	struct rsp_copy rsps[CONFIG_BT_SDP_RSP_CACHE_SIZE];
+
+	if (CONFIG_BT_SDP_RSP_CACHE_SIZE < 2) {
+		ztest_test_skip();
+	}
+
+	for (uint16_t i = 0U; i < ARRAY_SIZE(rsps); i++) {
+		sa_req(0x0100 + i, NULL, 0U);
+		rsp_save(&rsps[i]);
+	}
+
+	svc_name_change();
+
+	/* Make the second response the least recently used one */
+	sa_req(0x0100, NULL, 0U);
+	zassert_true(rsp_equal(&rsps[0]));
+
+	sa_req(0x0200, NULL, 0U);
+
+	sa_req(0x0100, NULL, 0U);
+	zassert_true(rsp_equal(&rsps[0]), "Recently used response replaced");
+
+	sa_req(0x0101, NULL, 0U);
+	zassert_false(rsp_equal(&rsps[1]), "Least recently used response kept");
+}
+
+/*
+ *  Send a request that fails, then fill the rest of the cache.
+ *
+ *  Expected behaviour:
+ *   - The error response is not cached and doesn't take the place of another
+ *     response
+ */
+ZTEST(sdp_rsp_cache, test_error_not_cached)
+{
+	static const uint8_t bad_handle[] = {
+		0xff, 0xff, 0xff, 0xff, 0x01, 0x00,
+		BT_SDP_SEQ8, 3U, BT_SDP_UINT16, 0x01, 0x00,
+		0x00,
+	};
+	struct rsp_copy first, err;
+
+	if (CONFIG_BT_SDP_RSP_CACHE_SIZE < 2) {
+		ztest_test_skip();
+	}
+
+	sa_req(0x0100, NULL, 0U);
+	rsp_save(&first);
+
+	send_req(BT_SDP_SVC_ATTR_REQ, bad_handle, sizeof(bad_handle));
+	zassert_equal(rsp[0], BT_SDP_ERROR_RSP);
+	zassert_equal(sys_get_be16(&rsp[HDR_SIZE]), BT_SDP_INVALID_RECORD_HANDLE);
+	rsp_save(&err);
+
+	for (uint16_t i = 1U; i < CONFIG_BT_SDP_RSP_CACHE_SIZE; i++) {
+		sa_req(0x0100 + i, NULL, 0U);
+	}
+
+	svc_name_change();
+
+	sa_req(0x0100, NULL, 0U);
+	zassert_true(rsp_equal(&first), "Response replaced by an error response");
+
+	send_req(BT_SDP_SVC_ATTR_REQ, bad_handle, sizeof(bad_handle));
+	zassert_true(rsp_equal(&err));
+}
+
+/*
+ *  Register a service record after a response has been cached.
+ *
+ *  Expected behaviour:
+ *   - The cache is flushed and a new response is built
+ */
+ZTEST(sdp_rsp_cache, test_flush_on_register)
+{
+	struct rsp_copy first;
+
+	sa_req(0x0100, NULL, 0U);
+	rsp_save(&first);
+
+	svc_name_change();
+	flush_rec_register();
+
+	sa_req(0x0100, NULL, 0U);
+	zassert_false(rsp_equal(&first), "Response from the cache");
+}
@@ -0,0 +1,440 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <psa/crypto.h>
+
+#include "host/ecc.h"
+#include "host/hci_core.h"
+#include "host/long_wq.h"
+
+DEFINE_FFF_GLOBALS;
+
+#define POOL_SIZE CONFIG_BT_ECC_KEY_POOL_SIZE
+/* Number of pairings simulated by the key reuse test */
+#define PAIRINGS  (4 * POOL_SIZE)
+/* Work items run before giving up on an empty work queue */
+#define WORK_MAX  (4 * POOL_SIZE + 4)
+
+struct bt_dev bt_dev;
+
+FAKE_VALUE_FUNC(psa_status_t, psa_generate_key, const psa_key_attributes_t *,
+		mbedtls_svc_key_id_t *);
+FAKE_VALUE_FUNC(psa_status_t, psa_export_public_key, mbedtls_svc_key_id_t, uint8_t *, size_t,
+		size_t *);
+FAKE_VALUE_FUNC(psa_status_t, psa_export_key, mbedtls_svc_key_id_t, uint8_t *, size_t,
+		size_t *);
+FAKE_VALUE_FUNC(psa_status_t, psa_import_key, const psa_key_attributes_t *, const uint8_t *,
+		size_t, mbedtls_svc_key_id_t *);
+FAKE_VALUE_FUNC(psa_status_t, psa_raw_key_agreement, psa_algorithm_t, mbedtls_svc_key_id_t,
+		const uint8_t *, size_t, uint8_t *, size_t, size_t *);
+FAKE_VALUE_FUNC(psa_status_t, psa_destroy_key, mbedtls_svc_key_id_t);
+FAKE_VOID_FUNC(psa_reset_key_attributes, psa_key_attributes_t *);
+FAKE_VALUE_FUNC(int, k_work_submit, struct k_work *);
+FAKE_VALUE_FUNC(int, bt_long_wq_submit, struct k_work *);
+FAKE_VOID_FUNC(k_sched_lock);
+FAKE_VOID_FUNC(k_sched_unlock);
+FAKE_VOID_FUNC(pub_key_cb, const uint8_t *);
+FAKE_VOID_FUNC(dh_key_cb, const uint8_t *);
+
+#define FFF_FAKES_LIST(FAKE)                                                                       \
+	FAKE(psa_generate_key)                                                                     \
+	FAKE(psa_export_public_key)                                                                \
+	FAKE(psa_export_key)                                                                       \
+	FAKE(psa_import_key)                                                                       \
+	FAKE(psa_raw_key_agreement)                                                                \
+	FAKE(psa_destroy_key)                                                                      \
+	FAKE(psa_reset_key_attributes)                                                             \
+	FAKE(k_work_submit)                                                                        \
+	FAKE(bt_long_wq_submit)                                                                    \
+	FAKE(k_sched_lock)                                                                         \
+	FAKE(k_sched_unlock)                                                                       \
+	FAKE(pub_key_cb)                                                                           \
+	FAKE(dh_key_cb)
+
+/* Work queue stand-in, run by the tests with run_work() */
+static struct k_work *work_queue[8];
+static size_t work_queued;
+
+/* Every generated key pair gets the next key ID, which is encoded in both keys */
+static uint32_t last_key_id;
+/* Key ID of the private key imported by the last DH Key calculation */
+static uint32_t dh_key_id;
+
+static uint32_t device_key_id;
+static struct bt_pub_key_cb pub_key_gen_cb = {
+	.func = pub_key_cb,
+};
+static const uint8_t remote_pk[BT_PUB_KEY_LEN] = { 0x01 };
+
+static void work_queue_add(struct k_work *work)
+{
+	zassert_true(work_queued < ARRAY_SIZE(work_queue), "Work queue overflow");
+	work_queue[work_queued++] = work;
+}
+
+static int work_submit_custom_fake(struct k_work *work)
+{
+	for (size_t i = 0; i < work_queued; i++) {
+		if (work_queue[i] == work) {
+			return 0;
+		}
+	}
+
+	work_queue_add(work);
+
+	return 1;
+}
+
+static psa_status_t psa_generate_key_custom_fake(const psa_key_attributes_t *attr,
+						 mbedtls_svc_key_id_t *key)
+{
+	*key = ++last_key_id;
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t psa_generate_key_fail_fake(const psa_key_attributes_t *attr,
+					       mbedtls_svc_key_id_t *key)
+{
+	return PSA_ERROR_INSUFFICIENT_ENTROPY;
+}
+
+static psa_status_t psa_export_public_key_custom_fake(mbedtls_svc_key_id_t key, uint8_t *data,
+						      size_t data_size, size_t *data_length)
+{
+	if (data_size != BT_PUB_KEY_LEN + 1) {
+		return PSA_ERROR_BUFFER_TOO_SMALL;
+	}
+
+	memset(data, 0, data_size);
+	data[0] = 0x04;
+	sys_put_be32(key, &data[1]);
+	*data_length = data_size;
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t psa_export_key_custom_fake(mbedtls_svc_key_id_t key, uint8_t *data,
+					       size_t data_size, size_t *data_length)
+{
+	if (data_size != BT_PRIV_KEY_LEN) {
+		return PSA_ERROR_BUFFER_TOO_SMALL;
+	}
+
+	memset(data, 0xaa, data_size);
+	sys_put_be32(key, data);
+	*data_length = data_size;
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t psa_import_key_custom_fake(const psa_key_attributes_t *attr,
+					       const uint8_t *data, size_t data_length,
+					       mbedtls_svc_key_id_t *key)
+{
+	if (data_length != BT_PRIV_KEY_LEN) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	dh_key_id = sys_get_be32(data);
+	*key = UINT16_MAX;
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t psa_raw_key_agreement_custom_fake(psa_algorithm_t alg,
+						      mbedtls_svc_key_id_t private_key,
+						      const uint8_t *peer_key, size_t peer_key_length,
+						      uint8_t *output, size_t output_size,
+						      size_t *output_length)
+{
+	memset(output, 0x55, output_size);
+	*output_length = output_size;
+
+	return PSA_SUCCESS;
+}
+
+/* Key ID of a little-endian public key, see psa_export_public_key_custom_fake() */
+static uint32_t pub_key_id(const uint8_t *pub_key)
+{
+	return sys_get_le32(&pub_key[BT_PUB_KEY_COORD_LEN - sizeof(uint32_t)]);
+}
+
+static void fakes_init(void)
+{
+	FFF_FAKES_LIST(RESET_FAKE);
+
+	k_work_submit_fake.custom_fake = work_submit_custom_fake;
+	bt_long_wq_submit_fake.custom_fake = work_submit_custom_fake;
+	psa_generate_key_fake.custom_fake = psa_generate_key_custom_fake;
+	psa_export_public_key_fake.custom_fake = psa_export_public_key_custom_fake;
+	psa_export_key_fake.custom_fake = psa_export_key_custom_fake;
+	psa_import_key_fake.custom_fake = psa_import_key_custom_fake;
+	psa_raw_key_agreement_fake.custom_fake = psa_raw_key_agreement_custom_fake;
+}
+
+/* Run the oldest queued work item, return false if there is none */
+static bool run_work(void)
+{
+	struct k_work *work;
+
+	if (work_queued == 0U) {
+		return false;
+	}
+
+	work = work_queue[0];
+	work_queued--;
+	memmove(&work_queue[0], &work_queue[1], work_queued * sizeof(work_queue[0]));
+
+	work->handler(work);
+
+	return true;
+}
+
+static void run_all_work(void)
+{
+	for (int i = 0; i < WORK_MAX; i++) {
+		if (!run_work()) {
+			return;
+		}
+	}
+
+	zassert_unreachable("Work queue did not drain");
+}
+
+static void take_all(const uint8_t *pks[POOL_SIZE])
+{
+	for (size_t i = 0; i < POOL_SIZE; i++) {
+		pks[i] = bt_pub_key_pool_take();
+		zassert_not_null(pks[i], "Pool empty after %zu keys", i);
+	}
+}
+
+static void release_all(const uint8_t *pks[POOL_SIZE])
+{
+	for (size_t i = 0; i < POOL_SIZE; i++) {
+		bt_pub_key_pool_release(pks[i]);
+	}
+}
+
+static void device_key_gen(void)
+{
+	/* Device key pair first, which then starts filling the pool */
+	zassert_ok(bt_pub_key_gen(&pub_key_gen_cb));
+	zassert_true(run_work());
+	zassert_equal(pub_key_cb_fake.call_count, 1);
+	zassert_not_null(bt_pub_key_get());
+	device_key_id = pub_key_id(bt_pub_key_get());
+
+	run_all_work();
+}
+
+static void *key_pool_setup(void)
+{
+	fakes_init();
+	device_key_gen();
+
+	return NULL;
+}
+
+static void key_pool_before(void *f)
+{
+	fakes_init();
+}
+
+static void key_pool_after(void *f)
+{
+	/* Every test leaves the pool full for the next one */
+	run_all_work();
+	zassert_equal(work_queued, 0U);
+}
+
+ZTEST_SUITE(ecc_key_pool, NULL, key_pool_setup, key_pool_before, key_pool_after, NULL);
+
+/*
+ *  Taking every key pair empties the pool, and the pool refills once the key
+ *  pairs are released.
+ *
+ *  Expected behaviour:
+ *   - POOL_SIZE distinct key pairs are handed out, none of them the device key
+ *   - Taking another key pair returns NULL
+ *   - After release and refill, POOL_SIZE key pairs never handed out before are
+ *     available again
+ */
+ZTEST(ecc_key_pool, test_exhaustion_and_refill)
+{
+	const uint8_t *pks[POOL_SIZE];
+	uint32_t ids[POOL_SIZE];
+
+	take_all(pks);
+
+	for (size_t i = 0; i < POOL_SIZE; i++) {
+		ids[i] = pub_key_id(pks[i]);
+		zassert_not_equal(ids[i], device_key_id);
+
+		for (size_t j = 0; j < i; j++) {
+			zassert_not_equal(ids[i], ids[j], "Key pair %zu handed out twice", i);
+		}
+	}
+
+	zassert_is_null(bt_pub_key_pool_take(), "Key handed out from an empty pool");
+
+	release_all(pks);
+	run_all_work();
+
+	take_all(pks);
+
+	for (size_t i = 0; i < POOL_SIZE; i++) {
+		for (size_t j = 0; j < POOL_SIZE; j++) {
+			zassert_not_equal(pub_key_id(pks[i]), ids[j], "Released key pair reused");
+		}
+	}
+
+	release_all(pks);
+
+	/* The device key pair is not affected by the pool */
+	zassert_equal(pub_key_id(bt_pub_key_get()), device_key_id);
+}
+
+/*
+ *  The pool is refilled in the background, one key pair per work item.
+ *
+ *  Expected behaviour:
+ *   - Each work item generates a single key pair
+ *   - Each released slot is refilled
+ */
+ZTEST(ecc_key_pool, test_refill_one_key_per_work_item)
+{
+	const uint8_t *pks[POOL_SIZE];
+
+	take_all(pks);
+	release_all(pks);
+
+	for (size_t i = 0; i < POOL_SIZE; i++) {
+		zassert_true(run_work(), "Refill stopped after %zu key pairs", i);
+		zassert_equal(psa_generate_key_fake.call_count, i + 1);
+	}
+
+	/* The last run finds the pool full */
+	while (run_work()) {
+	}
+
+	zassert_equal(psa_generate_key_fake.call_count, POOL_SIZE);
+}
+
+/*
+ *  A failed refill leaves the pool empty until the next take.
+ *
+ *  Expected behaviour:
+ *   - Taking from the empty pool returns NULL and queues a refill
+ *   - The refill succeeds once key generation works again
+ */
+ZTEST(ecc_key_pool, test_refill_after_failure)
+{
+	const uint8_t *pks[POOL_SIZE];
+	const uint8_t *pk;
+
+	take_all(pks);
+
+	psa_generate_key_fake.custom_fake = psa_generate_key_fail_fake;
+	release_all(pks);
+	run_all_work();
+
+	zassert_is_null(bt_pub_key_pool_take());
+	zassert_true(work_queued > 0U, "No refill queued for an empty pool");
+
+	psa_generate_key_fake.custom_fake = psa_generate_key_custom_fake;
+	run_all_work();
+
+	pk = bt_pub_key_pool_take();
+	zassert_not_null(pk);
+	bt_pub_key_pool_release(pk);
+}
+
+/*
+ *  Simulate back-to-back pairings the way SMP uses the pool: take a key pair,
+ *  calculate the DH Key with it and release it when the pairing ends.
+ *
+ *  Expected behaviour:
+ *   - Each pairing gets a key pair no other pairing had
+ *   - The DH Key calculation uses the private key of that key pair
+ *   - A released key pair can't be used for a DH Key calculation anymore
+ */
+ZTEST(ecc_key_pool, test_no_key_reuse_across_pairings)
+{
+	uint32_t ids[PAIRINGS];
+
+	for (size_t i = 0; i < PAIRINGS; i++) {
+		const uint8_t *pk = bt_pub_key_pool_take();
+
+		zassert_not_null(pk, "Pool empty at pairing %zu", i);
+
+		ids[i] = pub_key_id(pk);
+		zassert_not_equal(ids[i], device_key_id);
+		for (size_t j = 0; j < i; j++) {
+			zassert_not_equal(ids[i], ids[j], "Pairings %zu and %zu share a key", j, i);
+		}
+
+		zassert_ok(bt_dh_key_gen(pk, remote_pk, dh_key_cb));
+		run_all_work();
+		zassert_equal(dh_key_cb_fake.call_count, i + 1);
+		zassert_not_null(dh_key_cb_fake.arg0_val);
+		zassert_equal(dh_key_id, ids[i], "DH Key not calculated with the pool key");
+
+		bt_pub_key_pool_release(pk);
+		zassert_equal(bt_dh_key_gen(pk, remote_pk, dh_key_cb), -EADDRNOTAVAIL);
+
+		run_all_work();
+	}
+}
+
+/*
+ *  Releasing a key pair while its DH Key calculation is queued must not change
+ *  the private key used by the calculation.
+ *
+ *  Expected behaviour:
+ *   - The DH Key is calculated with the private key of the released key pair
+ */
+ZTEST(ecc_key_pool, test_release_during_dh_key_calculation)
+{
+	const uint8_t *pk = bt_pub_key_pool_take();
+	uint32_t id;
+
+	zassert_not_null(pk);
+	id = pub_key_id(pk);
+
+	zassert_ok(bt_dh_key_gen(pk, remote_pk, dh_key_cb));
+	bt_pub_key_pool_release(pk);
+	run_all_work();
+
+	zassert_equal(dh_key_cb_fake.call_count, 1);
+	zassert_equal(dh_key_id, id);
+}
+
+/*
+ *  Keys not taken from the pool keep using the device key pair.
+ *
+ *  Expected behaviour:
+ *   - Releasing the device public key is ignored
+ *   - The DH Key is calculated with the device private key
+ */
+ZTEST(ecc_key_pool, test_device_key)
+{
+	const uint8_t *pk = bt_pub_key_get();
+
+	bt_pub_key_pool_release(pk);
+	zassert_equal(work_queued, 0U);
+
+	zassert_ok(bt_dh_key_gen(pk, remote_pk, dh_key_cb));
+	run_all_work();
+
+	zassert_equal(dh_key_cb_fake.call_count, 1);
+	zassert_equal(dh_key_id, device_key_id);
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "att_internal.h"
+
+DEFINE_FAKE_VOID_FUNC(bt_att_clear_out_of_sync_sent, struct bt_conn *);
+DEFINE_FAKE_VALUE_FUNC(struct net_buf *, bt_att_create_pdu, struct bt_conn *, uint8_t, size_t);
+DEFINE_FAKE_VALUE_FUNC(bool, bt_att_fixed_chan_only, struct bt_conn *);
+DEFINE_FAKE_VALUE_FUNC(uint16_t, bt_att_get_mtu, struct bt_conn *);
+DEFINE_FAKE_VALUE_FUNC(uint16_t, bt_att_get_uatt_mtu, struct bt_conn *);
+DEFINE_FAKE_VALUE_FUNC(bool, bt_att_out_of_sync_sent_on_fixed, struct bt_conn *);
+DEFINE_FAKE_VALUE_FUNC(struct bt_att_req *, bt_att_req_alloc, k_timeout_t);
+DEFINE_FAKE_VOID_FUNC(bt_att_req_free, struct bt_att_req *);
+DEFINE_FAKE_VALUE_FUNC(int, bt_att_req_send, struct bt_conn *, struct bt_att_req *);
+DEFINE_FAKE_VALUE_FUNC(int, bt_att_send, struct bt_conn *, struct net_buf *);
+DEFINE_FAKE_VOID_FUNC(bt_att_set_tx_meta_data, struct net_buf *, bt_gatt_complete_func_t, void *,
+		      enum bt_att_chan_opt);
@@ -0,0 +1,37 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+
+#include <host/att_internal.h>
+
+/* List of fakes used by this unit tester */
+#define ATT_INTERNAL_MOCKS_FFF_FAKES_LIST(FAKE)                                                    \
+	FAKE(bt_att_clear_out_of_sync_sent)                                                        \
+	FAKE(bt_att_create_pdu)                                                                    \
+	FAKE(bt_att_fixed_chan_only)                                                               \
+	FAKE(bt_att_get_mtu)                                                                       \
+	FAKE(bt_att_get_uatt_mtu)                                                                  \
+	FAKE(bt_att_out_of_sync_sent_on_fixed)                                                     \
+	FAKE(bt_att_req_alloc)                                                                     \
+	FAKE(bt_att_req_free)                                                                      \
+	FAKE(bt_att_req_send)                                                                      \
+	FAKE(bt_att_send)                                                                          \
+	FAKE(bt_att_set_tx_meta_data)
+
+DECLARE_FAKE_VOID_FUNC(bt_att_clear_out_of_sync_sent, struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(struct net_buf *, bt_att_create_pdu, struct bt_conn *, uint8_t, size_t);
+DECLARE_FAKE_VALUE_FUNC(bool, bt_att_fixed_chan_only, struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(uint16_t, bt_att_get_mtu, struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(uint16_t, bt_att_get_uatt_mtu, struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(bool, bt_att_out_of_sync_sent_on_fixed, struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(struct bt_att_req *, bt_att_req_alloc, k_timeout_t);
+DECLARE_FAKE_VOID_FUNC(bt_att_req_free, struct bt_att_req *);
+DECLARE_FAKE_VALUE_FUNC(int, bt_att_req_send, struct bt_conn *, struct bt_att_req *);
+DECLARE_FAKE_VALUE_FUNC(int, bt_att_send, struct bt_conn *, struct net_buf *);
+DECLARE_FAKE_VOID_FUNC(bt_att_set_tx_meta_data, struct net_buf *, bt_gatt_complete_func_t, void *,
+		       enum bt_att_chan_opt);
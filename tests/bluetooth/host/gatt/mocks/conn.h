@@ -0,0 +1,35 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+#include <zephyr/bluetooth/conn.h>
+
+#include <host/conn_internal.h>
+
+/* List of fakes used by this unit tester */
+#define CONN_MOCKS_FFF_FAKES_LIST(FAKE)                                                            \
+	FAKE(bt_conn_auth_info_cb_register)                                                        \
+	FAKE(bt_conn_get_security)                                                                 \
+	FAKE(bt_conn_index)                                                                        \
+	FAKE(bt_conn_is_peer_addr_le)                                                              \
+	FAKE(bt_conn_lookup_addr_le)                                                               \
+	FAKE(bt_conn_lookup_state_le)                                                              \
+	FAKE(bt_conn_ltk_present)                                                                  \
+	FAKE(bt_conn_set_security)                                                                 \
+	FAKE(bt_conn_unref)
+
+DECLARE_FAKE_VALUE_FUNC(int, bt_conn_auth_info_cb_register, struct bt_conn_auth_info_cb *);
+DECLARE_FAKE_VALUE_FUNC(bt_security_t, bt_conn_get_security, const struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(uint8_t, bt_conn_index, const struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(bool, bt_conn_is_peer_addr_le, const struct bt_conn *, uint8_t,
+			const bt_addr_le_t *);
+DECLARE_FAKE_VALUE_FUNC(struct bt_conn *, bt_conn_lookup_addr_le, uint8_t, const bt_addr_le_t *);
+DECLARE_FAKE_VALUE_FUNC(struct bt_conn *, bt_conn_lookup_state_le, uint8_t, const bt_addr_le_t *,
+			const bt_conn_state_t);
+DECLARE_FAKE_VALUE_FUNC(bool, bt_conn_ltk_present, const struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(int, bt_conn_set_security, struct bt_conn *, bt_security_t);
+DECLARE_FAKE_VOID_FUNC(bt_conn_unref, struct bt_conn *);
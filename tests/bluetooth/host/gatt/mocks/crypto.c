@@ -0,0 +1,19 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "crypto.h"
+
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_import_key, const psa_key_attributes_t *,
+		       const uint8_t *, size_t, mbedtls_svc_key_id_t *);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_destroy_key, mbedtls_svc_key_id_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_setup, psa_mac_operation_t *,
+		       mbedtls_svc_key_id_t, psa_algorithm_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_update, psa_mac_operation_t *, const uint8_t *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_finish, psa_mac_operation_t *, uint8_t *,
+		       size_t, size_t *);
@@ -0,0 +1,27 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+#include <psa/crypto.h>
+
+/* List of fakes used by this unit tester */
+#define CRYPTO_MOCKS_FFF_FAKES_LIST(FAKE)                                                          \
+	FAKE(psa_import_key)                                                                       \
+	FAKE(psa_destroy_key)                                                                      \
+	FAKE(psa_mac_sign_setup)                                                                   \
+	FAKE(psa_mac_update)                                                                       \
+	FAKE(psa_mac_sign_finish)
+
+DECLARE_FAKE_VALUE_FUNC(psa_status_t, psa_import_key, const psa_key_attributes_t *,
+			const uint8_t *, size_t, mbedtls_svc_key_id_t *);
+DECLARE_FAKE_VALUE_FUNC(psa_status_t, psa_destroy_key, mbedtls_svc_key_id_t);
+DECLARE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_setup, psa_mac_operation_t *,
+			mbedtls_svc_key_id_t, psa_algorithm_t);
+DECLARE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_update, psa_mac_operation_t *, const uint8_t *,
+			size_t);
+DECLARE_FAKE_VALUE_FUNC(psa_status_t, psa_mac_sign_finish, psa_mac_operation_t *, uint8_t *,
+			size_t, size_t *);
@@ -0,0 +1,17 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/hci.h>
+
+#include <host/hci_core.h>
+
+#include "hci_core.h"
+
+DEFINE_FAKE_VALUE_FUNC(uint16_t, bt_get_appearance);
+DEFINE_FAKE_VALUE_FUNC(const char *, bt_get_name);
+
+struct bt_dev bt_dev;
@@ -0,0 +1,16 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+
+/* List of fakes used by this unit tester */
+#define HCI_CORE_MOCKS_FFF_FAKES_LIST(FAKE)                                                        \
+	FAKE(bt_get_appearance)                                                                    \
+	FAKE(bt_get_name)
+
+DECLARE_FAKE_VALUE_FUNC(uint16_t, bt_get_appearance);
+DECLARE_FAKE_VALUE_FUNC(const char *, bt_get_name);
@@ -0,0 +1,23 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+
+/* List of fakes used by this unit tester */
+#define KERNEL_MOCKS_FFF_FAKES_LIST(FAKE)                                                          \
+	FAKE(k_work_init_delayable)                                                                \
+	FAKE(k_work_cancel_delayable)                                                              \
+	FAKE(k_work_cancel_delayable_sync)                                                         \
+	FAKE(k_work_reschedule)                                                                    \
+	FAKE(k_work_schedule)
+
+DECLARE_FAKE_VOID_FUNC(k_work_init_delayable, struct k_work_delayable *, k_work_handler_t);
+DECLARE_FAKE_VALUE_FUNC(int, k_work_cancel_delayable, struct k_work_delayable *);
+DECLARE_FAKE_VALUE_FUNC(bool, k_work_cancel_delayable_sync, struct k_work_delayable *,
+			struct k_work_sync *);
+DECLARE_FAKE_VALUE_FUNC(int, k_work_reschedule, struct k_work_delayable *, k_timeout_t);
+DECLARE_FAKE_VALUE_FUNC(int, k_work_schedule, struct k_work_delayable *, k_timeout_t);
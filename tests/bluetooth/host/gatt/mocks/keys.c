@@ -0,0 +1,11 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "keys.h"
+
+DEFINE_FAKE_VALUE_FUNC(bool, bt_le_bond_exists, uint8_t, const bt_addr_le_t *);
@@ -0,0 +1,14 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+#include <zephyr/bluetooth/addr.h>
+
+/* List of fakes used by this unit tester */
+#define KEYS_MOCKS_FFF_FAKES_LIST(FAKE) FAKE(bt_le_bond_exists)
+
+DECLARE_FAKE_VALUE_FUNC(bool, bt_le_bond_exists, uint8_t, const bt_addr_le_t *);
@@ -0,0 +1,23 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "settings.h"
+
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_decode_key, const char *, bt_addr_le_t *);
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_store_sc, uint8_t, const bt_addr_le_t *, const void *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_delete_sc, uint8_t, const bt_addr_le_t *);
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_store_cf, uint8_t, const bt_addr_le_t *, const void *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_delete_cf, uint8_t, const bt_addr_le_t *);
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_store_ccc, uint8_t, const bt_addr_le_t *, const void *,
+		       size_t);
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_delete_ccc, uint8_t, const bt_addr_le_t *);
+DEFINE_FAKE_VALUE_FUNC(int, bt_settings_store_hash, const void *, size_t);
+DEFINE_FAKE_VALUE_FUNC(int, settings_name_next, const char *, const char **);
+DEFINE_FAKE_VALUE_FUNC(int, settings_name_steq, const char *, const char *, const char **);
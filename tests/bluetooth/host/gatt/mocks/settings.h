@@ -0,0 +1,38 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/fff.h>
+#include <zephyr/bluetooth/addr.h>
+
+#include <host/settings.h>
+
+/* List of fakes used by this unit tester */
+#define SETTINGS_MOCKS_FFF_FAKES_LIST(FAKE)                                                        \
+	FAKE(bt_settings_decode_key)                                                               \
+	FAKE(bt_settings_store_sc)                                                                 \
+	FAKE(bt_settings_delete_sc)                                                                \
+	FAKE(bt_settings_store_cf)                                                                 \
+	FAKE(bt_settings_delete_cf)                                                                \
+	FAKE(bt_settings_store_ccc)                                                                \
+	FAKE(bt_settings_delete_ccc)                                                               \
+	FAKE(bt_settings_store_hash)                                                               \
+	FAKE(settings_name_next)                                                                   \
+	FAKE(settings_name_steq)
+
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_decode_key, const char *, bt_addr_le_t *);
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_store_sc, uint8_t, const bt_addr_le_t *, const void *,
+			size_t);
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_delete_sc, uint8_t, const bt_addr_le_t *);
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_store_cf, uint8_t, const bt_addr_le_t *, const void *,
+			size_t);
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_delete_cf, uint8_t, const bt_addr_le_t *);
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_store_ccc, uint8_t, const bt_addr_le_t *, const void *,
+			size_t);
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_delete_ccc, uint8_t, const bt_addr_le_t *);
+DECLARE_FAKE_VALUE_FUNC(int, bt_settings_store_hash, const void *, size_t);
+DECLARE_FAKE_VALUE_FUNC(int, settings_name_next, const char *, const char **);
+DECLARE_FAKE_VALUE_FUNC(int, settings_name_steq, const char *, const char *, const char **);
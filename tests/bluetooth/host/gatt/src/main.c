@@ -0,0 +1,147 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+
+#include <host/gatt_internal.h>
+
+#include "mocks/att_internal.h"
+#include "mocks/conn.h"
+#include "mocks/crypto.h"
+#include "mocks/hci_core.h"
+#include "mocks/kernel.h"
+#include "mocks/keys.h"
+#include "mocks/settings.h"
+
+DEFINE_FFF_GLOBALS;
+
+/* Number of peers the delayed store can track at once */
+#define DELAYED_STORE_PEERS (CONFIG_BT_MAX_PAIRED + CONFIG_BT_MAX_CONN)
+
+static void k_work_init_delayable_custom_fake(struct k_work_delayable *dwork,
+					      k_work_handler_t handler)
+{
+	dwork->work.handler = handler;
+}
+
+static bool bt_le_bond_exists_custom_fake(uint8_t id, const bt_addr_le_t *addr)
+{
+	/* Free delayed store slots hold the "any" address */
+	return !bt_addr_le_eq(addr, BT_ADDR_LE_ANY);
+}
+
+static void fff_reset_rule_before(const struct ztest_unit_test *test, void *fixture)
+{
+	ATT_INTERNAL_MOCKS_FFF_FAKES_LIST(RESET_FAKE);
+	CONN_MOCKS_FFF_FAKES_LIST(RESET_FAKE);
+	CRYPTO_MOCKS_FFF_FAKES_LIST(RESET_FAKE);
+	HCI_CORE_MOCKS_FFF_FAKES_LIST(RESET_FAKE);
+	KERNEL_MOCKS_FFF_FAKES_LIST(RESET_FAKE);
+	KEYS_MOCKS_FFF_FAKES_LIST(RESET_FAKE);
+	SETTINGS_MOCKS_FFF_FAKES_LIST(RESET_FAKE);
+
+	bt_le_bond_exists_fake.custom_fake = bt_le_bond_exists_custom_fake;
+}
+
+ZTEST_RULE(fff_reset_rule, fff_reset_rule_before, NULL);
+
+static void *gatt_setup(void)
+{
+	k_work_init_delayable_fake.custom_fake = k_work_init_delayable_custom_fake;
+
+	bt_gatt_init();
+
+	return NULL;
+}
+
+ZTEST_SUITE(gatt_deferred_disconnect_store, NULL, gatt_setup, NULL, NULL, NULL);
+
+static void bonded_peer_disconnect(uint8_t n)
+{
+	struct bt_conn conn = {
+		.id = BT_ID_DEFAULT,
+		.le.dst = {
+			.type = BT_ADDR_LE_RANDOM,
+			.a.val = {n, 0x01, 0x02, 0x03, 0x04, 0xc5},
+		},
+	};
+
+	bt_gatt_disconnected(&conn);
+}
+
+/* Run the delayed store work if the disconnection has scheduled it */
+static void delayed_store_run(void)
+{
+	struct k_work_delayable *dwork;
+
+	if (k_work_reschedule_fake.call_count == 0) {
+		return;
+	}
+
+	dwork = k_work_reschedule_fake.arg0_history[k_work_reschedule_fake.call_count - 1];
+	zassert_not_null(dwork->work.handler, "Delayed store work not initialized");
+
+	dwork->work.handler(&dwork->work);
+}
+
+/*
+ * Test that a bonded peer disconnection stores the values that are not stored
+ * on write once, from the delayed store work.
+ *
+ * Expected behaviour:
+ *  - Nothing is stored from bt_gatt_disconnected()
+ *  - The CCC values are stored by the delayed store work only if they are not
+ *    stored on write
+ *  - Running the delayed store work again doesn't store anything, i.e. the
+ *    peer has been removed from the delayed store
+ */
+ZTEST(gatt_deferred_disconnect_store, test_disconnected_peer_stored_once)
+{
+	uint32_t ccc_stores = IS_ENABLED(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE) ? 0 : 1;
+
+	bonded_peer_disconnect(0x01);
+
+	zassert_equal(bt_settings_store_ccc_fake.call_count, 0, "CCC stored on disconnection");
+	zassert_equal(bt_settings_store_cf_fake.call_count, 0, "CF stored on disconnection");
+
+	delayed_store_run();
+
+	zassert_equal(bt_settings_store_ccc_fake.call_count, ccc_stores,
+		      "Unexpected CCC stores %u", bt_settings_store_ccc_fake.call_count);
+
+	RESET_FAKE(bt_settings_store_ccc);
+	RESET_FAKE(bt_settings_store_cf);
+
+	delayed_store_run();
+
+	zassert_equal(bt_settings_store_ccc_fake.call_count, 0, "CCC stored again");
+	zassert_equal(bt_settings_store_cf_fake.call_count, 0, "CF stored again");
+}
+
+/*
+ * Test that more bonded peers than the delayed store can hold may disconnect
+ * one after the other.
+ *
+ * Expected behaviour:
+ *  - Every delayed store work run frees the slot of the peer it has stored,
+ *    so no assertion is hit while queuing the next peer
+ */
+ZTEST(gatt_deferred_disconnect_store, test_disconnected_peers_free_slots)
+{
+	for (uint8_t i = 0; i < 2 * DELAYED_STORE_PEERS; i++) {
+		bonded_peer_disconnect(0x10 + i);
+		delayed_store_run();
+	}
+
+	if (!IS_ENABLED(CONFIG_BT_SETTINGS_CCC_STORE_ON_WRITE)) {
+		zassert_equal(bt_settings_store_ccc_fake.call_count, 2 * DELAYED_STORE_PEERS,
+			      "Unexpected CCC stores %u", bt_settings_store_ccc_fake.call_count);
+	}
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "mocks/kernel.h"
+#include "mocks/keys_help_utils.h"
+#include "mocks/rpa.h"
+#include "testing_common_defs.h"
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/kernel.h>
+
+#include <host/keys.h>
+
+#if CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0
+static struct bt_keys *irk_keys;
+
+static void rpa_cache_ts_setup(void *f)
+{
+	clear_key_pool();
+
+	irk_keys = bt_keys_get_type(BT_KEYS_IRK, BT_ADDR_ID_1, BT_ADDR_LE_1);
+	zassert_not_null(irk_keys, "Failed to add IRK to the keys pool");
+
+	RPA_FFF_FAKES_LIST(RESET_FAKE);
+	KERNEL_FFF_FAKES_LIST(RESET_FAKE);
+	bt_rpa_irk_matches_batch_err = 0;
+}
+
+ZTEST_SUITE(bt_keys_find_irk_rpa_cache, NULL, NULL, rpa_cache_ts_setup, NULL, NULL);
+
+/*
+ *  Resolve the same non-matching RPA twice
+ *
+ *  Constraints:
+ *   - One IRK in the keys pool
+ *   - IRK value and device address don't match
+ *
+ *  Expected behaviour:
+ *   - A NULL value is returned both times
+ *   - bt_rpa_irk_matches() is only called for the first lookup
+ */
+ZTEST(bt_keys_find_irk_rpa_cache, test_unresolvable_rpa_is_cached)
+{
+	bt_rpa_irk_matches_fake.return_val = false;
+
+	zassert_is_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 1);
+
+	zassert_is_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 1,
+		      "bt_rpa_irk_matches() called for a cached RPA");
+}
+
+/*
+ *  Resolve the same matching RPA twice, while the per-key RPA is reset in between
+ *
+ *  Constraints:
+ *   - One IRK in the keys pool
+ *   - IRK value and device address match
+ *
+ *  Expected behaviour:
+ *   - The IRK key reference is returned both times
+ *   - bt_rpa_irk_matches() is only called for the first lookup
+ */
+ZTEST(bt_keys_find_irk_rpa_cache, test_resolved_rpa_is_cached)
+{
+	bt_rpa_irk_matches_fake.return_val = true;
+
+	zassert_equal_ptr(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1), irk_keys);
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 1);
+
+	bt_addr_copy(&irk_keys->irk.rpa, BT_ADDR_ANY);
+
+	zassert_equal_ptr(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1), irk_keys);
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 1,
+		      "bt_rpa_irk_matches() called for a cached RPA");
+	zassert_mem_equal(&irk_keys->irk.rpa, &BT_RPA_ADDR_LE_1->a, sizeof(bt_addr_t),
+			  "Incorrect address was stored by 'bt_keys_find_irk()'");
+}
+
+/*
+ *  Resolve a non-matching RPA, then add a new IRK and resolve it again
+ *
+ *  Constraints:
+ *   - IRK value and device address match only for the newly added IRK
+ *
+ *  Expected behaviour:
+ *   - The cached result is dropped and the new IRK key reference is returned
+ */
+ZTEST(bt_keys_find_irk_rpa_cache, test_new_irk_invalidates_cache)
+{
+	struct bt_keys *new_keys;
+
+	bt_rpa_irk_matches_fake.return_val = false;
+
+	zassert_is_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+
+	new_keys = bt_keys_get_type(BT_KEYS_IRK, BT_ADDR_ID_1, BT_ADDR_LE_2);
+	zassert_not_null(new_keys, "Failed to add IRK to the keys pool");
+
+	bt_rpa_irk_matches_fake.return_val = true;
+
+	zassert_not_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+}
+
+/*
+ *  Resolve the same non-matching RPA twice, with the cache timeout elapsing in between
+ *
+ *  Constraints:
+ *   - One IRK in the keys pool
+ *   - IRK value and device address don't match
+ *
+ *  Expected behaviour:
+ *   - bt_rpa_irk_matches() is called for both lookups
+ */
+ZTEST(bt_keys_find_irk_rpa_cache, test_cached_rpa_expires)
+{
+	bt_rpa_irk_matches_fake.return_val = false;
+
+	zassert_is_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+
+	k_uptime_ticks_fake.return_val =
+		(int64_t)CONFIG_BT_KEYS_RPA_CACHE_TIMEOUT * CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+
+	zassert_is_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 2,
+		      "bt_rpa_irk_matches() not called for an expired RPA");
+}
+
+/*
+ *  Resolve the same non-matching RPA twice, with the batched resolution failing
+ *
+ *  Constraints:
+ *   - One IRK in the keys pool
+ *   - bt_rpa_irk_matches_batch() returns an encryption error
+ *   - IRK value and device address don't match
+ *
+ *  Expected behaviour:
+ *   - A NULL value is returned both times
+ *   - bt_rpa_irk_matches() is called for both lookups, as the failure isn't cached
+ */
+ZTEST(bt_keys_find_irk_rpa_cache, test_crypto_error_is_not_cached)
+{
+	bt_rpa_irk_matches_batch_err = -EIO;
+	bt_rpa_irk_matches_fake.return_val = false;
+
+	zassert_is_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 1);
+
+	zassert_is_null(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1));
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 2,
+		      "Failed resolution was cached");
+}
+
+/*
+ *  Resolve a matching RPA with the batched resolution failing
+ *
+ *  Constraints:
+ *   - Two IRKs in the keys pool
+ *   - bt_rpa_irk_matches_batch() returns an encryption error
+ *   - IRK value and device address match for the second IRK only
+ *
+ *  Expected behaviour:
+ *   - The second IRK key reference is returned, found by checking the IRKs one at a time
+ */
+ZTEST(bt_keys_find_irk_rpa_cache, test_crypto_error_falls_back)
+{
+	struct bt_keys *new_keys;
+	bool matches[] = { false, true };
+
+	new_keys = bt_keys_get_type(BT_KEYS_IRK, BT_ADDR_ID_1, BT_ADDR_LE_2);
+	zassert_not_null(new_keys, "Failed to add IRK to the keys pool");
+
+	bt_rpa_irk_matches_batch_err = -EINVAL;
+	SET_RETURN_SEQ(bt_rpa_irk_matches, matches, ARRAY_SIZE(matches));
+
+	zassert_equal_ptr(bt_keys_find_irk(BT_ADDR_ID_1, BT_RPA_ADDR_LE_1), new_keys);
+	zassert_equal(bt_rpa_irk_matches_fake.call_count, 2);
+	zassert_mem_equal(&new_keys->irk.rpa, &BT_RPA_ADDR_LE_1->a, sizeof(bt_addr_t),
+			  "Incorrect address was stored by 'bt_keys_find_irk()'");
+}
+#endif /* CONFIG_BT_KEYS_RPA_CACHE_SIZE > 0 */
@@ -11,10 +11,8 @@
 
 void clear_key_pool(void)
 {
-	struct bt_keys *key_pool;
-
-	key_pool = bt_keys_get_key_pool();
-	memset(key_pool, 0x00, sizeof(struct bt_keys) * CONFIG_BT_MAX_PAIRED);
+	/* Also drops the address index and the RPA resolution cache */
+	bt_keys_reset();
 }
 
 int fill_key_pool_by_id_addr(const struct id_addr_pair src[], int size, struct bt_keys *refs[])
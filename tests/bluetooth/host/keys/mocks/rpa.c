@@ -4,7 +4,29 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
+
 #include <zephyr/kernel.h>
 #include "mocks/rpa.h"
 
 DEFINE_FAKE_VALUE_FUNC(bool, bt_rpa_irk_matches, const uint8_t *, const bt_addr_t *);
+
+int bt_rpa_irk_matches_batch_err;
+
+/* Resolve through the bt_rpa_irk_matches() fake, one IRK at a time, unless
+ * an encryption error is set in bt_rpa_irk_matches_batch_err.
+ */
+int bt_rpa_irk_matches_batch(const uint8_t *const irks[], size_t count, const bt_addr_t *addr)
+{
+	if (bt_rpa_irk_matches_batch_err) {
+		return bt_rpa_irk_matches_batch_err;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (bt_rpa_irk_matches(irks[i], addr)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
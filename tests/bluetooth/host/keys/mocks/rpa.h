@@ -13,3 +13,8 @@
 		FAKE(bt_rpa_irk_matches)       \
 
 DECLARE_FAKE_VALUE_FUNC(bool, bt_rpa_irk_matches, const uint8_t *, const bt_addr_t *);
+
+/* Error returned by bt_rpa_irk_matches_batch(), or 0 to resolve through the
+ * bt_rpa_irk_matches() fake.
+ */
+extern int bt_rpa_irk_matches_batch_err;
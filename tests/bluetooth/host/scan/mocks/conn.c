@@ -0,0 +1,14 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "mocks/conn.h"
+
+DEFINE_FAKE_VALUE_FUNC(struct bt_conn *, bt_conn_lookup_state_le, uint8_t, const bt_addr_le_t *,
+		       const bt_conn_state_t);
+DEFINE_FAKE_VOID_FUNC(bt_conn_set_state, struct bt_conn *, bt_conn_state_t);
+DEFINE_FAKE_VOID_FUNC(bt_conn_unref, struct bt_conn *);
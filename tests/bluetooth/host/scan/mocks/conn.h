@@ -0,0 +1,22 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/conn.h>
+
+#include <host/conn_internal.h>
+
+/* List of fakes used by this unit tester */
+#define CONN_FFF_FAKES_LIST(FAKE)                                                                  \
+	FAKE(bt_conn_lookup_state_le)                                                              \
+	FAKE(bt_conn_set_state)                                                                    \
+	FAKE(bt_conn_unref)
+
+DECLARE_FAKE_VALUE_FUNC(struct bt_conn *, bt_conn_lookup_state_le, uint8_t, const bt_addr_le_t *,
+			const bt_conn_state_t);
+DECLARE_FAKE_VOID_FUNC(bt_conn_set_state, struct bt_conn *, bt_conn_state_t);
+DECLARE_FAKE_VOID_FUNC(bt_conn_unref, struct bt_conn *);
@@ -0,0 +1,19 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "mocks/hci_core.h"
+
+DEFINE_FAKE_VALUE_FUNC(struct net_buf *, bt_hci_cmd_alloc, k_timeout_t);
+DEFINE_FAKE_VALUE_FUNC(int, bt_hci_cmd_send_sync, uint16_t, struct net_buf *, struct net_buf **);
+DEFINE_FAKE_VOID_FUNC(bt_hci_cmd_state_set_init, struct net_buf *, struct bt_hci_cmd_state_set *,
+		      atomic_t *, int, bool);
+DEFINE_FAKE_VALUE_FUNC(uint8_t, bt_get_phy, uint8_t);
+DEFINE_FAKE_VALUE_FUNC(int, bt_le_create_conn, const struct bt_conn *);
+DEFINE_FAKE_VALUE_FUNC(const bt_addr_le_t *, bt_lookup_id_addr, uint8_t, const bt_addr_le_t *);
+
+struct bt_dev bt_dev;
@@ -0,0 +1,28 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/addr.h>
+
+#include <host/hci_core.h>
+
+/* List of fakes used by this unit tester */
+#define HCI_CORE_FFF_FAKES_LIST(FAKE)                                                              \
+	FAKE(bt_hci_cmd_alloc)                                                                     \
+	FAKE(bt_hci_cmd_send_sync)                                                                 \
+	FAKE(bt_hci_cmd_state_set_init)                                                            \
+	FAKE(bt_get_phy)                                                                           \
+	FAKE(bt_le_create_conn)                                                                    \
+	FAKE(bt_lookup_id_addr)
+
+DECLARE_FAKE_VALUE_FUNC(struct net_buf *, bt_hci_cmd_alloc, k_timeout_t);
+DECLARE_FAKE_VALUE_FUNC(int, bt_hci_cmd_send_sync, uint16_t, struct net_buf *, struct net_buf **);
+DECLARE_FAKE_VOID_FUNC(bt_hci_cmd_state_set_init, struct net_buf *, struct bt_hci_cmd_state_set *,
+		       atomic_t *, int, bool);
+DECLARE_FAKE_VALUE_FUNC(uint8_t, bt_get_phy, uint8_t);
+DECLARE_FAKE_VALUE_FUNC(int, bt_le_create_conn, const struct bt_conn *);
+DECLARE_FAKE_VALUE_FUNC(const bt_addr_le_t *, bt_lookup_id_addr, uint8_t, const bt_addr_le_t *);
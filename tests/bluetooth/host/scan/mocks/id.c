@@ -0,0 +1,13 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "mocks/id.h"
+
+DEFINE_FAKE_VOID_FUNC(bt_id_pending_keys_update);
+DEFINE_FAKE_VALUE_FUNC(bool, bt_id_scan_random_addr_check);
+DEFINE_FAKE_VALUE_FUNC(int, bt_id_set_scan_own_addr, bool, uint8_t *);
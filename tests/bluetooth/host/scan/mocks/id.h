@@ -0,0 +1,18 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+
+/* List of fakes used by this unit tester */
+#define ID_FFF_FAKES_LIST(FAKE)                                                                    \
+	FAKE(bt_id_pending_keys_update)                                                            \
+	FAKE(bt_id_scan_random_addr_check)                                                         \
+	FAKE(bt_id_set_scan_own_addr)
+
+DECLARE_FAKE_VOID_FUNC(bt_id_pending_keys_update);
+DECLARE_FAKE_VALUE_FUNC(bool, bt_id_scan_random_addr_check);
+DECLARE_FAKE_VALUE_FUNC(int, bt_id_set_scan_own_addr, bool, uint8_t *);
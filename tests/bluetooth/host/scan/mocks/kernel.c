@@ -0,0 +1,14 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include "mocks/kernel.h"
+
+DEFINE_FAKE_VALUE_FUNC(int, k_mutex_init, struct k_mutex *);
+DEFINE_FAKE_VALUE_FUNC(int, k_mutex_lock, struct k_mutex *, k_timeout_t);
+DEFINE_FAKE_VALUE_FUNC(int, k_mutex_unlock, struct k_mutex *);
+DEFINE_FAKE_VOID_FUNC(k_yield);
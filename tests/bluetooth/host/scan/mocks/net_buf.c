@@ -0,0 +1,12 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+
+#include "mocks/net_buf.h"
+
+DEFINE_FAKE_VOID_FUNC(net_buf_reset, struct net_buf *);
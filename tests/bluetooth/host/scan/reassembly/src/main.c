@@ -0,0 +1,213 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/fff.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <host/scan.h>
+
+#include "mocks/addr_internal.h"
+#include "mocks/conn.h"
+#include "mocks/hci_core.h"
+#include "mocks/id.h"
+#include "mocks/kernel.h"
+#include "mocks/net_buf.h"
+
+DEFINE_FFF_GLOBALS;
+
+#define MAX_REPORTS    4
+#define MAX_REPORT_LEN CONFIG_BT_EXT_SCAN_BUF_SIZE
+/* Length of reports of which two don't fit in the reassembly buffer */
+#define LONG_FRAG_LEN  200
+
+BUILD_ASSERT(2 * LONG_FRAG_LEN > CONFIG_BT_EXT_SCAN_BUF_SIZE);
+
+static const bt_addr_le_t addr_a = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0x0a, 0x00, 0x00, 0x00, 0x00, 0xc0},
+};
+static const bt_addr_le_t addr_b = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0x0b, 0x00, 0x00, 0x00, 0x00, 0xc0},
+};
+
+static struct {
+	bt_addr_le_t addr;
+	uint16_t len;
+	uint8_t data[MAX_REPORT_LEN];
+} reports[MAX_REPORTS];
+static size_t report_cnt;
+
+static uint8_t cmd_data[16];
+static struct net_buf cmd_buf;
+
+static struct net_buf *bt_hci_cmd_alloc_custom_fake(k_timeout_t timeout)
+{
+	net_buf_simple_init_with_data(&cmd_buf.b, cmd_data, sizeof(cmd_data));
+	net_buf_simple_reset(&cmd_buf.b);
+
+	return &cmd_buf;
+}
+
+static const bt_addr_le_t *bt_lookup_id_addr_custom_fake(uint8_t id, const bt_addr_le_t *addr)
+{
+	return addr;
+}
+
+static void scan_recv(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf)
+{
+	zassert_true(report_cnt < MAX_REPORTS, "Too many reports");
+	zassert_true(buf->len <= MAX_REPORT_LEN, "Report too long");
+
+	bt_addr_le_copy(&reports[report_cnt].addr, info->addr);
+	reports[report_cnt].len = buf->len;
+	memcpy(reports[report_cnt].data, buf->data, buf->len);
+	report_cnt++;
+}
+
+static struct bt_le_scan_cb scan_cb = {
+	.recv = scan_recv,
+};
+
+static void fff_reset_rule_before(const struct ztest_unit_test *test, void *fixture)
+{
+	ADDR_INTERNAL_FFF_FAKES_LIST(RESET_FAKE);
+	CONN_FFF_FAKES_LIST(RESET_FAKE);
+	HCI_CORE_FFF_FAKES_LIST(RESET_FAKE);
+	ID_FFF_FAKES_LIST(RESET_FAKE);
+	KERNEL_FFF_FAKES_LIST(RESET_FAKE);
+	NET_BUF_FFF_FAKES_LIST(RESET_FAKE);
+}
+
+ZTEST_RULE(fff_reset_rule, fff_reset_rule_before, NULL);
+
+static void reassembly_before(void *f)
+{
+	bt_hci_cmd_alloc_fake.custom_fake = bt_hci_cmd_alloc_custom_fake;
+	bt_lookup_id_addr_fake.custom_fake = bt_lookup_id_addr_custom_fake;
+
+	bt_scan_reset();
+	atomic_set_bit(bt_dev.flags, BT_DEV_READY);
+
+	report_cnt = 0;
+	bt_le_scan_cb_register(&scan_cb);
+	zassert_ok(bt_le_scan_start(BT_LE_SCAN_PASSIVE, NULL));
+}
+
+static void reassembly_after(void *f)
+{
+	zassert_ok(bt_le_scan_stop());
+	bt_le_scan_cb_unregister(&scan_cb);
+}
+
+ZTEST_SUITE(bt_scan_reassembly, NULL, NULL, reassembly_before, reassembly_after, NULL);
+
+/* Feed one extended advertising report of len octets, all set to the fragment index */
+static void adv_report(const bt_addr_le_t *addr, uint8_t data_status, uint8_t frag, uint8_t len)
+{
+	static uint8_t evt_data[1 + sizeof(struct bt_hci_evt_le_ext_advertising_info) + UINT8_MAX];
+	struct bt_hci_evt_le_ext_advertising_info *info;
+	struct net_buf buf;
+
+	net_buf_simple_init_with_data(&buf.b, evt_data, sizeof(evt_data));
+	net_buf_simple_reset(&buf.b);
+
+	net_buf_add_u8(&buf, 1);
+	info = net_buf_add(&buf, sizeof(*info));
+	(void)memset(info, 0, sizeof(*info));
+	info->evt_type = sys_cpu_to_le16(data_status << 5);
+	bt_addr_le_copy(&info->addr, addr);
+	info->prim_phy = BT_HCI_LE_EXT_SCAN_PHY_1M;
+	info->sid = 1;
+	info->tx_power = BT_HCI_LE_ADV_TX_POWER_NO_PREF;
+	info->rssi = -40;
+	info->length = len;
+	(void)memset(net_buf_add(&buf, len), frag, len);
+
+	bt_hci_le_adv_ext_report(&buf);
+}
+
+static void check_report(size_t idx, const bt_addr_le_t *addr, uint8_t frag_cnt, uint8_t frag_len)
+{
+	zassert_true(bt_addr_le_eq(&reports[idx].addr, addr), "Report %zu from wrong advertiser",
+		     idx);
+	zassert_equal(reports[idx].len, frag_cnt * frag_len, "Report %zu truncated (len %u)", idx,
+		      reports[idx].len);
+
+	for (uint16_t i = 0; i < reports[idx].len; i++) {
+		zassert_equal(reports[idx].data[i], i / frag_len, "Report %zu corrupted at %u", idx,
+			      i);
+	}
+}
+
+/*
+ *  Test two advertisers sending interleaved chains of three reports
+ *
+ *  Expected behaviour:
+ *   - With a single reassembly context, the second advertiser evicts the first one and
+ *     the remaining reports of the first advertiser are discarded
+ *   - With two contexts, both advertisements are reassembled
+ *   - No truncated advertisement is reported
+ */
+ZTEST(bt_scan_reassembly, test_interleaved_advertisers)
+{
+	const uint8_t frag_len = 60;
+	struct bt_le_scan_reassembly_stats stats;
+
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 0, frag_len);
+	adv_report(&addr_b, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 0, frag_len);
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 1, frag_len);
+	adv_report(&addr_b, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 1, frag_len);
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_COMPLETE, 2, frag_len);
+	adv_report(&addr_b, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_COMPLETE, 2, frag_len);
+
+	zassert_ok(bt_le_scan_reassembly_stats_get(&stats));
+
+	if (CONFIG_BT_EXT_SCAN_REASSEMBLY_COUNT == 1) {
+		zassert_equal(report_cnt, 1, "Unexpected reports %zu", report_cnt);
+		check_report(0, &addr_b, 3, frag_len);
+		zassert_equal(stats.completed, 1);
+		zassert_equal(stats.discarded, 1);
+	} else {
+		zassert_equal(report_cnt, 2, "Unexpected reports %zu", report_cnt);
+		check_report(0, &addr_a, 3, frag_len);
+		check_report(1, &addr_b, 3, frag_len);
+		zassert_equal(stats.completed, 2);
+		zassert_equal(stats.discarded, 0);
+	}
+
+	/* The evicted advertiser is reassembled again from its next chain */
+	report_cnt = 0;
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 0, frag_len);
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_COMPLETE, 1, frag_len);
+
+	zassert_equal(report_cnt, 1, "Unexpected reports %zu", report_cnt);
+	check_report(0, &addr_a, 2, frag_len);
+}
+
+/*
+ *  Test a second advertiser arriving while the reports of the first one are discarded,
+ *  because they don't fit in the reassembly buffer
+ *
+ *  Expected behaviour:
+ *   - The last report of the first advertiser is discarded, whether or not its context
+ *     has been evicted
+ *   - The second advertisement is reassembled
+ */
+ZTEST(bt_scan_reassembly, test_discarding_advertiser_evicted)
+{
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 0, LONG_FRAG_LEN);
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 1, LONG_FRAG_LEN);
+	adv_report(&addr_b, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_PARTIAL, 0, 10);
+	adv_report(&addr_a, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_COMPLETE, 2, LONG_FRAG_LEN);
+	adv_report(&addr_b, BT_HCI_LE_ADV_EVT_TYPE_DATA_STATUS_COMPLETE, 1, 10);
+
+	zassert_equal(report_cnt, 1, "Unexpected reports %zu", report_cnt);
+	check_report(0, &addr_b, 2, 10);
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net.h"
+#include "access.h"
+#include "foundation.h"
+#include "settings.h"
+
+#define TEST_CID       0x0059
+#define TEST_ADDR      0x0100
+#define TEST_APP_IDX   0x0000
+#define TEST_GROUP     0xc001
+#define TEST_GROUP_2   0xc777
+#define TEST_GROUP_3   0xc123
+#define ELEM_COUNT     4
+#define MODEL_COUNT    8
+#define OPS_PER_MODEL  8
+#define VND_OP_COUNT   4
+#define BENCH_MSG_CNT  10000
+
+/* OpCode k of SIG model m, shared by all elements */
+#define SIG_OP(m, k)   BT_MESH_MODEL_OP_2(0x82, (m) * OPS_PER_MODEL + (k))
+#define VND_OP(k)      BT_MESH_MODEL_OP_3(k, TEST_CID)
+/* OpCode that every SIG model handles, only the first one gets it */
+#define SHARED_OP      SIG_OP(0, 0)
+
+static const struct bt_mesh_model *rx_model;
+static int rx_cnt;
+
+static int msg_handler(const struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		       struct net_buf_simple *buf)
+{
+	rx_model = model;
+	rx_cnt++;
+
+	return 0;
+}
+
+#define OP_ENTRY(m, k) { SIG_OP(m, k), 0, msg_handler }
+#define MODEL_OPS(m)                                                                       \
+	static const struct bt_mesh_model_op model_ops_##m[] = {                           \
+		OP_ENTRY(m, 0), OP_ENTRY(m, 1), OP_ENTRY(m, 2), OP_ENTRY(m, 3),             \
+		OP_ENTRY(m, 4), OP_ENTRY(m, 5), OP_ENTRY(m, 6), OP_ENTRY(m, 7),             \
+		{ SHARED_OP, 0, msg_handler },                                              \
+		BT_MESH_MODEL_OP_END,                                                       \
+	}
+
+MODEL_OPS(0);
+MODEL_OPS(1);
+MODEL_OPS(2);
+MODEL_OPS(3);
+MODEL_OPS(4);
+MODEL_OPS(5);
+MODEL_OPS(6);
+MODEL_OPS(7);
+
+static const struct bt_mesh_model_op vnd_ops[] = {
+	{ VND_OP(0), 0, msg_handler },
+	{ VND_OP(1), 0, msg_handler },
+	{ VND_OP(2), 0, msg_handler },
+	{ VND_OP(3), 0, msg_handler },
+	BT_MESH_MODEL_OP_END,
+};
+
+#define SIG_MODEL(m) BT_MESH_MODEL_CB(0x1000 + (m), model_ops_##m, NULL, NULL, NULL)
+#define ELEM_MODELS(e)                                                                     \
+	static const struct bt_mesh_model models_##e[] = {                                 \
+		SIG_MODEL(0), SIG_MODEL(1), SIG_MODEL(2), SIG_MODEL(3),                     \
+		SIG_MODEL(4), SIG_MODEL(5), SIG_MODEL(6), SIG_MODEL(7),                     \
+	};                                                                                  \
+	static const struct bt_mesh_model vnd_models_##e[] = {                             \
+		BT_MESH_MODEL_VND_CB(TEST_CID, 0x0001, vnd_ops, NULL, NULL, NULL),          \
+	}
+
+ELEM_MODELS(0);
+ELEM_MODELS(1);
+ELEM_MODELS(2);
+ELEM_MODELS(3);
+
+static const struct bt_mesh_elem elements[ELEM_COUNT] = {
+	BT_MESH_ELEM(0, models_0, vnd_models_0),
+	BT_MESH_ELEM(0, models_1, vnd_models_1),
+	BT_MESH_ELEM(0, models_2, vnd_models_2),
+	BT_MESH_ELEM(0, models_3, vnd_models_3),
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = TEST_CID,
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+/**** Helper functions ****/
+
+static int model_recv(uint16_t dst, uint32_t opcode)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, 8);
+	struct bt_mesh_msg_ctx ctx = {
+		.app_idx = TEST_APP_IDX,
+		.addr = 0x0001,
+		.recv_dst = dst,
+	};
+
+	switch (BT_MESH_MODEL_OP_LEN(opcode)) {
+	case 1:
+		net_buf_simple_add_u8(&buf, opcode);
+		break;
+	case 2:
+		net_buf_simple_add_be16(&buf, opcode);
+		break;
+	default:
+		net_buf_simple_add_u8(&buf, opcode >> 16);
+		net_buf_simple_add_le16(&buf, opcode & 0xffff);
+		break;
+	}
+
+	rx_model = NULL;
+	rx_cnt = 0;
+
+	return bt_mesh_model_recv(&ctx, &buf);
+}
+
+static void check_recv(uint16_t dst, uint32_t opcode, const struct bt_mesh_model *model)
+{
+	zassert_equal(model_recv(dst, opcode), ACCESS_STATUS_SUCCESS,
+		      "OpCode 0x%06x to 0x%04x rejected", opcode, dst);
+	zassert_equal(rx_model, model, "OpCode 0x%06x to 0x%04x went to the wrong model",
+		      opcode, dst);
+	zassert_equal(rx_cnt, 1);
+}
+
+static void bind_model(const struct bt_mesh_model *mod, const struct bt_mesh_elem *elem,
+		       bool vnd, bool primary, void *user_data)
+{
+	mod->keys[0] = TEST_APP_IDX;
+	(void)memset(mod->groups, 0, mod->groups_cnt * sizeof(mod->groups[0]));
+}
+
+static void *setup(void)
+{
+	zassert_ok(bt_mesh_comp_register(&comp));
+	bt_mesh_comp_provision(TEST_ADDR);
+
+	/* One extension tree spanning the first two elements */
+	zassert_ok(bt_mesh_model_extend(&elements[1].models[4], &elements[0].models[4]));
+	zassert_ok(bt_mesh_model_extend(&elements[1].models[4], &elements[1].models[5]));
+
+	return NULL;
+}
+
+static void before(void *f)
+{
+	bt_mesh_model_foreach(bind_model, NULL);
+
+	for (int i = 0; i < ELEM_COUNT; i++) {
+		bt_mesh_model_sub_changed(&elements[i].models[0]);
+	}
+}
+
+/**** Mocked functions ****/
+
+struct bt_mesh_net bt_mesh;
+
+bool bt_mesh_is_provisioned(void)
+{
+	return true;
+}
+
+void bt_mesh_settings_store_schedule(enum bt_mesh_settings_flag flag)
+{
+}
+
+int bt_mesh_trans_send(struct bt_mesh_net_tx *tx, struct net_buf_simple *msg,
+		       const struct bt_mesh_send_cb *cb, void *cb_data)
+{
+	return 0;
+}
+
+int bt_mesh_va_get_idx_by_uuid(const uint8_t *uuid, uint16_t *uuidx)
+{
+	return -ENOENT;
+}
+
+int settings_save_one(const char *name, const void *value, size_t val_len)
+{
+	return 0;
+}
+
+int settings_delete(const char *name)
+{
+	return 0;
+}
+
+int settings_name_next(const char *name, const char **next)
+{
+	return 0;
+}
+
+/**** Tests ****/
+
+ZTEST_SUITE(bt_mesh_access, NULL, setup, before, NULL, NULL);
+
+/** Test that every OpCode of every element is dispatched to the model that declares it. */
+ZTEST(bt_mesh_access, test_dispatch)
+{
+	for (int e = 0; e < ELEM_COUNT; e++) {
+		const struct bt_mesh_elem *elem = &elements[e];
+
+		for (int m = 0; m < MODEL_COUNT; m++) {
+			for (int k = 0; k < OPS_PER_MODEL; k++) {
+				if (SIG_OP(m, k) == SHARED_OP) {
+					continue;
+				}
+
+				check_recv(TEST_ADDR + e, SIG_OP(m, k), &elem->models[m]);
+			}
+		}
+
+		for (int k = 0; k < VND_OP_COUNT; k++) {
+			check_recv(TEST_ADDR + e, VND_OP(k), &elem->vnd_models[0]);
+		}
+
+		/* Declared by every SIG model, handled by the first one */
+		check_recv(TEST_ADDR + e, SHARED_OP, &elem->models[0]);
+	}
+}
+
+/** Test that unknown OpCodes and OpCodes with the wrong size are rejected. */
+ZTEST(bt_mesh_access, test_unknown_opcode)
+{
+	zassert_equal(model_recv(TEST_ADDR, SIG_OP(MODEL_COUNT, 0)), ACCESS_STATUS_WRONG_OPCODE);
+	zassert_equal(model_recv(TEST_ADDR, 0x01), ACCESS_STATUS_WRONG_OPCODE);
+	zassert_equal(model_recv(TEST_ADDR, VND_OP(VND_OP_COUNT)), ACCESS_STATUS_WRONG_OPCODE);
+	zassert_equal(model_recv(TEST_ADDR, BT_MESH_MODEL_OP_3(0, TEST_CID + 1)),
+		      ACCESS_STATUS_WRONG_OPCODE);
+	zassert_equal(rx_cnt, 0);
+}
+
+/** Test that group messages only reach elements with a subscribed model. */
+ZTEST(bt_mesh_access, test_group_subscription)
+{
+	const struct bt_mesh_model *mod = &elements[2].models[3];
+
+	zassert_false(bt_mesh_has_addr(TEST_GROUP));
+	zassert_equal(model_recv(TEST_GROUP, SIG_OP(3, 1)), ACCESS_STATUS_MESSAGE_NOT_UNDERSTOOD);
+	zassert_equal(rx_cnt, 0);
+
+	mod->groups[1] = TEST_GROUP;
+	bt_mesh_model_sub_changed(mod);
+
+	zassert_true(bt_mesh_has_addr(TEST_GROUP));
+	zassert_false(bt_mesh_has_addr(TEST_GROUP_2));
+	check_recv(TEST_GROUP, SIG_OP(3, 1), mod);
+
+	/* Other models on the element don't get the message */
+	zassert_equal(model_recv(TEST_GROUP, SIG_OP(2, 1)), ACCESS_STATUS_MESSAGE_NOT_UNDERSTOOD);
+	zassert_equal(rx_cnt, 0);
+
+	mod->groups[1] = BT_MESH_ADDR_UNASSIGNED;
+	bt_mesh_model_sub_changed(mod);
+
+	zassert_false(bt_mesh_has_addr(TEST_GROUP));
+	zassert_equal(model_recv(TEST_GROUP, SIG_OP(3, 1)), ACCESS_STATUS_MESSAGE_NOT_UNDERSTOOD);
+	zassert_equal(rx_cnt, 0);
+}
+
+/** Test that group messages reach models whose subscription list is held by another model
+ *  of their extension tree, when the tree spans several elements.
+ */
+ZTEST(bt_mesh_access, test_group_subscription_extension)
+{
+	const struct bt_mesh_model *base = &elements[0].models[4];
+	const struct bt_mesh_model *ext = &elements[1].models[4];
+	const struct bt_mesh_model *sub = &elements[1].models[5];
+
+	/* Subscribed through a model on the same element */
+	sub->groups[0] = TEST_GROUP_3;
+	bt_mesh_model_sub_changed(sub);
+
+	zassert_true(bt_mesh_has_addr(TEST_GROUP_3));
+	check_recv(TEST_GROUP_3, SIG_OP(4, 2), ext);
+	check_recv(TEST_GROUP_3, SIG_OP(5, 2), sub);
+
+	sub->groups[0] = BT_MESH_ADDR_UNASSIGNED;
+	bt_mesh_model_sub_changed(sub);
+
+	zassert_equal(model_recv(TEST_GROUP_3, SIG_OP(4, 2)),
+		      ACCESS_STATUS_MESSAGE_NOT_UNDERSTOOD);
+	zassert_equal(rx_cnt, 0);
+
+	/* Subscribed through the base model on the first element */
+	base->groups[0] = TEST_GROUP_3;
+	bt_mesh_model_sub_changed(base);
+
+	zassert_true(bt_mesh_has_addr(TEST_GROUP_3));
+	check_recv(TEST_GROUP_3, SIG_OP(4, 2), base);
+
+	base->groups[0] = BT_MESH_ADDR_UNASSIGNED;
+	bt_mesh_model_sub_changed(base);
+
+	zassert_false(bt_mesh_has_addr(TEST_GROUP_3));
+}
+
+/** Measure the cost of dispatching a unicast message to the last model of an element,
+ *  and a group message that no model subscribes to.
+ */
+ZTEST(bt_mesh_access, test_dispatch_cost)
+{
+	const uint32_t opcode = SIG_OP(MODEL_COUNT - 1, OPS_PER_MODEL - 1);
+	const uint16_t dst = TEST_ADDR + ELEM_COUNT - 1;
+	uint32_t unicast;
+	uint32_t group;
+	uint32_t start;
+
+	elements[0].models[0].groups[0] = TEST_GROUP_2;
+	bt_mesh_model_sub_changed(&elements[0].models[0]);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCH_MSG_CNT; i++) {
+		(void)model_recv(dst, opcode);
+	}
+	unicast = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < BENCH_MSG_CNT; i++) {
+		(void)bt_mesh_has_addr(TEST_GROUP);
+	}
+	group = k_cycle_get_32() - start;
+
+	check_recv(dst, opcode, &elements[ELEM_COUNT - 1].models[MODEL_COUNT - 1]);
+	zassert_false(bt_mesh_has_addr(TEST_GROUP));
+
+	TC_PRINT("OpCode table %u: unicast message %llu ns, group lookup %llu ns\n",
+		 CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE,
+		 k_cyc_to_ns_floor64(unicast) / BENCH_MSG_CNT,
+		 k_cyc_to_ns_floor64(group) / BENCH_MSG_CNT);
+}
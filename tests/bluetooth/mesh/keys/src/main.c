@@ -0,0 +1,449 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "crypto.h"
+#include "net.h"
+#include "subnet.h"
+#include "app_keys.h"
+#include "settings.h"
+#include "foundation.h"
+
+/* Keys are told apart by their first two bytes: the NID or AID the mocked
+ * key derivation returns, and a tag identifying the key in the tests.
+ */
+#define KEY(_id, _tag) { (_id), (_tag) }
+
+#define KEY_STORE_SIZE 16
+
+#define TRIED_MAX 8
+
+struct bt_mesh_net bt_mesh;
+
+static uint8_t key_store[KEY_STORE_SIZE][16];
+static bool key_store_used[KEY_STORE_SIZE];
+
+/* Tags of the keys tried by the last lookup, in order */
+static uint8_t tried[TRIED_MAX];
+static size_t tried_count;
+/* Tag of the key the lookup callback accepts */
+static uint8_t accept_tag;
+
+/**** Mocked functions ****/
+
+int bt_mesh_key_import(enum bt_mesh_key_type type, const uint8_t in[16], struct bt_mesh_key *out)
+{
+	for (int i = 0; i < ARRAY_SIZE(key_store); i++) {
+		if (!key_store_used[i]) {
+			key_store_used[i] = true;
+			memcpy(key_store[i], in, 16);
+			out->key = i + 1;
+			return 0;
+		}
+	}
+
+	return -ENOMEM;
+}
+
+int bt_mesh_key_export(uint8_t out[16], const struct bt_mesh_key *in)
+{
+	if (in->key == 0 || in->key > ARRAY_SIZE(key_store)) {
+		return -EINVAL;
+	}
+
+	memcpy(out, key_store[in->key - 1], 16);
+
+	return 0;
+}
+
+void bt_mesh_key_assign(struct bt_mesh_key *dst, const struct bt_mesh_key *src)
+{
+	memcpy(dst, src, sizeof(*dst));
+}
+
+int bt_mesh_key_destroy(const struct bt_mesh_key *key)
+{
+	/* Derived keys are not stored */
+	if (key->key != 0 && key->key <= ARRAY_SIZE(key_store)) {
+		key_store_used[key->key - 1] = false;
+	}
+
+	return 0;
+}
+
+int bt_mesh_key_compare(const uint8_t raw_key[16], const struct bt_mesh_key *mesh_key)
+{
+	if (mesh_key->key == 0 || mesh_key->key > ARRAY_SIZE(key_store)) {
+		return -EINVAL;
+	}
+
+	return memcmp(raw_key, key_store[mesh_key->key - 1], 16);
+}
+
+int bt_mesh_k2(const uint8_t n[16], const uint8_t *p, size_t p_len, uint8_t net_id[1],
+	       struct bt_mesh_key *enc_key, struct bt_mesh_key *priv_key)
+{
+	net_id[0] = n[0] & 0x7f;
+	enc_key->key = 0;
+	priv_key->key = 0;
+
+	return 0;
+}
+
+int bt_mesh_k3(const uint8_t n[16], uint8_t out[8])
+{
+	memset(out, 0, 8);
+
+	return 0;
+}
+
+int bt_mesh_k4(const uint8_t n[16], uint8_t out[1])
+{
+	out[0] = n[0] & 0x3f;
+
+	return 0;
+}
+
+int bt_mesh_id128(const uint8_t n[16], const char *s, enum bt_mesh_key_type type,
+		  struct bt_mesh_key *out)
+{
+	out->key = 0;
+
+	return 0;
+}
+
+void bt_mesh_beacon_update(struct bt_mesh_subnet *sub)
+{
+}
+
+void bt_mesh_net_loopback_clear(uint16_t net_idx)
+{
+}
+
+bool bt_mesh_has_addr(uint16_t addr)
+{
+	return false;
+}
+
+void bt_mesh_settings_store_schedule(enum bt_mesh_settings_flag flag)
+{
+}
+
+int settings_save_one(const char *name, const void *value, size_t val_len)
+{
+	return 0;
+}
+
+int settings_delete(const char *name)
+{
+	return 0;
+}
+
+/**** Mocked functions - end ****/
+
+/* Network credential lookup callback, accepts the credential of accept_tag */
+static bool net_cred_cb(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
+			struct net_buf_simple *out, const struct bt_mesh_net_cred *cred)
+{
+	const struct bt_mesh_subnet_keys *keys = CONTAINER_OF(cred, struct bt_mesh_subnet_keys,
+							       msg);
+	uint8_t raw[16];
+
+	if (bt_mesh_key_export(raw, &keys->net) || tried_count == ARRAY_SIZE(tried)) {
+		return false;
+	}
+
+	tried[tried_count++] = raw[1];
+
+	return raw[1] == accept_tag;
+}
+
+/* Application key lookup callback, accepts the key of accept_tag */
+static int app_key_cb(struct bt_mesh_net_rx *rx, const struct bt_mesh_key *key, void *cb_data)
+{
+	uint8_t raw[16];
+
+	if (bt_mesh_key_export(raw, key) || tried_count == ARRAY_SIZE(tried)) {
+		return -EINVAL;
+	}
+
+	tried[tried_count++] = raw[1];
+
+	return raw[1] == accept_tag ? 0 : -EINVAL;
+}
+
+/* Look up the network credentials of a PDU with the given NID */
+static bool net_cred_find(struct bt_mesh_net_rx *rx, uint8_t nid, uint8_t accept)
+{
+	NET_BUF_SIMPLE_DEFINE(in, 1);
+
+	net_buf_simple_add_u8(&in, nid);
+
+	memset(rx, 0, sizeof(*rx));
+	tried_count = 0;
+	accept_tag = accept;
+
+	return bt_mesh_net_cred_find(rx, &in, NULL, net_cred_cb);
+}
+
+/* Look up the application key of a message with the given AID */
+static uint16_t app_key_find(uint16_t net_idx, bool new_key, uint8_t aid, uint8_t accept)
+{
+	struct bt_mesh_net_rx rx = {
+		.sub = bt_mesh_subnet_get(net_idx),
+		.new_key = new_key,
+	};
+
+	tried_count = 0;
+	accept_tag = accept;
+
+	return bt_mesh_app_key_find(false, aid, &rx, app_key_cb, NULL);
+}
+
+static void tried_check(const uint8_t *tags, size_t count)
+{
+	zassert_equal(tried_count, count, "%zu keys tried, expected %zu", tried_count, count);
+	zassert_mem_equal(tried, tags, count, "Keys tried in the wrong order");
+}
+
+static void subnet_add(uint16_t net_idx, uint8_t nid, uint8_t tag)
+{
+	const uint8_t key[16] = KEY(nid, tag);
+
+	zassert_equal(bt_mesh_subnet_add(net_idx, key), STATUS_SUCCESS);
+	zassert_not_null(bt_mesh_subnet_get(net_idx));
+}
+
+static void app_key_add(uint16_t app_idx, uint16_t net_idx, uint8_t aid, uint8_t tag)
+{
+	const uint8_t key[16] = KEY(aid, tag);
+
+	zassert_equal(bt_mesh_app_key_add(app_idx, net_idx, key), STATUS_SUCCESS);
+	zassert_true(bt_mesh_app_key_exists(app_idx));
+}
+
+static void kr_phase_set(uint16_t net_idx, uint8_t phase)
+{
+	uint8_t status;
+
+	status = bt_mesh_subnet_kr_phase_set(net_idx, &phase);
+	zassert_equal(status, STATUS_SUCCESS);
+}
+
+static void keys_reset(void *f)
+{
+	bt_mesh_net_keys_reset();
+	bt_mesh_app_keys_reset();
+
+	for (int i = 0; i < ARRAY_SIZE(key_store_used); i++) {
+		zassert_false(key_store_used[i], "Key %d not destroyed", i);
+	}
+}
+
+ZTEST_SUITE(bt_mesh_keys, NULL, NULL, keys_reset, keys_reset, NULL);
+
+/*
+ *  Look up network credentials while subnets are added and deleted.
+ *
+ *  Expected behaviour:
+ *   - Only the credentials with the NID of the PDU are tried, in subnet order
+ *   - Deleted subnets are no longer tried, and a subnet added in their place
+ *     is
+ */
+ZTEST(bt_mesh_keys, test_net_cred_find_add_del)
+{
+	struct bt_mesh_net_rx rx;
+
+	subnet_add(0x000, 0x11, 0xa0);
+	subnet_add(0x001, 0x22, 0xa1);
+	subnet_add(0x002, 0x11, 0xa2);
+
+	zassert_false(net_cred_find(&rx, 0x11, 0));
+	tried_check((const uint8_t[]){ 0xa0, 0xa2 }, 2);
+
+	zassert_true(net_cred_find(&rx, 0x11, 0xa2));
+	tried_check((const uint8_t[]){ 0xa0, 0xa2 }, 2);
+	zassert_equal(rx.sub, bt_mesh_subnet_get(0x002));
+	zassert_equal(rx.ctx.net_idx, 0x002);
+	zassert_false(rx.new_key);
+
+	zassert_true(net_cred_find(&rx, 0x22, 0xa1));
+	tried_check((const uint8_t[]){ 0xa1 }, 1);
+	zassert_equal(rx.ctx.net_idx, 0x001);
+
+	zassert_false(net_cred_find(&rx, 0x33, 0));
+	tried_check(NULL, 0);
+
+	zassert_equal(bt_mesh_subnet_del(0x000), STATUS_SUCCESS);
+	zassert_is_null(bt_mesh_subnet_get(0x000));
+
+	zassert_false(net_cred_find(&rx, 0x11, 0));
+	tried_check((const uint8_t[]){ 0xa2 }, 1);
+
+	/* Takes the slot of the deleted subnet */
+	subnet_add(0x005, 0x11, 0xa5);
+
+	zassert_true(net_cred_find(&rx, 0x11, 0xa5));
+	tried_check((const uint8_t[]){ 0xa5 }, 1);
+	zassert_equal(rx.ctx.net_idx, 0x005);
+
+	zassert_equal(bt_mesh_subnet_del(0x001), STATUS_SUCCESS);
+
+	zassert_false(net_cred_find(&rx, 0x22, 0));
+	tried_check(NULL, 0);
+}
+
+/*
+ *  Look up network credentials through the Key Refresh procedure.
+ *
+ *  Expected behaviour:
+ *   - The new key is tried from Phase 1 on, and reported as such
+ *   - The old key is tried until the procedure completes
+ */
+ZTEST(bt_mesh_keys, test_net_cred_find_key_refresh)
+{
+	const uint8_t new_key[16] = KEY(0x44, 0xb1);
+	struct bt_mesh_net_rx rx;
+
+	subnet_add(0x000, 0x11, 0xb0);
+	subnet_add(0x001, 0x44, 0xc0);
+
+	zassert_equal(bt_mesh_subnet_update(0x000, new_key), STATUS_SUCCESS);
+
+	zassert_true(net_cred_find(&rx, 0x11, 0xb0));
+	tried_check((const uint8_t[]){ 0xb0 }, 1);
+	zassert_false(rx.new_key);
+
+	zassert_true(net_cred_find(&rx, 0x44, 0xb1));
+	tried_check((const uint8_t[]){ 0xb1 }, 1);
+	zassert_equal(rx.ctx.net_idx, 0x000);
+	zassert_true(rx.new_key);
+
+	zassert_false(net_cred_find(&rx, 0x44, 0));
+	tried_check((const uint8_t[]){ 0xb1, 0xc0 }, 2);
+
+	kr_phase_set(0x000, BT_MESH_KR_PHASE_2);
+
+	zassert_true(net_cred_find(&rx, 0x11, 0xb0));
+	zassert_true(net_cred_find(&rx, 0x44, 0xb1));
+	zassert_true(rx.new_key);
+
+	kr_phase_set(0x000, BT_MESH_KR_PHASE_3);
+
+	zassert_false(net_cred_find(&rx, 0x11, 0));
+	tried_check(NULL, 0);
+
+	zassert_true(net_cred_find(&rx, 0x44, 0xb1));
+	tried_check((const uint8_t[]){ 0xb1 }, 1);
+	zassert_equal(rx.ctx.net_idx, 0x000);
+	zassert_false(rx.new_key);
+}
+
+/*
+ *  Look up application keys while keys and subnets are added and deleted.
+ *
+ *  Expected behaviour:
+ *   - Only the keys with the AID of the message that are bound to the
+ *     receiving subnet are tried, in key order
+ *   - Deleted keys, and the keys of a deleted subnet, are no longer tried
+ */
+ZTEST(bt_mesh_keys, test_app_key_find_add_del)
+{
+	subnet_add(0x000, 0x11, 0xa0);
+	subnet_add(0x001, 0x22, 0xa1);
+
+	app_key_add(0x010, 0x000, 0x05, 0xd0);
+	app_key_add(0x011, 0x000, 0x05, 0xd1);
+	app_key_add(0x012, 0x001, 0x05, 0xd2);
+	app_key_add(0x013, 0x000, 0x06, 0xd3);
+
+	zassert_equal(app_key_find(0x000, false, 0x05, 0), BT_MESH_KEY_UNUSED);
+	tried_check((const uint8_t[]){ 0xd0, 0xd1 }, 2);
+
+	zassert_equal(app_key_find(0x000, false, 0x05, 0xd1), 0x011);
+	zassert_equal(app_key_find(0x000, false, 0x06, 0xd3), 0x013);
+	tried_check((const uint8_t[]){ 0xd3 }, 1);
+
+	zassert_equal(app_key_find(0x001, false, 0x05, 0xd2), 0x012);
+	tried_check((const uint8_t[]){ 0xd2 }, 1);
+
+	zassert_equal(app_key_find(0x001, false, 0x06, 0), BT_MESH_KEY_UNUSED);
+	tried_check(NULL, 0);
+
+	zassert_equal(bt_mesh_app_key_del(0x010, 0x000), STATUS_SUCCESS);
+	zassert_false(bt_mesh_app_key_exists(0x010));
+
+	zassert_equal(app_key_find(0x000, false, 0x05, 0xd1), 0x011);
+	tried_check((const uint8_t[]){ 0xd1 }, 1);
+
+	/* Takes the slot of the deleted key */
+	app_key_add(0x014, 0x000, 0x05, 0xd4);
+
+	zassert_equal(app_key_find(0x000, false, 0x05, 0), BT_MESH_KEY_UNUSED);
+	tried_check((const uint8_t[]){ 0xd4, 0xd1 }, 2);
+
+	/* Deleting the subnet deletes its keys */
+	zassert_equal(bt_mesh_subnet_del(0x000), STATUS_SUCCESS);
+	zassert_false(bt_mesh_app_key_exists(0x011));
+
+	zassert_equal(app_key_find(0x001, false, 0x05, 0xd2), 0x012);
+	tried_check((const uint8_t[]){ 0xd2 }, 1);
+}
+
+/*
+ *  Look up application keys through the Key Refresh procedure.
+ *
+ *  Expected behaviour:
+ *   - The new key is only tried for messages on the new network key
+ *   - The old key is tried for messages on the old network key until the
+ *     procedure completes, and the new key from then on
+ */
+ZTEST(bt_mesh_keys, test_app_key_find_key_refresh)
+{
+	const uint8_t new_net_key[16] = KEY(0x44, 0xb1);
+	const uint8_t new_app_key[16] = KEY(0x09, 0xe1);
+
+	subnet_add(0x000, 0x11, 0xb0);
+	app_key_add(0x010, 0x000, 0x05, 0xe0);
+	app_key_add(0x011, 0x000, 0x09, 0xf0);
+
+	zassert_equal(bt_mesh_subnet_update(0x000, new_net_key), STATUS_SUCCESS);
+	zassert_equal(bt_mesh_app_key_update(0x010, 0x000, new_app_key), STATUS_SUCCESS);
+
+	zassert_equal(app_key_find(0x000, false, 0x05, 0xe0), 0x010);
+	tried_check((const uint8_t[]){ 0xe0 }, 1);
+
+	zassert_equal(app_key_find(0x000, false, 0x09, 0), BT_MESH_KEY_UNUSED);
+	tried_check((const uint8_t[]){ 0xf0 }, 1);
+
+	zassert_equal(app_key_find(0x000, true, 0x09, 0xe1), 0x010);
+	tried_check((const uint8_t[]){ 0xe1, 0xf0 }, 1);
+
+	/* Keys that have not been updated are used on both network keys */
+	zassert_equal(app_key_find(0x000, true, 0x09, 0xf0), 0x011);
+	tried_check((const uint8_t[]){ 0xe1, 0xf0 }, 2);
+
+	zassert_equal(app_key_find(0x000, true, 0x05, 0), BT_MESH_KEY_UNUSED);
+	tried_check(NULL, 0);
+
+	kr_phase_set(0x000, BT_MESH_KR_PHASE_2);
+
+	zassert_equal(app_key_find(0x000, false, 0x05, 0xe0), 0x010);
+	zassert_equal(app_key_find(0x000, true, 0x09, 0xe1), 0x010);
+
+	kr_phase_set(0x000, BT_MESH_KR_PHASE_3);
+
+	zassert_equal(app_key_find(0x000, false, 0x05, 0), BT_MESH_KEY_UNUSED);
+	tried_check(NULL, 0);
+
+	zassert_equal(app_key_find(0x000, false, 0x09, 0xe1), 0x010);
+	tried_check((const uint8_t[]){ 0xe1 }, 1);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/byteorder.h>
+#include <errno.h>
+#include "crypto.h"
+#include "net.h"
+
+#define CACHE_SIZE CONFIG_BT_MESH_MSG_CACHE_SIZE
+#define BENCH_SRC  0x2000
+#define PDU_LEN    18
+
+/* Unique MIC for every PDU so that check_dup() never filters the benchmark traffic,
+ * starting well clear of the MIC tags used by the other test suite.
+ */
+static uint32_t mic_next = 0x100;
+
+static void bench_pdu(uint8_t *dst, uint32_t seq)
+{
+	/* IVI(0) | NID | CTL(1) | TTL | SEQ | SRC | DST | PAYLOAD | MIC */
+	dst[0] = 0x11;
+	dst[1] = BIT(7) | 5;
+	sys_put_be24(seq, &dst[2]);
+	sys_put_be16(BENCH_SRC + (seq & 0xff), &dst[5]);
+	sys_put_be16(0xc001, &dst[7]);
+	dst[9] = 0xaa;
+	sys_put_be32(mic_next++, &dst[10]);
+	sys_put_be32(0x01010101, &dst[14]);
+}
+
+static int bench_decode(uint32_t seq)
+{
+	uint8_t pdu[PDU_LEN];
+	uint8_t out_buf[PDU_LEN];
+	struct net_buf_simple in;
+	struct net_buf_simple out;
+	struct bt_mesh_net_rx rx = { 0 };
+
+	bench_pdu(pdu, seq);
+	net_buf_simple_init_with_data(&in, pdu, sizeof(pdu));
+	net_buf_simple_init_with_data(&out, out_buf, sizeof(out_buf));
+
+	return bt_mesh_net_decode(&in, BT_MESH_NET_IF_ADV, &rx, &out);
+}
+
+static uint64_t ns_per_pdu(uint32_t cycles, uint32_t count)
+{
+	return k_cyc_to_ns_floor64(cycles) / count;
+}
+
+ZTEST_SUITE(bt_mesh_net_msg_cache_bench, NULL, NULL, NULL, NULL, NULL);
+
+/* Verify that the cache evicts its oldest entry first once it is full. */
+ZTEST(bt_mesh_net_msg_cache_bench, test_fifo_eviction)
+{
+	const uint32_t base = 0x10000;
+
+	bt_mesh.iv_index = 0;
+
+	for (uint32_t i = 0; i <= CACHE_SIZE; i++) {
+		zassert_ok(bench_decode(base + i), "PDU %u rejected", i);
+	}
+
+	/* The second oldest entry is still cached, the oldest one was evicted */
+	zassert_equal(bench_decode(base + 1), -ENOENT);
+	zassert_ok(bench_decode(base));
+}
+
+/* Measure the network RX cost per PDU with a full cache, both for new PDUs
+ * (lookup miss followed by eviction and insertion) and for cached PDUs.
+ */
+ZTEST(bt_mesh_net_msg_cache_bench, test_rx_cost)
+{
+	const uint32_t base = 0x20000;
+	uint32_t start;
+	uint32_t miss;
+	uint32_t hit;
+
+	bt_mesh.iv_index = 0;
+
+	for (uint32_t i = 0; i < CACHE_SIZE; i++) {
+		zassert_ok(bench_decode(base + i));
+	}
+
+	start = k_cycle_get_32();
+	for (uint32_t i = CACHE_SIZE; i < 2 * CACHE_SIZE; i++) {
+		(void)bench_decode(base + i);
+	}
+	miss = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = CACHE_SIZE; i < 2 * CACHE_SIZE; i++) {
+		(void)bench_decode(base + i);
+	}
+	hit = k_cycle_get_32() - start;
+
+	/* Every PDU of the second pass must have been found in the cache */
+	zassert_equal(bench_decode(base + CACHE_SIZE), -ENOENT);
+
+	TC_PRINT("Cache size %u: new PDU %llu ns, cached PDU %llu ns\n", CACHE_SIZE,
+		 ns_per_pdu(miss, CACHE_SIZE), ns_per_pdu(hit, CACHE_SIZE));
+}
@@ -0,0 +1,517 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+#include "settings.h"
+#include "net.h"
+#include "rpl.h"
+
+#define PAGE_SIZE      CONFIG_BT_MESH_RPL_STORE_PAGE_SIZE
+#define PAGE_COUNT     DIV_ROUND_UP(CONFIG_BT_MESH_CRPL, PAGE_SIZE)
+#define PAGE_HDR_LEN   4
+#define PAGE_ENTRY_LEN 5
+#define PAGE_PREFIX    "bt/mesh/RPL/p/"
+#define LEGACY_PREFIX  "bt/mesh/RPL/"
+#define TEST_SRC       0x100
+
+/* Per-address settings entry, as stored before paging was enabled. */
+struct rpl_val {
+	uint32_t seq:24,
+		 old_iv:1;
+};
+
+extern const struct settings_handler_static settings_handler_bt_mesh_rpl;
+
+struct bt_mesh_net bt_mesh;
+
+/* Settings entries written by the RPL, one per page. */
+static struct {
+	uint8_t data[PAGE_HDR_LEN + PAGE_SIZE * PAGE_ENTRY_LEN];
+	size_t len;
+} pages[PAGE_COUNT];
+
+/* Per-address settings entries. */
+static struct {
+	uint16_t src;
+	struct rpl_val val;
+} legacy[CONFIG_BT_MESH_CRPL];
+
+static int save_cnt;
+static int delete_cnt;
+static int unexpected_cnt;
+
+/* Number of settings operations that complete before the power is lost, or
+ * negative if the power stays on.
+ */
+static int power_left = -1;
+
+/**** Helper functions ****/
+
+static bool rpl_check(uint16_t src, uint32_t seq, bool old_iv)
+{
+	struct bt_mesh_net_rx rx = {
+		.local_match = true,
+		.ctx.addr = src,
+		.seq = seq,
+		.old_iv = old_iv,
+	};
+
+	return bt_mesh_rpl_check(&rx, NULL, false);
+}
+
+static void add_entries(int cnt)
+{
+	for (int i = 0; i < cnt; i++) {
+		zassert_false(rpl_check(TEST_SRC + i, i + 1, false), "Entry %d rejected", i);
+	}
+}
+
+static void reset_counters(void)
+{
+	save_cnt = 0;
+	delete_cnt = 0;
+	unexpected_cnt = 0;
+}
+
+/* Validate a stored page and check the number of entries in it. */
+static void check_page(int page, int cnt)
+{
+	uint8_t data[sizeof(pages[0].data)];
+	uint16_t crc;
+
+	zassert_true(pages[page].len >= PAGE_HDR_LEN, "Page %d not stored", page);
+
+	memcpy(data, pages[page].data, pages[page].len);
+	crc = sys_get_le16(&data[2]);
+	sys_put_le16(0, &data[2]);
+
+	zassert_equal(crc16_ccitt(0xffff, data, pages[page].len), crc, "Bad CRC in page %d",
+		      page);
+	zassert_equal(data[1], cnt, "Unexpected entry count in page %d", page);
+	zassert_equal(pages[page].len, PAGE_HDR_LEN + cnt * PAGE_ENTRY_LEN);
+}
+
+static void page_entry(int page, int idx, uint16_t *src, uint32_t *seq, bool *old_iv)
+{
+	const uint8_t *entry = &pages[page].data[PAGE_HDR_LEN + idx * PAGE_ENTRY_LEN];
+	uint16_t val = sys_get_le16(entry);
+
+	*src = val & BIT_MASK(15);
+	*old_iv = val >> 15;
+	*seq = sys_get_le24(&entry[2]);
+}
+
+struct stored_val {
+	const void *data;
+	size_t len;
+};
+
+static ssize_t val_read(void *cb_arg, void *data, size_t len)
+{
+	struct stored_val *val = cb_arg;
+
+	len = MIN(len, val->len);
+	memcpy(data, val->data, len);
+
+	return len;
+}
+
+static void load(const char *name, const void *data, size_t len)
+{
+	struct stored_val val = { .data = data, .len = len };
+
+	zassert_ok(settings_handler_bt_mesh_rpl.h_set(name, len, val_read, &val));
+}
+
+static void load_legacy(uint16_t src, uint32_t seq)
+{
+	struct rpl_val val = { .seq = seq };
+	char name[5];
+
+	snprintk(name, sizeof(name), "%x", src);
+	load(name, &val, sizeof(val));
+
+	for (int i = 0; i < ARRAY_SIZE(legacy); i++) {
+		if (!legacy[i].src) {
+			legacy[i].src = src;
+			legacy[i].val = val;
+			break;
+		}
+	}
+}
+
+/* Drop the RPL in RAM and load it again from the stored settings entries. */
+static void reboot(void)
+{
+	char name[5];
+
+	/* Clear the RPL without touching the storage. */
+	power_left = 0;
+	bt_mesh_rpl_clear();
+	bt_mesh_rpl_pending_store_all_nodes();
+	power_left = -1;
+
+	for (int page = 0; page < PAGE_COUNT; page++) {
+		if (pages[page].len) {
+			snprintk(name, sizeof(name), "p/%x", page);
+			load(name, pages[page].data, pages[page].len);
+		}
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(legacy); i++) {
+		if (legacy[i].src) {
+			snprintk(name, sizeof(name), "%x", legacy[i].src);
+			load(name, &legacy[i].val, sizeof(legacy[i].val));
+		}
+	}
+}
+
+static bool stored_in_page(uint16_t src, uint32_t seq)
+{
+	uint16_t entry_src;
+	uint32_t entry_seq;
+	bool old_iv;
+
+	for (int page = 0; page < PAGE_COUNT; page++) {
+		if (!pages[page].len) {
+			continue;
+		}
+
+		check_page(page, pages[page].data[1]);
+
+		for (int i = 0; i < pages[page].data[1]; i++) {
+			page_entry(page, i, &entry_src, &entry_seq, &old_iv);
+			if (entry_src == src && entry_seq == seq) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static bool stored_legacy(uint16_t src, uint32_t seq)
+{
+	for (int i = 0; i < ARRAY_SIZE(legacy); i++) {
+		if (legacy[i].src == src) {
+			return legacy[i].val.seq == seq;
+		}
+	}
+
+	return false;
+}
+
+static int legacy_count(void)
+{
+	int cnt = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(legacy); i++) {
+		if (legacy[i].src) {
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
+static void setup(void *f)
+{
+	atomic_set_bit(bt_mesh.flags, BT_MESH_INIT);
+	power_left = -1;
+
+	bt_mesh_rpl_clear();
+	bt_mesh_rpl_pending_store_all_nodes();
+
+	memset(pages, 0, sizeof(pages));
+	memset(legacy, 0, sizeof(legacy));
+	reset_counters();
+}
+
+/**** Mocked functions ****/
+
+void bt_mesh_settings_store_schedule(enum bt_mesh_settings_flag flag)
+{
+}
+
+void bt_mesh_settings_store_cancel(enum bt_mesh_settings_flag flag)
+{
+}
+
+static int page_from_name(const char *name)
+{
+	int page;
+
+	if (strncmp(name, PAGE_PREFIX, strlen(PAGE_PREFIX))) {
+		return -1;
+	}
+
+	page = strtol(name + strlen(PAGE_PREFIX), NULL, 16);
+
+	return page < PAGE_COUNT ? page : -1;
+}
+
+/* Index of the per-address entry, ARRAY_SIZE(legacy) if it isn't stored. */
+static int legacy_from_name(const char *name)
+{
+	uint16_t src;
+	int i;
+
+	if (strncmp(name, LEGACY_PREFIX, strlen(LEGACY_PREFIX)) ||
+	    page_from_name(name) >= 0) {
+		return -1;
+	}
+
+	src = strtol(name + strlen(LEGACY_PREFIX), NULL, 16);
+
+	for (i = 0; i < ARRAY_SIZE(legacy); i++) {
+		if (legacy[i].src == src) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static bool power_lost(void)
+{
+	if (power_left == 0) {
+		return true;
+	}
+
+	if (power_left > 0) {
+		power_left--;
+	}
+
+	return false;
+}
+
+int settings_save_one(const char *name, const void *value, size_t val_len)
+{
+	int page = page_from_name(name);
+
+	if (page < 0 || val_len > sizeof(pages[page].data)) {
+		unexpected_cnt++;
+		return -EINVAL;
+	}
+
+	if (power_lost()) {
+		return -EIO;
+	}
+
+	memcpy(pages[page].data, value, val_len);
+	pages[page].len = val_len;
+	save_cnt++;
+
+	return 0;
+}
+
+int settings_delete(const char *name)
+{
+	int page = page_from_name(name);
+	int idx = legacy_from_name(name);
+
+	if (page < 0 && idx < 0) {
+		unexpected_cnt++;
+		return -EINVAL;
+	}
+
+	if (power_lost()) {
+		return -EIO;
+	}
+
+	if (page >= 0) {
+		pages[page].len = 0;
+	} else if (idx < ARRAY_SIZE(legacy)) {
+		legacy[idx].src = 0;
+	}
+
+	delete_cnt++;
+
+	return 0;
+}
+
+int settings_name_steq(const char *name, const char *key, const char **next)
+{
+	size_t len = strlen(key);
+
+	*next = NULL;
+
+	if (strncmp(name, key, len)) {
+		return 0;
+	}
+
+	if (name[len] == '/') {
+		*next = &name[len + 1];
+		return 1;
+	}
+
+	return name[len] == '\0';
+}
+
+int bt_mesh_settings_set(settings_read_cb read_cb, void *cb_arg, void *out, size_t read_len)
+{
+	ssize_t len = read_cb(cb_arg, out, read_len);
+
+	return len == read_len ? 0 : -EINVAL;
+}
+
+/**** Tests ****/
+
+ZTEST_SUITE(bt_mesh_rpl_paged, NULL, NULL, setup, NULL, NULL);
+
+/** Test that all updated entries are stored with one settings write per page. */
+ZTEST(bt_mesh_rpl_paged, test_store_coalesced)
+{
+	const int cnt = 2 * PAGE_SIZE + PAGE_SIZE / 2;
+
+	add_entries(cnt);
+	zassert_equal(save_cnt, 0);
+
+	bt_mesh_rpl_pending_store_all_nodes();
+
+	zassert_equal(unexpected_cnt, 0);
+	zassert_equal(save_cnt, DIV_ROUND_UP(cnt, PAGE_SIZE));
+	zassert_equal(delete_cnt, 0);
+
+	for (int i = 0; i < cnt; i++) {
+		int page = i / PAGE_SIZE;
+		uint16_t src;
+		uint32_t seq;
+		bool old_iv;
+
+		check_page(page, MIN(PAGE_SIZE, cnt - page * PAGE_SIZE));
+
+		page_entry(page, i % PAGE_SIZE, &src, &seq, &old_iv);
+		zassert_equal(src, TEST_SRC + i);
+		zassert_equal(seq, i + 1);
+		zassert_false(old_iv);
+	}
+}
+
+/** Test that only the page holding an updated entry is written again. */
+ZTEST(bt_mesh_rpl_paged, test_store_dirty_page_only)
+{
+	const int idx = PAGE_SIZE + 1;
+	uint16_t src;
+	uint32_t seq;
+	bool old_iv;
+
+	add_entries(2 * PAGE_SIZE);
+	bt_mesh_rpl_pending_store_all_nodes();
+	reset_counters();
+
+	zassert_false(rpl_check(TEST_SRC + idx, 0x1000, false));
+	zassert_true(rpl_check(TEST_SRC + idx, 0x1000, false));
+
+	bt_mesh_rpl_pending_store_all_nodes();
+
+	zassert_equal(unexpected_cnt, 0);
+	zassert_equal(save_cnt, 1);
+	check_page(1, PAGE_SIZE);
+
+	page_entry(1, idx % PAGE_SIZE, &src, &seq, &old_iv);
+	zassert_equal(src, TEST_SRC + idx);
+	zassert_equal(seq, 0x1000);
+}
+
+/** Test that lookups find every entry of a full RPL, regardless of the address order. */
+ZTEST(bt_mesh_rpl_paged, test_lookup_full)
+{
+	for (int i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		zassert_false(rpl_check((i * 0x2f1) % 0x7ffe + 1, 10, false));
+	}
+
+	for (int i = 0; i < CONFIG_BT_MESH_CRPL; i++) {
+		uint16_t src = (i * 0x2f1) % 0x7ffe + 1;
+
+		zassert_true(rpl_check(src, 10, false), "Replay from 0x%04x accepted", src);
+		zassert_false(rpl_check(src, 11, false));
+	}
+
+	/* No room for a new source */
+	zassert_true(rpl_check(0x7fff, 1, false));
+
+	bt_mesh_rpl_pending_store_all_nodes();
+	zassert_equal(save_cnt, PAGE_COUNT);
+}
+
+/** Test that the pages are rewritten once the IV Index update removed entries. */
+ZTEST(bt_mesh_rpl_paged, test_iv_reset)
+{
+	const int cnt = 2 * PAGE_SIZE + PAGE_SIZE / 2;
+
+	for (int i = 0; i < cnt; i++) {
+		zassert_false(rpl_check(TEST_SRC + i, i + 1, i & 1));
+	}
+
+	bt_mesh_rpl_pending_store_all_nodes();
+	reset_counters();
+
+	/* Entries with old_iv set are removed, the others are compacted. */
+	bt_mesh_rpl_reset();
+	bt_mesh_rpl_pending_store_all_nodes();
+
+	zassert_equal(unexpected_cnt, 0);
+	zassert_equal(save_cnt, DIV_ROUND_UP(cnt / 2, PAGE_SIZE));
+	zassert_equal(delete_cnt, DIV_ROUND_UP(cnt, PAGE_SIZE) - save_cnt);
+
+	for (int i = 0; i < cnt; i++) {
+		if (i & 1) {
+			/* Removed entry, accepted again */
+			zassert_false(rpl_check(TEST_SRC + i, i + 1, false));
+		} else {
+			/* Kept entry, now for the previous IV Index */
+			zassert_true(rpl_check(TEST_SRC + i, i + 1, true));
+		}
+	}
+}
+
+/** Test that the RPL stays stored when the migration from per-address entries is interrupted. */
+ZTEST(bt_mesh_rpl_paged, test_migrate_interrupted)
+{
+	const int cnt = 2 * PAGE_SIZE + 2;
+	/* One write per page, then one delete per per-address entry. */
+	const int ops = DIV_ROUND_UP(cnt, PAGE_SIZE) + cnt;
+
+	for (int cut = 0; cut <= ops; cut++) {
+		setup(NULL);
+
+		for (int i = 0; i < cnt; i++) {
+			load_legacy(TEST_SRC + i, i + 1);
+		}
+
+		power_left = cut;
+		bt_mesh_rpl_pending_store_all_nodes();
+
+		zassert_equal(unexpected_cnt, 0);
+
+		for (int i = 0; i < cnt; i++) {
+			zassert_true(stored_in_page(TEST_SRC + i, i + 1) ||
+				     stored_legacy(TEST_SRC + i, i + 1),
+				     "Entry %d lost with power cut after %d operations", i, cut);
+		}
+
+		/* The migration completes after the next boot. */
+		reboot();
+		bt_mesh_rpl_pending_store_all_nodes();
+
+		zassert_equal(unexpected_cnt, 0);
+		zassert_equal(legacy_count(), 0, "Entries left with power cut after %d operations",
+			      cut);
+
+		for (int i = 0; i < cnt; i++) {
+			zassert_true(stored_in_page(TEST_SRC + i, i + 1));
+			zassert_true(rpl_check(TEST_SRC + i, i + 1, false));
+			zassert_false(rpl_check(TEST_SRC + i, i + 2, false));
+		}
+	}
+}
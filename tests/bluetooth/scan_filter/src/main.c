@@ -0,0 +1,441 @@
+/* main.c - Host scan filter test */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <errno.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/buf.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/drivers/bluetooth.h>
+#include <zephyr/sys/byteorder.h>
+
+#define DT_DRV_COMPAT zephyr_bt_hci_test
+
+#define TEST_COMPANY_ID 0x0059
+
+struct driver_data {
+	bt_hci_recv_t recv;
+};
+
+/* Command handler structure for cmd_handle(). */
+struct cmd_handler {
+	uint16_t opcode; /* HCI command opcode */
+	uint8_t len;     /* HCI command response length */
+	void (*handler)(struct net_buf **evt, uint8_t len, uint16_t opcode);
+};
+
+static const bt_addr_le_t addr_a = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a.val = { 0x01, 0x00, 0x00, 0x00, 0x00, 0xa0 },
+};
+
+static const bt_addr_le_t addr_b = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a.val = { 0x02, 0x00, 0x00, 0x00, 0x00, 0xb0 },
+};
+
+/* Add event to net_buf. */
+static void evt_create(struct net_buf *buf, uint8_t evt, uint8_t len)
+{
+	struct bt_hci_evt_hdr *hdr;
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->evt = evt;
+	hdr->len = len;
+}
+
+/* Create a command complete event. */
+static void *cmd_complete(struct net_buf **buf, uint8_t plen, uint16_t opcode)
+{
+	struct bt_hci_evt_cmd_complete *cc;
+
+	*buf = bt_buf_get_evt(BT_HCI_EVT_CMD_COMPLETE, false, K_FOREVER);
+	evt_create(*buf, BT_HCI_EVT_CMD_COMPLETE, sizeof(*cc) + plen);
+	cc = net_buf_add(*buf, sizeof(*cc));
+	cc->ncmd = 1U;
+	cc->opcode = sys_cpu_to_le16(opcode);
+	return net_buf_add(*buf, plen);
+}
+
+/* Generic command complete with success status. */
+static void generic_success(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_evt_cc_status *ccst;
+
+	ccst = cmd_complete(evt, len, opcode);
+
+	/* Fill any event parameters with zero */
+	(void)memset(ccst, 0, len);
+
+	ccst->status = BT_HCI_ERR_SUCCESS;
+}
+
+/* Bogus handler for BT_HCI_OP_READ_LOCAL_FEATURES. */
+static void read_local_features(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_rp_read_local_features *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	rp->status = 0x00;
+	(void)memset(&rp->features[0], 0xFF, sizeof(rp->features));
+}
+
+/* Bogus handler for BT_HCI_OP_READ_SUPPORTED_COMMANDS. */
+static void read_supported_commands(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_rp_read_supported_commands *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	(void)memset(&rp->commands[0], 0xFF, sizeof(rp->commands));
+	rp->status = 0x00;
+}
+
+/* Bogus handler for BT_HCI_OP_LE_READ_SUPP_STATES. */
+static void le_read_supp_states(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_rp_le_read_supp_states *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	rp->status = 0x00;
+	(void)memset(&rp->le_states, 0xFF, sizeof(rp->le_states));
+}
+
+/* Setup handlers needed for bt_enable and scanning to function. The LE
+ * features are left zero so that legacy scanning commands are used.
+ */
+static const struct cmd_handler cmds[] = {
+	{ BT_HCI_OP_READ_LOCAL_VERSION_INFO,
+	  sizeof(struct bt_hci_rp_read_local_version_info),
+	  generic_success },
+	{ BT_HCI_OP_READ_SUPPORTED_COMMANDS,
+	  sizeof(struct bt_hci_rp_read_supported_commands),
+	  read_supported_commands },
+	{ BT_HCI_OP_READ_LOCAL_FEATURES,
+	  sizeof(struct bt_hci_rp_read_local_features),
+	  read_local_features },
+	{ BT_HCI_OP_READ_BD_ADDR,
+	  sizeof(struct bt_hci_rp_read_bd_addr),
+	  generic_success },
+	{ BT_HCI_OP_SET_EVENT_MASK,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_EVENT_MASK,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+	{ BT_HCI_OP_LE_READ_LOCAL_FEATURES,
+	  sizeof(struct bt_hci_rp_le_read_local_features),
+	  generic_success },
+	{ BT_HCI_OP_LE_READ_SUPP_STATES,
+	  sizeof(struct bt_hci_rp_le_read_supp_states),
+	  le_read_supp_states },
+	{ BT_HCI_OP_LE_RAND,
+	  sizeof(struct bt_hci_rp_le_rand),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_RANDOM_ADDRESS,
+	  sizeof(struct bt_hci_cp_le_set_random_address),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_SCAN_PARAM,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_SCAN_ENABLE,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+};
+
+/* Lookup the command opcode and send the response. */
+static void cmd_handle(const struct device *dev, uint16_t opcode)
+{
+	struct driver_data *drv = dev->data;
+	struct net_buf *evt = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		if (cmds[i].opcode == opcode) {
+			cmds[i].handler(&evt, cmds[i].len, opcode);
+			drv->recv(dev, evt);
+			return;
+		}
+	}
+
+	struct bt_hci_evt_cc_status *ccst;
+
+	ccst = cmd_complete(&evt, sizeof(*ccst), opcode);
+	ccst->status = BT_HCI_ERR_UNKNOWN_CMD;
+	drv->recv(dev, evt);
+}
+
+/* HCI driver open. */
+static int driver_open(const struct device *dev, bt_hci_recv_t recv)
+{
+	struct driver_data *drv = dev->data;
+
+	drv->recv = recv;
+
+	return 0;
+}
+
+/*  HCI driver send.  */
+static int driver_send(const struct device *dev, struct net_buf *buf)
+{
+	struct bt_hci_cmd_hdr *chdr;
+	uint8_t type = net_buf_pull_u8(buf);
+
+	zassert_true(type == BT_HCI_H4_CMD, "Expected command buffer, got %u", type);
+
+	chdr = net_buf_pull_mem(buf, sizeof(*chdr));
+	cmd_handle(dev, sys_le16_to_cpu(chdr->opcode));
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+static DEVICE_API(bt_hci, driver_api) = {
+	.open = driver_open,
+	.send = driver_send,
+};
+
+#define TEST_DEVICE_INIT(inst) \
+	static struct driver_data driver_data_##inst = { \
+	}; \
+	DEVICE_DT_INST_DEFINE(inst, NULL, NULL, &driver_data_##inst, NULL, \
+			      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &driver_api)
+
+DT_INST_FOREACH_STATUS_OKAY(TEST_DEVICE_INIT)
+
+/* Send a legacy advertising report from addr with the given data. */
+static void send_adv_report(const bt_addr_le_t *addr, const uint8_t *data, uint8_t data_len)
+{
+	const struct device *dev = DEVICE_DT_GET(DT_DRV_INST(0));
+	struct driver_data *drv = dev->data;
+	struct bt_hci_evt_le_advertising_report *rep;
+	struct bt_hci_evt_le_advertising_info *info;
+	struct bt_hci_evt_le_meta_event *meta;
+	struct net_buf *buf;
+
+	buf = bt_buf_get_evt(BT_HCI_EVT_LE_META_EVENT, true, K_FOREVER);
+	evt_create(buf, BT_HCI_EVT_LE_META_EVENT,
+		   sizeof(*meta) + sizeof(*rep) + sizeof(*info) + data_len + 1);
+
+	meta = net_buf_add(buf, sizeof(*meta));
+	meta->subevent = BT_HCI_EVT_LE_ADVERTISING_REPORT;
+
+	rep = net_buf_add(buf, sizeof(*rep));
+	rep->num_reports = 1U;
+
+	info = net_buf_add(buf, sizeof(*info));
+	info->evt_type = BT_HCI_ADV_NONCONN_IND;
+	bt_addr_le_copy(&info->addr, addr);
+	info->length = data_len;
+	if (data_len > 0U) {
+		net_buf_add_mem(buf, data, data_len);
+	}
+
+	/* RSSI */
+	net_buf_add_u8(buf, (uint8_t)-50);
+
+	drv->recv(dev, buf);
+}
+
+static K_SEM_DEFINE(unfiltered_sem, 0, 1);
+static size_t filtered_count;
+static size_t scan_start_count;
+
+static void filtered_recv(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf)
+{
+	filtered_count++;
+}
+
+static void unfiltered_recv(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf)
+{
+	k_sem_give(&unfiltered_sem);
+}
+
+/* Registered first, so called before the unfiltered one for each report */
+static struct bt_le_scan_cb filtered_cb = {
+	.recv = filtered_recv,
+	.filtered = true,
+};
+
+static struct bt_le_scan_cb unfiltered_cb = {
+	.recv = unfiltered_recv,
+};
+
+static void scan_start_cb(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			  struct net_buf_simple *ad)
+{
+	scan_start_count++;
+}
+
+/* Return true if the report reached the filtered listener. All listeners
+ * are expected to have seen it otherwise.
+ */
+static bool report(const bt_addr_le_t *addr, const uint8_t *data, uint8_t data_len)
+{
+	size_t filtered = filtered_count;
+	size_t scan_start = scan_start_count;
+
+	send_adv_report(addr, data, data_len);
+	zassert_ok(k_sem_take(&unfiltered_sem, K_MSEC(100)), "Report not received");
+	zassert_equal(scan_start_count, scan_start + 1, "Scan start callback not called");
+
+	return filtered_count != filtered;
+}
+
+static void scan_start(void)
+{
+	zassert_ok(bt_le_scan_start(BT_LE_SCAN_PASSIVE, scan_start_cb));
+}
+
+static void *setup(void)
+{
+	zassert_ok(bt_enable(NULL), "bt_enable failed");
+
+	bt_le_scan_cb_register(&filtered_cb);
+	bt_le_scan_cb_register(&unfiltered_cb);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	zassert_ok(bt_le_scan_filter_clear());
+	k_sem_reset(&unfiltered_sem);
+}
+
+static void after(void *fixture)
+{
+	(void)bt_le_scan_stop();
+}
+
+ZTEST_SUITE(test_scan_filter, NULL, setup, before, after, NULL);
+
+/* Without filters the filtered listener sees every report. */
+ZTEST(test_scan_filter, test_no_filter)
+{
+	scan_start();
+
+	zassert_true(report(&addr_a, NULL, 0));
+	zassert_true(report(&addr_b, NULL, 0));
+}
+
+ZTEST(test_scan_filter, test_addr)
+{
+	struct bt_le_scan_filter filter = {
+		.type = BT_LE_SCAN_FILTER_ADDR,
+	};
+
+	bt_addr_le_copy(&filter.addr, &addr_a);
+	zassert_ok(bt_le_scan_filter_add(&filter));
+	scan_start();
+
+	zassert_true(report(&addr_a, NULL, 0));
+	zassert_false(report(&addr_b, NULL, 0));
+}
+
+ZTEST(test_scan_filter, test_ad)
+{
+	static const struct bt_uuid_16 uuid = BT_UUID_INIT_16(0x180d);
+	const struct bt_le_scan_filter filters[] = {
+		{ .type = BT_LE_SCAN_FILTER_NAME_PREFIX, .name_prefix = "Zeph" },
+		{ .type = BT_LE_SCAN_FILTER_UUID, .uuid = &uuid.uuid },
+		{ .type = BT_LE_SCAN_FILTER_MANUFACTURER_ID, .company_id = TEST_COMPANY_ID },
+		{ .type = BT_LE_SCAN_FILTER_AD_TYPE, .ad_type = BT_DATA_TX_POWER },
+	};
+	const uint8_t flags[] = { 2, BT_DATA_FLAGS, BT_LE_AD_NO_BREDR };
+	const uint8_t name[] = { 2, BT_DATA_FLAGS, BT_LE_AD_NO_BREDR,
+				 7, BT_DATA_NAME_COMPLETE, 'Z', 'e', 'p', 'h', 'y', 'r' };
+	const uint8_t other_name[] = { 5, BT_DATA_NAME_COMPLETE, 'Z', 'e', 'n', 'o' };
+	const uint8_t short_name[] = { 4, BT_DATA_NAME_SHORTENED, 'Z', 'e', 'p' };
+	const uint8_t uuids[] = { 5, BT_DATA_UUID16_ALL, 0x0f, 0x18, 0x0d, 0x18 };
+	const uint8_t other_uuids[] = { 3, BT_DATA_UUID16_SOME, 0x0f, 0x18 };
+	const uint8_t manuf[] = { 4, BT_DATA_MANUFACTURER_DATA,
+				  BT_BYTES_LIST_LE16(TEST_COMPANY_ID), 0xff };
+	const uint8_t other_manuf[] = { 3, BT_DATA_MANUFACTURER_DATA, 0x00, 0x00 };
+	const uint8_t tx_power[] = { 2, BT_DATA_TX_POWER, 0x00 };
+	const uint8_t malformed[] = { 8, BT_DATA_TX_POWER, 0x00 };
+
+	ARRAY_FOR_EACH_PTR(filters, filter) {
+		zassert_ok(bt_le_scan_filter_add(filter));
+	}
+
+	scan_start();
+
+	zassert_false(report(&addr_a, NULL, 0));
+	zassert_false(report(&addr_a, flags, sizeof(flags)));
+	zassert_true(report(&addr_a, name, sizeof(name)));
+	zassert_false(report(&addr_a, other_name, sizeof(other_name)));
+	zassert_false(report(&addr_a, short_name, sizeof(short_name)));
+	zassert_true(report(&addr_a, uuids, sizeof(uuids)));
+	zassert_false(report(&addr_a, other_uuids, sizeof(other_uuids)));
+	zassert_true(report(&addr_a, manuf, sizeof(manuf)));
+	zassert_false(report(&addr_a, other_manuf, sizeof(other_manuf)));
+	zassert_true(report(&addr_a, tx_power, sizeof(tx_power)));
+	zassert_false(report(&addr_a, malformed, sizeof(malformed)));
+}
+
+ZTEST(test_scan_filter, test_reject)
+{
+	struct bt_le_scan_filter filter = {
+		.type = BT_LE_SCAN_FILTER_AD_TYPE,
+		.ad_type = BT_DATA_FLAGS,
+	};
+	const struct bt_le_scan_filter no_prefix = {
+		.type = BT_LE_SCAN_FILTER_NAME_PREFIX,
+	};
+	const struct bt_le_scan_filter no_uuid = {
+		.type = BT_LE_SCAN_FILTER_UUID,
+	};
+	const struct bt_le_scan_filter bad_type = {
+		.type = BT_LE_SCAN_FILTER_MANUFACTURER_ID + 1,
+	};
+
+	zassert_equal(bt_le_scan_filter_add(NULL), -EINVAL);
+	zassert_equal(bt_le_scan_filter_add(&no_prefix), -EINVAL);
+	zassert_equal(bt_le_scan_filter_add(&no_uuid), -EINVAL);
+	zassert_equal(bt_le_scan_filter_add(&bad_type), -EINVAL);
+
+	for (size_t i = 0; i < CONFIG_BT_SCAN_FILTER_MAX; i++) {
+		zassert_ok(bt_le_scan_filter_add(&filter));
+	}
+
+	zassert_equal(bt_le_scan_filter_add(&filter), -ENOMEM);
+
+	/* No change while the scanner is in use */
+	scan_start();
+	zassert_equal(bt_le_scan_filter_clear(), -EBUSY);
+	zassert_ok(bt_le_scan_stop());
+	zassert_ok(bt_le_scan_filter_clear());
+
+	scan_start();
+	zassert_equal(bt_le_scan_filter_add(&filter), -EBUSY);
+	zassert_true(report(&addr_a, NULL, 0));
+}
+
+/* Clearing the filters passes every report again. */
+ZTEST(test_scan_filter, test_clear)
+{
+	struct bt_le_scan_filter filter = {
+		.type = BT_LE_SCAN_FILTER_ADDR,
+	};
+
+	bt_addr_le_copy(&filter.addr, &addr_a);
+	zassert_ok(bt_le_scan_filter_add(&filter));
+
+	scan_start();
+	zassert_false(report(&addr_b, NULL, 0));
+	zassert_ok(bt_le_scan_stop());
+
+	zassert_ok(bt_le_scan_filter_clear());
+
+	scan_start();
+	zassert_true(report(&addr_b, NULL, 0));
+}
@@ -237,6 +237,50 @@ static void connect_restore_sec_check_subscribtion(struct bt_le_ext_adv *adv)
 
 /* Util functions */
 
+struct ccc_stored {
+	uint16_t handle;
+	uint16_t value;
+};
+
+static int ccc_stored_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+			 void *param)
+{
+	struct ccc_stored entries[CONFIG_BT_SETTINGS_CCC_STORE_MAX];
+	uint16_t *value = param;
+	ssize_t read;
+
+	read = read_cb(cb_arg, entries, sizeof(entries));
+	if (read < 0) {
+		TEST_FAIL("Failed to read CCC settings (err %zd)", read);
+	}
+
+	for (size_t i = 0; i < read / sizeof(entries[0]); i++) {
+		if (entries[i].handle == CCC_HANDLE) {
+			*value = entries[i].value;
+		}
+	}
+
+	return 0;
+}
+
+static void check_ccc_stored(void)
+{
+	uint16_t value = 0;
+	int err;
+
+	/* Stored values are written by the delayed store work */
+	k_sleep(K_MSEC(CONFIG_BT_SETTINGS_DELAYED_STORE_MS + 100));
+
+	err = settings_load_subtree_direct("bt/ccc", ccc_stored_cb, &value);
+	if (err) {
+		TEST_FAIL("Failed to load CCC settings (err %d)", err);
+	}
+
+	if (value != BT_GATT_CCC_NOTIFY) {
+		TEST_FAIL("CCC not stored after disconnection (value 0x%04x)", value);
+	}
+}
+
 static void check_ccc_handle(void)
 {
 	struct bt_gatt_attr *service_notify_attr =
@@ -293,10 +337,12 @@ void run_peripheral(int times)
 
 	connect_pair_check_subscribtion(adv);
 	WAIT_FOR_FLAG(disconnected_flag);
+	check_ccc_stored();
 
 	for (int i = 0; i < times; i++) {
 		connect_restore_sec_check_subscribtion(adv);
 		WAIT_FOR_FLAG(disconnected_flag);
+		check_ccc_stored();
 	}
 
 	TEST_PASS("Peripheral test passed");
@@ -24,7 +24,7 @@ if [ "${1}" != 'debug1' ]; then
 fi
 
 Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
-  -D=2 -sim_length=60e6
+  -D=2 -sim_length=120e6
 
 if [ "${1}" == 'debug0' ]; then
   gdb --args "./${test_exe}" \
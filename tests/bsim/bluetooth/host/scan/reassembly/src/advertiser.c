@@ -0,0 +1,70 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/logging/log.h>
+
+#include "argparse.h"
+#include "babblekit/testcase.h"
+
+#include "common.h"
+
+LOG_MODULE_REGISTER(advertiser, LOG_LEVEL_INF);
+
+static uint8_t mfg_data[AD_DATA_LEN];
+
+void entrypoint_advertiser(void)
+{
+	/* Test purpose:
+	 *
+	 * Verifies that the host reassembles the fragmented advertising reports of several
+	 * advertisers when they are interleaved.
+	 *
+	 * Devices:
+	 * - `scanner`: scans continuously without duplicate filtering
+	 * - `advertiser` (ADV_CNT instances): advertise long chained advertising data
+	 *   filled with their device number, using the shortest advertising interval so that
+	 *   the chains of the different advertisers overlap.
+	 *
+	 * [verdict]
+	 * - the scanner receives REPORT_CNT complete and intact reports from every advertiser
+	 * - the reassembly statistics account for all the reports
+	 */
+	struct bt_le_adv_param param = BT_LE_ADV_PARAM_INIT(
+		BT_LE_ADV_OPT_EXT_ADV, BT_GAP_ADV_FAST_INT_MIN_1, BT_GAP_ADV_FAST_INT_MIN_1, NULL);
+	struct bt_data ad[AD_CNT];
+	struct bt_le_ext_adv *adv;
+	int err;
+
+	TEST_START("advertiser");
+
+	memset(mfg_data, get_device_nbr(), sizeof(mfg_data));
+
+	for (size_t i = 0; i < ARRAY_SIZE(ad); i++) {
+		ad[i].type = BT_DATA_MANUFACTURER_DATA;
+		ad[i].data_len = sizeof(mfg_data);
+		ad[i].data = mfg_data;
+	}
+
+	err = bt_enable(NULL);
+	TEST_ASSERT(err == 0, "Can't enable Bluetooth (err %d)", err);
+
+	err = bt_le_ext_adv_create(&param, NULL, &adv);
+	TEST_ASSERT(err == 0, "Failed to create advertiser (err %d)", err);
+
+	err = bt_le_ext_adv_set_data(adv, ad, ARRAY_SIZE(ad), NULL, 0);
+	TEST_ASSERT(err == 0, "Failed to set advertising data (err %d)", err);
+
+	err = bt_le_ext_adv_start(adv, BT_LE_EXT_ADV_START_DEFAULT);
+	TEST_ASSERT(err == 0, "Failed to start advertiser (err %d)", err);
+
+	LOG_DBG("Advertiser %u started", get_device_nbr());
+
+	TEST_PASS("advertiser");
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/bluetooth/bluetooth.h>
+
+/* Number of advertisers, using device numbers 1 to ADV_CNT */
+#define ADV_CNT       4
+/* Number of complete reports to receive from each advertiser */
+#define REPORT_CNT    10
+/* Each advertiser fills its manufacturer data with its device number */
+#define AD_CNT        3
+#define AD_DATA_LEN   198
+#define ADV_DATA_LEN  (AD_CNT * (2 + AD_DATA_LEN))
+
+BUILD_ASSERT(ADV_DATA_LEN <= CONFIG_BT_EXT_SCAN_BUF_SIZE);
@@ -0,0 +1,128 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/logging/log.h>
+
+#include "babblekit/flags.h"
+#include "babblekit/testcase.h"
+
+#include "common.h"
+
+LOG_MODULE_REGISTER(scanner, LOG_LEVEL_INF);
+
+DEFINE_FLAG(all_received);
+
+static uint32_t report_cnt[ADV_CNT + 1];
+static uint32_t total_cnt;
+
+/* Returns the device number filling the manufacturer data, or 0 if the data is corrupted */
+static uint8_t check_ad(const struct net_buf_simple *ad)
+{
+	uint8_t nbr;
+
+	if (ad->len != ADV_DATA_LEN) {
+		return 0;
+	}
+
+	nbr = ad->data[2];
+
+	for (size_t i = 0; i < AD_CNT; i++) {
+		const uint8_t *data = &ad->data[i * (2 + AD_DATA_LEN)];
+
+		if (data[0] != AD_DATA_LEN + 1 || data[1] != BT_DATA_MANUFACTURER_DATA) {
+			return 0;
+		}
+
+		for (size_t j = 0; j < AD_DATA_LEN; j++) {
+			if (data[2 + j] != nbr) {
+				return 0;
+			}
+		}
+	}
+
+	return nbr;
+}
+
+static void scan_recv(const struct bt_le_scan_recv_info *info, struct net_buf_simple *ad)
+{
+	uint8_t nbr;
+
+	if (!(info->adv_props & BT_GAP_ADV_PROP_EXT_ADV)) {
+		return;
+	}
+
+	nbr = check_ad(ad);
+	if (nbr == 0U || nbr > ADV_CNT) {
+		LOG_HEXDUMP_ERR(ad->data, ad->len, "Received AD:");
+		TEST_FAIL("Received corrupted advertising data of %u bytes", ad->len);
+		return;
+	}
+
+	report_cnt[nbr]++;
+	total_cnt++;
+
+	for (size_t i = 1; i <= ADV_CNT; i++) {
+		if (report_cnt[i] < REPORT_CNT) {
+			return;
+		}
+	}
+
+	SET_FLAG(all_received);
+}
+
+static struct bt_le_scan_cb scan_cb = {
+	.recv = scan_recv,
+};
+
+void entrypoint_scanner(void)
+{
+	/* See entrypoint_advertiser() for the test description */
+	struct bt_le_scan_param param = BT_LE_SCAN_PARAM_INIT(
+		BT_LE_SCAN_TYPE_PASSIVE, BT_LE_SCAN_OPT_NONE, BT_GAP_SCAN_FAST_INTERVAL,
+		BT_GAP_SCAN_FAST_INTERVAL);
+	struct bt_le_scan_reassembly_stats stats;
+	int err;
+
+	TEST_START("scanner");
+
+	err = bt_enable(NULL);
+	TEST_ASSERT(err == 0, "Can't enable Bluetooth (err %d)", err);
+
+	err = bt_le_scan_reassembly_stats_get(NULL);
+	TEST_ASSERT(err == -EINVAL, "NULL reassembly stats not rejected (err %d)", err);
+
+	err = bt_le_scan_reassembly_stats_get(&stats);
+	TEST_ASSERT(err == 0, "Failed to get reassembly stats (err %d)", err);
+	TEST_ASSERT(stats.completed == 0U && stats.discarded == 0U,
+		    "Reassembly stats not cleared at enable");
+
+	err = bt_le_scan_cb_register(&scan_cb);
+	TEST_ASSERT(err == 0, "Failed to register scan callbacks (err %d)", err);
+
+	err = bt_le_scan_start(&param, NULL);
+	TEST_ASSERT(err == 0, "Scanning failed to start (err %d)", err);
+
+	WAIT_FOR_FLAG(all_received);
+
+	err = bt_le_scan_stop();
+	TEST_ASSERT(err == 0, "Scanning failed to stop (err %d)", err);
+
+	err = bt_le_scan_reassembly_stats_get(&stats);
+	TEST_ASSERT(err == 0, "Failed to get reassembly stats (err %d)", err);
+
+	LOG_INF("Reports %u, reassemblies completed %u discarded %u", total_cnt, stats.completed,
+		stats.discarded);
+
+	TEST_ASSERT(stats.completed == total_cnt, "%u reassemblies completed, %u reports",
+		    stats.completed, total_cnt);
+
+	TEST_PASS_AND_EXIT("scanner");
+}
@@ -5,6 +5,7 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 
 #include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/printk.h>
@@ -13,6 +14,7 @@
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/hci.h>
 #include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/bluetooth/hci_vs.h>
 #include <zephyr/bluetooth/iso.h>
 
 #include "subsys/bluetooth/host/hci_core.h"
@@ -56,6 +58,25 @@ static const struct bt_data per_ad_data2[] = {
 
 static uint8_t chan_map[] = { 0x1F, 0XF1, 0x1F, 0xF1, 0x1F };
 
+#if defined(CONFIG_TEST_ISO_ENCRYPTION)
+static const uint8_t broadcast_code[BT_ISO_BROADCAST_CODE_SIZE] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+};
+#endif /* CONFIG_TEST_ISO_ENCRYPTION */
+
+#if defined(CONFIG_TEST_ISO_ANOMALY)
+/* Set on the device that clones the broadcaster with a different payload */
+static bool is_injector;
+/* Set on the receiver when an injector is part of the simulation */
+static bool is_inject_expected;
+/* SDUs received with the broadcaster and with the injector payload */
+static uint32_t sdu_genuine_count;
+static uint32_t sdu_injected_count;
+/* ISO interval of the BIG, in units of 1.25 ms */
+static uint16_t big_iso_interval;
+#endif /* CONFIG_TEST_ISO_ANOMALY */
+
 static bool volatile is_iso_connected;
 static uint8_t volatile is_iso_disconnected;
 static bool volatile deleting_pa_sync;
@@ -178,6 +199,12 @@ static void iso_send(struct k_work *work)
 
 		for (size_t i = 0; i < ARRAY_SIZE(iso_data); i++) {
 			iso_data[i] = (uint8_t)i;
+
+#if defined(CONFIG_TEST_ISO_ANOMALY)
+			if (is_injector) {
+				iso_data[i] = ~iso_data[i];
+			}
+#endif /* CONFIG_TEST_ISO_ANOMALY */
 		}
 	}
 
@@ -345,7 +372,12 @@ static void create_big(struct bt_le_ext_adv *adv, struct bt_iso_big **big)
 	printk("Creating BIG...\n");
 	big_create_param.bis_channels = bis_channels;
 	big_create_param.num_bis = BIS_ISO_CHAN_COUNT;
+#if defined(CONFIG_TEST_ISO_ENCRYPTION)
+	big_create_param.encryption = true;
+	(void)memcpy(big_create_param.bcode, broadcast_code, sizeof(big_create_param.bcode));
+#else /* !CONFIG_TEST_ISO_ENCRYPTION */
 	big_create_param.encryption = false;
+#endif /* !CONFIG_TEST_ISO_ENCRYPTION */
 	big_create_param.interval = 10000; /* us */
 	big_create_param.latency = 10; /* milliseconds */
 	big_create_param.packing = (IS_ENABLED(CONFIG_TEST_ISO_PACKING_INTERLEAVED) ?
@@ -524,6 +556,15 @@ static void test_iso_main(void)
 	PASS("ISO tests Passed\n");
 }
 
+#if defined(CONFIG_TEST_ISO_ANOMALY)
+static void test_iso_inject_main(void)
+{
+	is_injector = true;
+
+	test_iso_main();
+}
+#endif /* CONFIG_TEST_ISO_ANOMALY */
+
 static const char *phy2str(uint8_t phy)
 {
 	switch (phy) {
@@ -590,6 +631,18 @@ static void iso_recv(struct bt_iso_chan *chan,
 	iso_print_data(buf->data, buf->len);
 
 	seq_num = sys_get_le16(buf->data);
+
+#if defined(CONFIG_TEST_ISO_ANOMALY)
+	/* The octets after the sequence number tell which device sent the SDU */
+	if ((info->flags & BT_ISO_FLAGS_VALID) && (buf->len > sizeof(seq_num))) {
+		if (buf->data[sizeof(seq_num)] == (uint8_t)~sizeof(seq_num)) {
+			sdu_injected_count++;
+		} else {
+			sdu_genuine_count++;
+		}
+	}
+#endif /* CONFIG_TEST_ISO_ANOMALY */
+
 	if (info->flags & BT_ISO_FLAGS_VALID) {
 		if (seq_num != expected_seq_num[index]) {
 			if (expected_seq_num[index]) {
@@ -732,6 +785,10 @@ static void pa_biginfo_cb(struct bt_le_per_adv_sync *sync,
 	       biginfo->framing ? "with" : "without",
 	       biginfo->encryption ? "" : "not ");
 
+#if defined(CONFIG_TEST_ISO_ANOMALY)
+	big_iso_interval = biginfo->iso_interval;
+#endif /* CONFIG_TEST_ISO_ANOMALY */
+
 	if (!is_big_info) {
 		is_big_info = true;
 	}
@@ -963,9 +1020,14 @@ static void test_iso_recv_main(void)
 	big_param.bis_bitfield = BT_ISO_BIS_INDEX_BIT(1); /* BIS 1 selected */
 	big_param.mse = 1;
 	big_param.sync_timeout = 100; /* 1000 ms */
-	big_param.encryption = false;
 	hci_path.pid = BT_HCI_DATAPATH_ID_HCI;
+#if defined(CONFIG_TEST_ISO_ENCRYPTION)
+	big_param.encryption = true;
+	(void)memcpy(big_param.bcode, broadcast_code, sizeof(big_param.bcode));
+#else /* !CONFIG_TEST_ISO_ENCRYPTION */
+	big_param.encryption = false;
 	memset(big_param.bcode, 0, sizeof(big_param.bcode));
+#endif /* !CONFIG_TEST_ISO_ENCRYPTION */
 	err = bt_iso_big_sync(sync, &big_param, &big);
 	if (err) {
 		FAIL("Could not create BIG sync: %d\n", err);
@@ -1240,6 +1302,209 @@ static void test_iso_recv_vs_dp_main(void)
 }
 #endif /* CONFIG_BT_CTLR_ISO_VENDOR_DATA_PATH */
 
+#if defined(CONFIG_TEST_ISO_ANOMALY)
+/* Minimum share of the ISO events in which a PDU shall be received, in % */
+#define ANOMALY_RX_EVENTS_MIN_PCT 90U
+
+static void read_anomaly_counters(uint16_t handle, uint32_t elapsed_ms)
+{
+	struct bt_hci_cp_vs_read_bis_anomaly_counters *cp;
+	struct bt_hci_rp_vs_read_bis_anomaly_counters *rp;
+	uint32_t ctrl_unexpected;
+	uint32_t timing_outliers;
+	uint32_t rssi_outliers;
+	uint32_t duplicates;
+	uint32_t unexpected;
+	uint32_t anomalies;
+	uint32_t rx_packets;
+	uint32_t events;
+	struct net_buf *buf;
+	struct net_buf *rsp;
+	int err;
+
+	buf = bt_hci_cmd_alloc(K_FOREVER);
+	cp = net_buf_add(buf, sizeof(*cp));
+	cp->handle = sys_cpu_to_le16(handle);
+
+	err = bt_hci_cmd_send_sync(BT_HCI_OP_VS_READ_BIS_ANOMALY_COUNTERS, buf, &rsp);
+	if (err) {
+		FAIL("Read BIS Anomaly Counters failed (err %d)\n", err);
+		return;
+	}
+
+	rp = (void *)rsp->data;
+	rx_packets = sys_le32_to_cpu(rp->rx_packets);
+	rssi_outliers = sys_le32_to_cpu(rp->rssi_outliers);
+	timing_outliers = sys_le32_to_cpu(rp->timing_outliers);
+	duplicates = sys_le32_to_cpu(rp->duplicate_mismatches);
+	unexpected = sys_le32_to_cpu(rp->unexpected_packets);
+	ctrl_unexpected = sys_le32_to_cpu(rp->ctrl_unexpected_packets);
+
+	printk("BIS 0x%04x: rx %u, RSSI %u, timing %u, duplicate %u, unexpected %u, "
+	       "control unexpected %u, RSSI avg %d dBm\n", handle, rx_packets,
+	       rssi_outliers, timing_outliers, duplicates, unexpected, ctrl_unexpected,
+	       rp->rssi_avg);
+	printk("SDUs: genuine %u, injected %u\n", sdu_genuine_count, sdu_injected_count);
+
+	net_buf_unref(rsp);
+
+	/* At least one PDU of the BIS is received in nearly every ISO event */
+	events = (elapsed_ms * 4U) / (big_iso_interval * 5U);
+	if ((rx_packets * 100U) < (events * ANOMALY_RX_EVENTS_MIN_PCT)) {
+		FAIL("Received %u PDUs in %u ISO events.\n", rx_packets, events);
+		return;
+	}
+
+	anomalies = rssi_outliers + timing_outliers + duplicates + unexpected +
+		    ctrl_unexpected;
+
+	if (!is_inject_expected) {
+		/* A lone broadcaster on an ideal channel, no false positive */
+		if (anomalies) {
+			FAIL("%u anomalies without an injector.\n", anomalies);
+		}
+
+		if (sdu_injected_count) {
+			FAIL("%u injected SDUs without an injector.\n", sdu_injected_count);
+		}
+
+		return;
+	}
+
+	printk("Detection rate: %u anomalies per 1000 PDUs, %u injected SDUs per 1000 SDUs\n",
+	       (uint32_t)((uint64_t)anomalies * 1000U / rx_packets),
+	       (uint32_t)((uint64_t)sdu_injected_count * 1000U /
+			  MAX(sdu_genuine_count + sdu_injected_count, 1U)));
+
+	if (!sdu_injected_count && !anomalies) {
+		FAIL("Injector not received, check the simulation setup.\n");
+		return;
+	}
+
+	/* Each SDU from the injector that reached the Host was received in place
+	 * of the broadcaster PDU and shall have been counted as an anomaly.
+	 */
+	if (anomalies < sdu_injected_count) {
+		FAIL("%u anomalies for %u injected SDUs.\n", anomalies,
+		     sdu_injected_count);
+	}
+}
+
+static void test_iso_recv_anomaly_args(int argc, char *argv[])
+{
+	for (int argn = 0; argn < argc; argn++) {
+		if (strcmp(argv[argn], "inject") == 0) {
+			is_inject_expected = true;
+		} else {
+			FAIL("Unknown argument %s\n", argv[argn]);
+		}
+	}
+}
+
+static void test_iso_recv_anomaly_main(void)
+{
+	struct bt_le_scan_param scan_param = {
+		.type       = BT_LE_SCAN_TYPE_ACTIVE,
+		.options    = BT_LE_SCAN_OPT_NONE,
+		.interval   = 0x0004,
+		.window     = 0x0004,
+	};
+	struct bt_le_per_adv_sync_param sync_create_param;
+	struct bt_le_per_adv_sync *sync = NULL;
+	struct bt_iso_big_sync_param big_param = { 0, };
+	struct bt_iso_big *big;
+	uint32_t start_ms;
+	int err;
+
+	printk("Bluetooth initializing... ");
+	err = bt_enable(NULL);
+	if (err) {
+		FAIL("Could not init BT: %d\n", err);
+		return;
+	}
+	printk("success.\n");
+
+	bt_le_scan_cb_register(&scan_callbacks);
+	bt_le_per_adv_sync_cb_register(&sync_cb);
+
+	printk("Start scanning... ");
+	is_periodic = false;
+	err = bt_le_scan_start(&scan_param, NULL);
+	if (err) {
+		FAIL("Could not start scan: %d\n", err);
+		return;
+	}
+	printk("success.\n");
+
+	while (!is_periodic) {
+		k_sleep(K_MSEC(100));
+	}
+	printk("Periodic Advertising found (SID: %u)\n", per_sid);
+
+	printk("Creating Periodic Advertising Sync... ");
+	is_sync = false;
+	bt_addr_le_copy(&sync_create_param.addr, &per_addr);
+	sync_create_param.options =
+		BT_LE_PER_ADV_SYNC_OPT_REPORTING_INITIALLY_DISABLED;
+	sync_create_param.sid = per_sid;
+	sync_create_param.skip = 0;
+	sync_create_param.timeout = 0xa;
+	err = bt_le_per_adv_sync_create(&sync_create_param, &sync);
+	if (err) {
+		FAIL("Could not create sync: %d\n", err);
+		return;
+	}
+	printk("success.\n");
+
+	while (!is_sync) {
+		k_sleep(K_MSEC(100));
+	}
+
+	err = bt_le_scan_stop();
+	if (err) {
+		FAIL("Could not stop scan: %d\n", err);
+		return;
+	}
+
+	printk("Wait for BIG Info Advertising Report...\n");
+	is_big_info = false;
+	while (!is_big_info) {
+		k_sleep(K_MSEC(100));
+	}
+
+	printk("ISO BIG create sync... ");
+	is_iso_connected = false;
+	bis_iso_qos.tx = NULL;
+	bis_iso_qos.rx = &iso_rx_qos;
+	big_param.bis_channels = bis_channels;
+	big_param.num_bis = BIS_ISO_CHAN_COUNT;
+	big_param.bis_bitfield = BT_ISO_BIS_INDEX_BIT(1); /* BIS 1 selected */
+	big_param.mse = 1;
+	big_param.sync_timeout = 100; /* 1000 ms */
+	big_param.encryption = false;
+	hci_path.pid = BT_HCI_DATAPATH_ID_HCI;
+	err = bt_iso_big_sync(sync, &big_param, &big);
+	if (err) {
+		FAIL("Could not create BIG sync: %d\n", err);
+		return;
+	}
+	printk("success.\n");
+
+	while (!is_iso_connected) {
+		k_sleep(K_MSEC(100));
+	}
+
+	start_ms = k_uptime_get_32();
+
+	/* Let the broadcaster, and the injector if any, transmit for a while */
+	k_sleep(K_MSEC(5000));
+
+	read_anomaly_counters(bis_iso_chan.iso->handle, k_uptime_get_32() - start_ms);
+
+	PASS("ISO recv anomaly test Passed\n");
+}
+#endif /* CONFIG_TEST_ISO_ANOMALY */
+
 static void test_iso_init(void)
 {
 	bst_ticker_set_next_tick_absolute(60e6);
@@ -1277,6 +1542,23 @@ static const struct bst_test_instance test_def[] = {
 		.test_main_f = test_iso_recv_vs_dp_main
 	},
 #endif /* CONFIG_BT_CTLR_ISO_VENDOR_DATA_PATH */
+#if defined(CONFIG_TEST_ISO_ANOMALY)
+	{
+		.test_id = "inject",
+		.test_descr = "ISO broadcast with a different payload",
+		.test_pre_init_f = test_iso_init,
+		.test_tick_f = test_iso_tick,
+		.test_main_f = test_iso_inject_main
+	},
+	{
+		.test_id = "receive_anomaly",
+		.test_descr = "ISO receive with anomaly counters",
+		.test_pre_init_f = test_iso_init,
+		.test_tick_f = test_iso_tick,
+		.test_main_f = test_iso_recv_anomaly_main,
+		.test_args_f = test_iso_recv_anomaly_args
+	},
+#endif /* CONFIG_TEST_ISO_ANOMALY */
 	BSTEST_END_MARKER
 };
 
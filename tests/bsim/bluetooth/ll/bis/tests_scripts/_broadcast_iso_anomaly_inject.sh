@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+# BIS anomaly detection test with an injector: a broadcaster transmits a BIS,
+# an injector using the same random seed clones the BIG with a start offset and
+# a different payload, and the receiver checks that every SDU it received from
+# the injector was counted as an anomaly.
+#
+# Whether the receiver hears the injector at all depends on the seed and on
+# the offset, hence this is not part of CI. Run it over several values:
+#   _broadcast_iso_anomaly_inject.sh <random seed> <start offset in us>
+random_seed=${1:-23}
+start_offset=${2:-20}
+shift $(( $# < 2 ? $# : 2 ))
+
+simulation_id="broadcast_iso_anomaly_inject_${random_seed}_${start_offset}"
+verbosity_level=2
+EXECUTE_TIMEOUT=120
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_ll_bis_prj_conf_overlay-anomaly_conf \
+  -v=${verbosity_level} -s=${simulation_id} -RealEncryption=1 -d=0 \
+  -testid=receive_anomaly -argstest inject
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_ll_bis_prj_conf_overlay-anomaly_conf \
+  -v=${verbosity_level} -s=${simulation_id} -RealEncryption=1 -d=1 \
+  -rs=${random_seed} -testid=broadcast
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_ll_bis_prj_conf_overlay-anomaly_conf \
+  -v=${verbosity_level} -s=${simulation_id} -RealEncryption=1 -d=2 \
+  -rs=${random_seed} -start_offset=${start_offset} -testid=inject
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
+  -D=3 -sim_length=30e6 $@
+
+wait_for_background_jobs
@@ -0,0 +1,24 @@
+#!/usr/bin/env bash
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+source ${ZEPHYR_BASE}/tests/bsim/sh_common.source
+
+# Encrypted ISO broadcast test: a broadcaster transmits an encrypted BIS and a
+# receiver listens to the BIS using the same Broadcast Code.
+simulation_id="broadcast_iso_encryption"
+verbosity_level=2
+EXECUTE_TIMEOUT=120
+
+cd ${BSIM_OUT_PATH}/bin
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_ll_bis_prj_conf_overlay-encryption_conf \
+  -v=${verbosity_level} -s=${simulation_id} -RealEncryption=1 -d=0 -testid=receive
+
+Execute ./bs_${BOARD_TS}_tests_bsim_bluetooth_ll_bis_prj_conf_overlay-encryption_conf \
+  -v=${verbosity_level} -s=${simulation_id} -RealEncryption=1 -d=1 -testid=broadcast
+
+Execute ./bs_2G4_phy_v1 -v=${verbosity_level} -s=${simulation_id} \
+  -D=2 -sim_length=30e6 $@
+
+wait_for_background_jobs
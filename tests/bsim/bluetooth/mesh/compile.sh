@@ -18,6 +18,8 @@ app=tests/bsim/bluetooth/mesh conf_overlay=overlay_low_lat.conf compile
 app=tests/bsim/bluetooth/mesh conf_overlay=overlay_workq_sys.conf compile
 app=tests/bsim/bluetooth/mesh conf_overlay=overlay_multi_adv_sets.conf compile
 app=tests/bsim/bluetooth/mesh conf_overlay=overlay_lpn_scan_on.conf compile
+app=tests/bsim/bluetooth/mesh conf_overlay=overlay_friend_shared.conf compile
+app=tests/bsim/bluetooth/mesh conf_overlay=overlay_sar_tx_window.conf compile
 app=tests/bsim/bluetooth/mesh conf_overlay="overlay_gatt.conf;overlay_workq_sys.conf" compile
 app=tests/bsim/bluetooth/mesh conf_overlay="overlay_gatt.conf;overlay_low_lat.conf" compile
 app=tests/bsim/bluetooth/mesh conf_overlay="overlay_pst.conf;overlay_gatt.conf" compile
@@ -652,6 +652,53 @@ static void second_relay_adv_send_end(int err, void *cb_data)
 	k_sem_give(&observer_sem);
 }
 
+/* Check where the local and relayed frames of the relay test went, and that
+ * the per advertising set statistics account for all of them.
+ */
+static void relay_stat_check(void)
+{
+	struct bt_mesh_adv_set_statistic set_st;
+	struct bt_mesh_statistic st;
+	uint32_t tx_count = 0;
+#if defined(CONFIG_BT_MESH_RELAY_ADV_SETS)
+	uint8_t relay_sets = CONFIG_BT_MESH_RELAY_ADV_SETS;
+#else
+	uint8_t relay_sets = 0;
+#endif
+
+	bt_mesh_stat_get(&st);
+	ASSERT_EQUAL(1, st.tx_local_planned);
+	ASSERT_EQUAL(1, st.tx_local_succeeded);
+	ASSERT_EQUAL(2, st.tx_adv_relay_planned);
+	ASSERT_EQUAL(2, st.tx_adv_relay_succeeded);
+
+	for (uint8_t i = 0; i < 1 + relay_sets; i++) {
+		ASSERT_OK(bt_mesh_stat_adv_set_get(i, &set_st));
+
+		LOG_INF("adv set %u: tx %u in %u ms, queue latency %u ms (max %u ms)", i,
+			set_st.tx_count, set_st.tx_time, set_st.queue_latency,
+			set_st.queue_latency_max);
+
+		if (relay_sets > 0) {
+			/* Each frame is sent in parallel on its own set */
+			ASSERT_EQUAL(1, set_st.tx_count);
+			ASSERT_TRUE_MSG(set_st.queue_latency_max < set_st.tx_time,
+					"Frame waited behind another frame on set %u\n", i);
+		} else {
+			/* The frames are sent one after another on the main set */
+			ASSERT_EQUAL(3, set_st.tx_count);
+			ASSERT_TRUE_MSG(set_st.queue_latency_max > 0,
+					"Frames were not queued on the main set\n");
+		}
+
+		ASSERT_TRUE(set_st.tx_time > 0);
+		tx_count += set_st.tx_count;
+	}
+
+	ASSERT_EQUAL(3, tx_count);
+	ASSERT_EQUAL(-EINVAL, bt_mesh_stat_adv_set_get(UINT8_MAX, &set_st));
+}
+
 static void test_tx_send_relay(void)
 {
 	static const struct bt_mesh_send_cb local_send_cb = {
@@ -670,6 +717,7 @@ static void test_tx_send_relay(void)
 
 	bt_init();
 	adv_init();
+	bt_mesh_stat_reset();
 
 	local = bt_mesh_adv_create(BT_MESH_ADV_DATA, BT_MESH_ADV_TAG_LOCAL,
 				   xmit, K_NO_WAIT);
@@ -701,6 +749,8 @@ static void test_tx_send_relay(void)
 	ASSERT_OK_MSG(k_sem_take(&observer_sem, K_SECONDS(10)),
 		      "Didn't call the last end tx cb.");
 
+	relay_stat_check();
+
 	PASS();
 }
 
@@ -903,6 +903,9 @@ static void test_cli_broadcast_unicast(void)
 
 static void test_cli_trans_complete(void)
 {
+	struct bt_mesh_statistic st;
+	uint32_t elapsed_ms;
+	int64_t start;
 	int err;
 
 	bt_mesh_test_cfg_set(NULL, 400);
@@ -930,6 +933,9 @@ static void test_cli_trans_complete(void)
 	blob_cli_xfer.xfer.chunk_size = 377;
 	blob_cli_xfer.inputs.timeout_base = 10;
 
+	bt_mesh_stat_reset();
+	start = k_uptime_get();
+
 	err = bt_mesh_blob_cli_send(&blob_cli, &blob_cli_xfer.inputs,
 				    &blob_cli_xfer.xfer, &blob_io);
 	if (err) {
@@ -942,6 +948,17 @@ static void test_cli_trans_complete(void)
 
 	ASSERT_TRUE(blob_cli.state == BT_MESH_BLOB_CLI_STATE_NONE);
 
+	/* Report the transfer throughput, to compare SAR configurations */
+	elapsed_ms = (uint32_t)(k_uptime_get() - start);
+	bt_mesh_stat_get(&st);
+	LOG_INF("Transferred %zu bytes in %u ms (%u B/s), SAR TX window %d",
+		blob_cli_xfer.xfer.size, elapsed_ms,
+		(uint32_t)(blob_cli_xfer.xfer.size * MSEC_PER_SEC / elapsed_ms),
+		CONFIG_BT_MESH_SAR_TX_WINDOW);
+	LOG_INF("Segmented messages %u/%u, segments %u/%u, %u octets",
+		st.tx_seg_msg_succeeded, st.tx_seg_msg_planned, st.tx_seg_sent,
+		st.tx_seg_planned, st.tx_seg_octets);
+
 	PASS();
 }
 
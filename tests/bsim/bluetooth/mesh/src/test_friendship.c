@@ -287,6 +287,68 @@ static void test_friend_overflow(void)
 	PASS();
 }
 
+/** As a friend of two LPNs, overflow the Friend Queue of the first LPN with
+ *  own packets, then fill the Friend Queue of the second LPN.
+ *
+ *  The first Friend Queue takes all the shared buffers. Verify that the
+ *  second Friend Queue still gets its reserved buffers. The LPNs are the
+ *  devices 1 and 2 of the simulation.
+ */
+static void test_friend_shared_queue(void)
+{
+	const uint16_t lpn_addr[] = { LPN_ADDR_START + 1, LPN_ADDR_START + 2 };
+
+	bt_mesh_test_setup();
+	bt_mesh_test_friendship_init(CONFIG_BT_MESH_FRIEND_LPN_COUNT);
+	bt_mesh_friend_set(BT_MESH_FEATURE_ENABLED);
+
+	if (CONFIG_BT_MESH_FRIEND_QUEUE_SHARED_SIZE == 0) {
+		FAIL("No shared Friend Queue buffers");
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(lpn_addr); i++) {
+		ASSERT_OK_MSG(bt_mesh_test_friendship_evt_wait(BT_MESH_TEST_FRIEND_ESTABLISHED,
+							       K_SECONDS(5)),
+			      "Friendship %d not established", i);
+	}
+
+	bt_mesh_test_friendship_evt_clear(BT_MESH_TEST_FRIEND_POLLED);
+
+	k_sleep(K_SECONDS(3));
+
+	/* Fill the reserved and the shared buffers, then overflow the Friend
+	 * Queue of the first LPN, which discards its first message.
+	 */
+	for (int i = 0;
+	     i < CONFIG_BT_MESH_FRIEND_QUEUE_SIZE + CONFIG_BT_MESH_FRIEND_QUEUE_SHARED_SIZE + 1;
+	     i++) {
+		bt_mesh_test_send(lpn_addr[0], NULL, 5, 0, K_NO_WAIT);
+	}
+
+	/* No shared buffers are left, but the reserved buffers of the second
+	 * LPN are still available.
+	 */
+	for (int i = 0; i < CONFIG_BT_MESH_FRIEND_QUEUE_SIZE; i++) {
+		bt_mesh_test_send(lpn_addr[1], NULL, 5, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(lpn_addr); i++) {
+		ASSERT_OK_MSG(bt_mesh_test_friendship_evt_wait(BT_MESH_TEST_FRIEND_POLLED,
+							       K_SECONDS(35)),
+			      "Friend never polled");
+	}
+
+	/* The LPNs verify the content of their Friend Queues. */
+	k_sleep(K_SECONDS(10));
+
+	if (bt_mesh_test_friendship_state_check(BT_MESH_TEST_FRIEND_TERMINATED)) {
+		FAIL("Friendship terminated unexpectedly");
+	}
+
+	PASS();
+}
+
 /** Establish a friendship, wait for communication between the LPN and a mesh
  *  device to finish, then send group and virtual addr messages to the LPN.
  *  Let the LPN add another group message, then send to that as well.
@@ -753,6 +815,62 @@ static void test_lpn_overflow(void)
 	PASS();
 }
 
+/** Receive packets from a friend that shares Friend Queue buffers between two
+ *  LPNs, see test_friend_shared_queue().
+ *
+ *  The first LPN gets all but the first packet, using both its reserved and
+ *  all the shared buffers. The second LPN gets every packet, as its reserved
+ *  buffers are never taken by the first.
+ */
+static void test_lpn_shared_queue(void)
+{
+	const int queue_size = CONFIG_BT_MESH_FRIEND_QUEUE_SIZE;
+	const int shared_size = CONFIG_BT_MESH_FRIEND_QUEUE_SHARED_SIZE;
+	struct bt_mesh_test_msg msg;
+	int exp_seq;
+	int cnt;
+	int err;
+
+	bt_mesh_test_setup();
+	bt_mesh_test_friendship_init(CONFIG_BT_MESH_FRIEND_LPN_COUNT);
+
+	bt_mesh_lpn_set(true);
+	ASSERT_OK_MSG(bt_mesh_test_friendship_evt_wait(BT_MESH_TEST_LPN_ESTABLISHED,
+						       K_SECONDS(5)), "LPN not established");
+	bt_mesh_test_friendship_evt_clear(BT_MESH_TEST_LPN_POLLED);
+
+	/* Wait for both friendships and for the friend to fill the queues. */
+	k_sleep(K_SECONDS(10));
+	ASSERT_OK_MSG(bt_mesh_lpn_poll(), "Poll failed");
+
+	if (get_device_nbr() == 1) {
+		/* The first message (with seq=1) is discarded. */
+		exp_seq = 2;
+		cnt = queue_size + shared_size;
+	} else {
+		/* Following the messages to the first LPN. */
+		exp_seq = queue_size + shared_size + 2;
+		cnt = queue_size;
+	}
+
+	for (int i = 0; i < cnt; i++) {
+		ASSERT_OK_MSG(bt_mesh_test_recv_msg(&msg, K_SECONDS(2)),
+			      "Receive %d failed", i);
+		ASSERT_EQUAL(5, msg.len);
+		ASSERT_EQUAL(cfg->addr, msg.ctx.recv_dst);
+		ASSERT_EQUAL(exp_seq + i, msg.seq);
+	}
+
+	/* Not expecting any more messages from friend */
+	err = bt_mesh_test_recv_msg(&msg, K_SECONDS(10));
+	if (!err) {
+		FAIL("Unexpected additional message 0x%02x from 0x%04x",
+		     msg.seq, msg.ctx.addr);
+	}
+
+	PASS();
+}
+
 /** As an LPN, receive packets on group and virtual addresses from mesh device
  *  and friend. Then, add a second group address (while the friendship is
  *  established), and receive on that as well.
@@ -1195,6 +1313,7 @@ static const struct bst_test_instance test_connect[] = {
 	TEST_CASE(friend, est_multi,        "Friend: establish multiple friendships"),
 	TEST_CASE(friend, msg,              "Friend: message exchange"),
 	TEST_CASE(friend, overflow,         "Friend: message queue overflow"),
+	TEST_CASE(friend, shared_queue,     "Friend: shared message queue buffers"),
 	TEST_CASE(friend, group,            "Friend: send to group addrs"),
 	TEST_CASE(friend, no_est,           "Friend: do not establish friendship"),
 	TEST_CASE(friend, va_collision,     "Friend: send to virtual addrs with collision"),
@@ -1205,6 +1324,7 @@ static const struct bst_test_instance test_connect[] = {
 	TEST_CASE(lpn,    re_est,           "LPN: re-establish friendship"),
 	TEST_CASE(lpn,    poll,             "LPN: poll before timeout"),
 	TEST_CASE(lpn,    overflow,         "LPN: message queue overflow"),
+	TEST_CASE(lpn,    shared_queue,     "LPN: shared message queue buffers"),
 	TEST_CASE(lpn,    group,            "LPN: receive on group addrs"),
 	TEST_CASE(lpn,    loopback,         "LPN: send to loopback addrs"),
 	TEST_CASE(lpn,    disable,          "LPN: disable LPN"),
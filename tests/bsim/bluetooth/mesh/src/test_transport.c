@@ -455,6 +455,100 @@ static void test_tx_seg_fail(void)
 	PASS();
 }
 
+/* Wait for the transport to have handed the given number of segments to the
+ * advertiser.
+ */
+static void seg_sent_wait(uint32_t count)
+{
+	struct bt_mesh_statistic st;
+
+	for (int i = 0; i < 5000; i++) {
+		bt_mesh_stat_get(&st);
+		if (st.tx_seg_sent >= count) {
+			ASSERT_EQUAL(count, st.tx_seg_sent);
+			return;
+		}
+
+		k_sleep(K_MSEC(1));
+	}
+
+	FAIL("Only %u of %u segments were sent", st.tx_seg_sent, count);
+}
+
+/* Acknowledge segments of a message sent to an address that doesn't exist by
+ * looping back a Segment Acknowledgment on its behalf.
+ */
+static void seg_ack_inject(uint16_t src, uint16_t seq_zero, uint32_t block)
+{
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = 0,
+		.app_idx = BT_MESH_KEY_UNUSED,
+		.addr = tx_cfg.addr,
+		.send_ttl = 0,
+	};
+	struct bt_mesh_net_tx tx = {
+		.sub = bt_mesh_subnet_get(0),
+		.ctx = &ctx,
+		.src = src,
+		.xmit = bt_mesh_net_transmit_get(),
+	};
+	uint8_t buf[6];
+
+	sys_put_be16((seq_zero << 2) & 0x7ffc, buf);
+	sys_put_be32(block, &buf[2]);
+
+	ASSERT_OK(bt_mesh_ctl_send(&tx, TRANS_CTL_OP_ACK, buf, sizeof(buf), NULL, NULL));
+}
+
+/** Send a segmented message with several segments handed to the advertiser at
+ *  once, then acknowledge every other segment. Only the unacknowledged
+ *  segments shall be retransmitted, and the message shall complete once the
+ *  remaining segments are acknowledged.
+ */
+static void test_tx_seg_window(void)
+{
+	const uint16_t dst = 0x0fff;
+	struct bt_mesh_statistic st;
+	uint16_t seq_zero;
+	uint32_t seg_count;
+	uint32_t acked;
+	struct k_sem sem;
+
+	k_sem_init(&sem, 0, 1);
+	bt_mesh_test_setup();
+	bt_mesh_stat_reset();
+
+	seq_zero = bt_mesh.seq & TRANS_SEQ_ZERO_MASK;
+	ASSERT_OK(bt_mesh_test_send_async(dst, NULL, 100, 0, &async_send_cb, &sem));
+
+	bt_mesh_stat_get(&st);
+	seg_count = st.tx_seg_planned;
+	ASSERT_TRUE(seg_count > CONFIG_BT_MESH_SAR_TX_WINDOW);
+
+	/* The first window of segments is queued without waiting for any of
+	 * them to be sent.
+	 */
+	ASSERT_EQUAL(CONFIG_BT_MESH_SAR_TX_WINDOW, st.tx_seg_sent);
+
+	seg_sent_wait(seg_count);
+
+	/* Acknowledge the even segments, leaving the odd ones outstanding */
+	acked = 0x55555555 & BIT_MASK(seg_count);
+	seg_ack_inject(dst, seq_zero, acked);
+
+	seg_sent_wait(seg_count + seg_count / 2);
+
+	seg_ack_inject(dst, seq_zero, BIT_MASK(seg_count));
+	ASSERT_OK(k_sem_take(&sem, K_SECONDS(10)));
+
+	bt_mesh_stat_get(&st);
+	ASSERT_EQUAL(1, st.tx_seg_msg_planned);
+	ASSERT_EQUAL(1, st.tx_seg_msg_succeeded);
+	ASSERT_EQUAL(seg_count + seg_count / 2, st.tx_seg_sent);
+
+	PASS();
+}
+
 /* Receiver test functions */
 
 /** @brief Receive unicast messages using the test vector.
@@ -690,6 +784,7 @@ static const struct bst_test_instance test_connect[] = {
 	TEST_CASE(tx, seg_concurrent, "Transport: send concurrent segmented"),
 	TEST_CASE(tx, seg_ivu,        "Transport: send segmented during IV update"),
 	TEST_CASE(tx, seg_fail,       "Transport: send segmented to unused addr"),
+	TEST_CASE(tx, seg_window,     "Transport: send segmented with several segments in flight"),
 
 	TEST_CASE(rx, unicast,        "Transport: receive on unicast addr"),
 	TEST_CASE(rx, group,          "Transport: receive on group addr"),
@@ -11,6 +11,9 @@ source $(dirname "${BASH_SOURCE[0]}")/../../_mesh_test.sh
 # Submit the advertiser buffer 1,2 and 3 using bt_mesh_adv_send().
 # For not enable multiple advertising sets, expect the adv 1,2,3 are be sent by fifo order.
 # For enable multiple advertising sets, expect the adv 1,2,3 are be sent by same time.
+# After sending, read the mesh statistics and check that each advertising set counted the
+# frames it sent: all three frames on the main set, or one frame on each set with multiple
+# advertising sets, without waiting in the queue behind another frame.
 
 RunTest mesh_adv_tx_send_relay adv_tx_send_relay
 
@@ -0,0 +1,13 @@
+#!/usr/bin/env bash
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+source $(dirname "${BASH_SOURCE[0]}")/../../_mesh_test.sh
+
+# Test that BLOB Transfer completes successfully in Push mode with several
+# segments handed to the advertiser at once. The client logs the transfer
+# throughput, which can be compared with blob_cli_trans_complete_push.sh.
+overlay=overlay_sar_tx_window_conf
+RunTest blob_success_push_sar_window blob_cli_trans_complete \
+	blob_srv_trans_complete blob_srv_trans_complete \
+	blob_srv_trans_complete blob_srv_trans_complete
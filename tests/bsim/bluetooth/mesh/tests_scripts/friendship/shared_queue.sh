@@ -0,0 +1,13 @@
+#!/usr/bin/env bash
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+source $(dirname "${BASH_SOURCE[0]}")/../../_mesh_test.sh
+
+# Test that a Friend Queue using the shared buffers leaves the reserved
+# buffers of another LPN alone.
+overlay=overlay_friend_shared_conf
+RunTest mesh_friendship_shared_queue \
+	friendship_friend_shared_queue \
+	friendship_lpn_shared_queue \
+	friendship_lpn_shared_queue
@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+# Copyright The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+source $(dirname "${BASH_SOURCE[0]}")/../../_mesh_test.sh
+
+# Test that a segmented message with several segments in flight only
+# retransmits the segments that were not acknowledged.
+overlay=overlay_sar_tx_window_conf
+RunTest mesh_transport_seg_window transport_tx_seg_window